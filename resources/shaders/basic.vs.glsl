@@ -1,20 +1,15 @@
 layout(location = 0) in vec2 pos;
 layout(location = 1) in vec2 uv;
 
-uniform vec2 offset;
-uniform vec2 scale;
-uniform vec2 texture_offset;
-uniform vec2 texture_scale;
-
 out vec2 TexCoord; // specify a color output to the fragment shader
 
 void main()
 {
-    vec2 p = pos * scale + offset;
+    vec2 p = pos * quad.destination.zw + quad.destination.xy;
     p *= vec2(2.0);
     p -= vec2(1.0);
     p.y * -1.0;
 
     gl_Position = vec4(p, 0.0, 1.0); // see how we directly give a vec3 to vec4's constructor
-    TexCoord    = texture_offset + uv * texture_scale;
+    TexCoord    = quad.source.xy + uv * quad.source.zw;
 }
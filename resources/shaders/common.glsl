@@ -1,3 +1,12 @@
+// Per-draw textured quad parameters, see gpu::draw_parameters_s
+layout(std140) uniform draw_parameters
+{
+    vec4  destination; // offset.xy, scale.zw
+    vec4  source;      // offset.xy, scale.zw
+    float opacity;
+}
+quad;
+
 // Wikipedia https://en.wikipedia.org/wiki/Rec._709
 const float gamma_offset     = 0.099;
 const float gamma_gamma      = 0.45;
@@ -0,0 +1,30 @@
+out vec4 FragColor;
+
+in vec2 TexCoord; // the input variable from the vertex shader (same name and same type)
+
+uniform sampler2D tex;
+uniform int       target_width;
+uniform mat3      transfer;
+uniform vec3      transfer_offset;
+uniform mat3      gamut_transfer;
+
+vec3 yuv_to_rgb(float Y, float Cb, float Cr) { return (vec3(Y, Cb, Cr) - transfer_offset) * transfer; }
+
+// The input is the luma plane followed by the full-height 4:2:2 chroma plane,
+// the layout written by the P216 encoder. Each texel carries four 16-bit
+// samples: Y0 Y1 Y2 Y3 in the luma rows, and U0 V0 U1 V1 for two horizontal
+// pixel pairs in the chroma rows.
+void main(void)
+{
+    int height = textureSize(tex, 0).y / 2;
+    int x      = int(TexCoord.x * float(target_width));
+    int y      = int(float(height) * TexCoord.y);
+
+    vec4  luma   = texelFetch(tex, ivec2(x / 4, y), 0);
+    vec4  chroma = texelFetch(tex, ivec2(x / 4, y + height), 0);
+    float Y      = luma[x % 4];
+    vec2  CbCr   = x % 4 < 2 ? chroma.xy : chroma.zw;
+
+    vec3 encoded_rgb = yuv_to_rgb(Y, CbCr.x, CbCr.y);
+    FragColor        = vec4(gamut_transfer * to_linear(encoded_rgb), 1.0);
+}
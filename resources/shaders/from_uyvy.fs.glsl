@@ -0,0 +1,25 @@
+out vec4 FragColor;
+
+in vec2 TexCoord; // the input variable from the vertex shader (same name and same type)
+
+uniform sampler2D tex;
+uniform int       target_width;
+uniform mat3      transfer;
+uniform vec3      transfer_offset;
+uniform mat3      gamut_transfer;
+
+vec3 yuv_to_rgb(float Y, float Cb, float Cr) { return (vec3(Y, Cb, Cr) - transfer_offset) * transfer; }
+
+// Each input texel holds one pixel pair as the bytes U Y0 V Y1, the layout
+// written by the UYVY encoder.
+void main(void)
+{
+    int x = int(TexCoord.x * float(target_width));
+    int y = int(textureSize(tex, 0).y * TexCoord.y);
+
+    vec4  pair = texelFetch(tex, ivec2(x / 2, y), 0);
+    float Y    = x % 2 == 0 ? pair.y : pair.w;
+
+    vec3 encoded_rgb = yuv_to_rgb(Y, pair.x, pair.z);
+    FragColor        = vec4(gamut_transfer * to_linear(encoded_rgb), 1.0);
+}
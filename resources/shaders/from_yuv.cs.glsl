@@ -0,0 +1,46 @@
+// Unpacks v210 with one invocation per group of six pixels, reading the four
+// RGB10_A2 texels that hold them once instead of once per output pixel.
+layout(local_size_x = 64, local_size_y = 1) in;
+
+layout(binding = 0) uniform sampler2D tex;
+layout(binding = 0, rgba16) uniform writeonly image2D target;
+
+uniform mat3 transfer;
+uniform vec3 transfer_offset;
+uniform mat3 gamut_transfer;
+
+vec4 yuv_to_linear_rgb(float Y, float Cb, float Cr)
+{
+    vec3 encoded_rgb = (vec3(Y, Cb, Cr) - transfer_offset) * transfer;
+    return vec4(gamut_transfer * to_linear(encoded_rgb), 1.0);
+}
+
+void main(void)
+{
+    ivec2 target_size = imageSize(target);
+    int   group       = int(gl_GlobalInvocationID.x);
+    int   y           = int(gl_GlobalInvocationID.y);
+    int   texel       = group * 4;
+    int   start_x     = group * 6;
+
+    if (start_x >= target_size.x || y >= target_size.y) {
+        return;
+    }
+
+    vec4 t0 = texelFetch(tex, ivec2(texel, y), 0);
+    vec4 t1 = texelFetch(tex, ivec2(texel + 1, y), 0);
+    vec4 t2 = texelFetch(tex, ivec2(texel + 2, y), 0);
+    vec4 t3 = texelFetch(tex, ivec2(texel + 3, y), 0);
+
+    vec4 rgb[6];
+    rgb[0] = yuv_to_linear_rgb(t0.y, t0.x, t0.z);
+    rgb[1] = yuv_to_linear_rgb(t1.x, t0.x, t0.z);
+    rgb[2] = yuv_to_linear_rgb(t1.z, t1.y, t2.x);
+    rgb[3] = yuv_to_linear_rgb(t2.y, t1.y, t2.x);
+    rgb[4] = yuv_to_linear_rgb(t3.x, t2.z, t3.y);
+    rgb[5] = yuv_to_linear_rgb(t3.z, t2.z, t3.y);
+
+    for (int i = 0; i < 6 && start_x + i < target_size.x; ++i) {
+        imageStore(target, ivec2(start_x + i, y), rgb[i]);
+    }
+}
@@ -0,0 +1,59 @@
+out vec4 FragColor;
+
+in vec2      TexCoord;
+flat in vec2 LayerBlend;
+flat in int  LayerTexture;
+
+// Must match gpu::layer_compositor_s::MAX_BATCH_TEXTURES
+uniform sampler2D layer_textures[16];
+
+// GLSL 3.30 only allows indexing sampler arrays with constants. The index is
+// the same for every fragment of a layer, so the branch stays uniform across
+// each quad and implicit derivatives remain valid.
+vec4 sample_layer(int index, vec2 uv)
+{
+    switch (index) {
+        case 0:
+            return texture(layer_textures[0], uv);
+        case 1:
+            return texture(layer_textures[1], uv);
+        case 2:
+            return texture(layer_textures[2], uv);
+        case 3:
+            return texture(layer_textures[3], uv);
+        case 4:
+            return texture(layer_textures[4], uv);
+        case 5:
+            return texture(layer_textures[5], uv);
+        case 6:
+            return texture(layer_textures[6], uv);
+        case 7:
+            return texture(layer_textures[7], uv);
+        case 8:
+            return texture(layer_textures[8], uv);
+        case 9:
+            return texture(layer_textures[9], uv);
+        case 10:
+            return texture(layer_textures[10], uv);
+        case 11:
+            return texture(layer_textures[11], uv);
+        case 12:
+            return texture(layer_textures[12], uv);
+        case 13:
+            return texture(layer_textures[13], uv);
+        case 14:
+            return texture(layer_textures[14], uv);
+        case 15:
+            return texture(layer_textures[15], uv);
+        default:
+            return vec4(0.0);
+    }
+}
+
+void main()
+{
+    vec4 color = sample_layer(LayerTexture, TexCoord) * LayerBlend.x;
+
+    // With premultiplied alpha blending a zero alpha adds the color to what is below
+    FragColor = vec4(color.rgb, color.a * (1.0 - LayerBlend.y));
+}
@@ -0,0 +1,25 @@
+layout(location = 0) in vec2 pos;
+layout(location = 1) in vec2 uv;
+
+// Per layer, see gpu::layer_compositor_s
+layout(location = 2) in vec4 destination; // offset.xy, scale.zw
+layout(location = 3) in vec4 source;      // offset.xy, scale.zw
+layout(location = 4) in float opacity;
+layout(location = 5) in float additive;
+layout(location = 6) in int texture_unit;
+
+out vec2      TexCoord;
+flat out vec2 LayerBlend;
+flat out int  LayerTexture;
+
+void main()
+{
+    vec2 p = pos * destination.zw + destination.xy;
+    p *= vec2(2.0);
+    p -= vec2(1.0);
+
+    gl_Position  = vec4(p, 0.0, 1.0);
+    TexCoord     = source.xy + uv * source.zw;
+    LayerBlend   = vec2(opacity, additive);
+    LayerTexture = texture_unit;
+}
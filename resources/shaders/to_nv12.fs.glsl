@@ -0,0 +1,39 @@
+out vec4 FragColor;
+
+uniform sampler2D tex;
+uniform mat3      transfer;
+uniform vec3      transfer_offset;
+uniform mat3      gamut_transfer;
+
+vec3 rgb_to_yuv(vec3 rgb) { return (transfer * from_linear(gamut_transfer * rgb)) + transfer_offset; }
+
+vec3 fetch_yuv(ivec2 size, int x, int y) { return rgb_to_yuv(texelFetch(tex, ivec2(min(x, size.x - 1), y), 0).rgb); }
+
+// The output is the luma plane followed by the half-height chroma plane.
+// Each texel carries four bytes: Y0 Y1 Y2 Y3 in the luma rows, and
+// U0 V0 U1 V1 for two vertically averaged pixel pairs in the chroma rows.
+void main(void)
+{
+    ivec2 size = textureSize(tex, 0);
+    ivec2 dst  = ivec2(gl_FragCoord.xy);
+    int   x    = dst.x * 4;
+
+    if (dst.y < size.y) {
+        int y     = dst.y;
+        FragColor = vec4(fetch_yuv(size, x, y).x,
+                         fetch_yuv(size, x + 1, y).x,
+                         fetch_yuv(size, x + 2, y).x,
+                         fetch_yuv(size, x + 3, y).x);
+        return;
+    }
+
+    int top    = (dst.y - size.y) * 2;
+    int bottom = min(top + 1, size.y - 1);
+
+    vec3 left  = fetch_yuv(size, x, top) + fetch_yuv(size, x + 1, top) + fetch_yuv(size, x, bottom) +
+                fetch_yuv(size, x + 1, bottom);
+    vec3 right = fetch_yuv(size, x + 2, top) + fetch_yuv(size, x + 3, top) + fetch_yuv(size, x + 2, bottom) +
+                 fetch_yuv(size, x + 3, bottom);
+
+    FragColor = vec4(left.y, left.z, right.y, right.z) / 4.0;
+}
@@ -0,0 +1,33 @@
+out vec4 FragColor;
+
+uniform sampler2D tex;
+uniform mat3      transfer;
+uniform vec3      transfer_offset;
+uniform mat3      gamut_transfer;
+
+vec3 rgb_to_yuv(vec3 rgb) { return (transfer * from_linear(gamut_transfer * rgb)) + transfer_offset; }
+
+vec3 fetch_yuv(ivec2 size, int x, int y) { return rgb_to_yuv(texelFetch(tex, ivec2(min(x, size.x - 1), y), 0).rgb); }
+
+// The output is the luma plane followed by the full-height 4:2:2 chroma
+// plane. Each texel carries four 16-bit samples: Y0 Y1 Y2 Y3 in the luma
+// rows, and U0 V0 U1 V1 for two horizontal pixel pairs in the chroma rows.
+void main(void)
+{
+    ivec2 size   = textureSize(tex, 0);
+    ivec2 dst    = ivec2(gl_FragCoord.xy);
+    int   x      = dst.x * 4;
+    bool  chroma = dst.y >= size.y;
+    int   y      = chroma ? dst.y - size.y : dst.y;
+
+    vec3 p0 = fetch_yuv(size, x, y);
+    vec3 p1 = fetch_yuv(size, x + 1, y);
+    vec3 p2 = fetch_yuv(size, x + 2, y);
+    vec3 p3 = fetch_yuv(size, x + 3, y);
+
+    if (chroma) {
+        FragColor = vec4((p0.y + p1.y) / 2.0, (p0.z + p1.z) / 2.0, (p2.y + p3.y) / 2.0, (p2.z + p3.z) / 2.0);
+    } else {
+        FragColor = vec4(p0.x, p1.x, p2.x, p3.x);
+    }
+}
@@ -0,0 +1,23 @@
+out vec4 FragColor;
+
+uniform sampler2D tex;
+uniform mat3      transfer;
+uniform vec3      transfer_offset;
+uniform mat3      gamut_transfer;
+
+vec3 rgb_to_yuv(vec3 rgb) { return (transfer * from_linear(gamut_transfer * rgb)) + transfer_offset; }
+
+// Each output texel holds one pixel pair as the bytes U Y0 V Y1. Texture rows
+// map one to one onto host rows, as in the v210 encoder.
+void main(void)
+{
+    ivec2 size = textureSize(tex, 0);
+    ivec2 dst  = ivec2(gl_FragCoord.xy);
+    int   x    = dst.x * 2;
+    int   y    = dst.y;
+
+    vec3 a = rgb_to_yuv(texelFetch(tex, ivec2(x, y), 0).rgb);
+    vec3 b = rgb_to_yuv(texelFetch(tex, ivec2(min(x + 1, size.x - 1), y), 0).rgb);
+
+    FragColor = vec4((a.y + b.y) / 2.0, a.x, (a.z + b.z) / 2.0, b.x);
+}
@@ -0,0 +1,50 @@
+// Packs v210 with one invocation per group of six pixels, the four RGB10_A2
+// texels that hold them in the target. Each source pixel is converted once,
+// where the fragment shader converts a pixel for every texel that shares it.
+layout(local_size_x = 64, local_size_y = 1) in;
+
+layout(binding = 0) uniform sampler2D tex;
+layout(binding = 0, rgb10_a2) uniform writeonly image2D target;
+
+uniform mat3 transfer;
+uniform vec3 transfer_offset;
+uniform mat3 gamut_transfer;
+
+vec3 rgb_to_yuv(vec3 rgb) { return (transfer * from_linear(gamut_transfer * rgb)) + transfer_offset; }
+
+void main(void)
+{
+    ivec2 size        = textureSize(tex, 0);
+    ivec2 target_size = imageSize(target);
+    int   group       = int(gl_GlobalInvocationID.x);
+    int   y           = int(gl_GlobalInvocationID.y);
+    int   texel       = group * 4;
+    int   start_x     = group * 6;
+
+    if (texel >= target_size.x || y >= target_size.y) {
+        return;
+    }
+
+    // Rows are padded to whole 128 byte blocks, leave the padding black
+    if (start_x >= size.x) {
+        for (int i = 0; i < 4 && texel + i < target_size.x; ++i) {
+            imageStore(target, ivec2(texel + i, y), vec4(0.0));
+        }
+        return;
+    }
+
+    // x is Y, y is Cb and z is Cr
+    vec3 p[6];
+    for (int i = 0; i < 6; ++i) {
+        p[i] = rgb_to_yuv(texelFetch(tex, ivec2(min(start_x + i, size.x - 1), y), 0).rgb);
+    }
+
+    vec2 chroma_0 = (p[0].yz + p[1].yz) / 2.0;
+    vec2 chroma_1 = (p[2].yz + p[3].yz) / 2.0;
+    vec2 chroma_2 = (p[4].yz + p[5].yz) / 2.0;
+
+    imageStore(target, ivec2(texel, y), vec4(chroma_0.x, p[0].x, chroma_0.y, 0.0));
+    imageStore(target, ivec2(texel + 1, y), vec4(p[1].x, chroma_1.x, p[2].x, 0.0));
+    imageStore(target, ivec2(texel + 2, y), vec4(chroma_1.y, p[3].x, chroma_2.x, 0.0));
+    imageStore(target, ivec2(texel + 3, y), vec4(p[4].x, chroma_2.y, p[5].x, 0.0));
+}
@@ -0,0 +1,182 @@
+#include "core/adapters/adapter_autosave.hpp"
+
+#include "core/configuration.hpp"
+#include "core/node_status_registry.hpp"
+#include "logger/logger.hpp"
+#include "nodes/system/register.hpp"
+#include "types/node_status.hpp"
+#include "utils/filesystem.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace miximus::core {
+namespace {
+
+class autosave_s final : public node_manager_s::adapter_i
+{
+    using steady_clock = std::chrono::steady_clock;
+
+    // Required, non-owning dependencies that outlive the adapter.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    configuration_s&        configuration_;
+    std::filesystem::path   path_;
+    steady_clock::duration  interval_;
+    node_status_registry_s* status_registry_;
+
+    std::mutex                  mutex_;
+    std::condition_variable_any condition_;
+    bool                        dirty_{};
+
+    // Owned by the autosave thread
+    status::application_autosave_status_s status_;
+
+    // Declared last so the thread is stopped and joined before anything it uses is destroyed
+    std::jthread thread_;
+
+    void run(const std::stop_token& stop_token);
+    void save();
+    void publish_status();
+
+    // Called with the node lock held, so this only flags the change
+    void mark_dirty()
+    {
+        {
+            const std::scoped_lock lock(mutex_);
+            dirty_ = true;
+        }
+        condition_.notify_one();
+    }
+
+    void emit_add_node(std::string_view /*type*/,
+                       std::string_view /*id*/,
+                       const nlohmann::json& /*options*/,
+                       const std::optional<origin_info_s>& /*origin*/) final
+    {
+        mark_dirty();
+    }
+    void emit_remove_node(std::string_view /*id*/, const std::optional<origin_info_s>& /*origin*/) final
+    {
+        mark_dirty();
+    }
+    void emit_update_node(std::string_view /*id*/,
+                          const nlohmann::json& /*options*/,
+                          bool /*has_corrected_values*/,
+                          const std::optional<origin_info_s>& /*origin*/) final
+    {
+        mark_dirty();
+    }
+    void emit_add_connection(const connection_s& /*con*/, const std::optional<origin_info_s>& /*origin*/) final
+    {
+        mark_dirty();
+    }
+    void emit_remove_connection(const connection_s& /*con*/, const std::optional<origin_info_s>& /*origin*/) final
+    {
+        mark_dirty();
+    }
+    void emit_node_statuses(const std::shared_ptr<const nlohmann::json>& /*statuses*/) final {}
+
+  public:
+    autosave_s(configuration_s&        configuration,
+               std::filesystem::path   path,
+               steady_clock::duration  interval,
+               node_status_registry_s* status_registry)
+        : configuration_(configuration)
+        , path_(std::move(path))
+        , interval_(interval)
+        , status_registry_(status_registry)
+    {
+        publish_status();
+        thread_ = std::jthread([this](const std::stop_token& stop_token) { run(stop_token); });
+    }
+
+    ~autosave_s() final = default;
+
+    autosave_s(const autosave_s&)            = delete;
+    autosave_s(autosave_s&&)                 = delete;
+    autosave_s& operator=(const autosave_s&) = delete;
+    autosave_s& operator=(autosave_s&&)      = delete;
+};
+
+void autosave_s::run(const std::stop_token& stop_token)
+{
+    steady_clock::time_point last_save{};
+
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            if (!condition_.wait(lock, stop_token, [this] { return dirty_; })) {
+                return;
+            }
+
+            // Everything changed before the interval since the previous save
+            // has passed goes into one write
+            condition_.wait_until(lock, stop_token, last_save + interval_, [] { return false; });
+            if (stop_token.stop_requested()) {
+                // Pending changes are written by the final save at shutdown
+                return;
+            }
+            dirty_ = false;
+        }
+
+        last_save = steady_clock::now();
+        save();
+    }
+}
+
+void autosave_s::save()
+{
+    const auto start = steady_clock::now();
+
+    try {
+        const auto bytes    = configuration_.save_file(path_);
+        const auto duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - start).count();
+
+        ++status_.autosave_count;
+        status_.autosave_duration_us     = duration;
+        status_.autosave_duration_max_us = std::max(status_.autosave_duration_max_us, duration);
+        status_.autosave_bytes           = bytes;
+        status_.autosave_bytes_total += bytes;
+        status_.autosave_error.reset();
+
+        getlog("app")->debug("Autosaved {} bytes to {} in {} us", bytes, utils::path_to_utf8(path_), duration);
+    } catch (const std::exception& error) {
+        getlog("app")->error("Failed to autosave configuration: {}", error.what());
+
+        ++status_.autosave_failures;
+        status_.autosave_error = error.what();
+
+        // Keep the changes pending so the next interval retries
+        const std::scoped_lock lock(mutex_);
+        dirty_ = true;
+    }
+
+    publish_status();
+}
+
+void autosave_s::publish_status()
+{
+    if (status_registry_ != nullptr) {
+        status_registry_->write(nodes::system::SETTINGS_NODE_ID, status_);
+    }
+}
+
+} // namespace
+
+std::unique_ptr<node_manager_s::adapter_i> create_autosave_adapter(configuration_s&                    configuration,
+                                                                   std::filesystem::path               path,
+                                                                   std::chrono::steady_clock::duration interval,
+                                                                   node_status_registry_s*             status_registry)
+{
+    return std::make_unique<autosave_s>(configuration, std::move(path), interval, status_registry);
+}
+
+} // namespace miximus::core
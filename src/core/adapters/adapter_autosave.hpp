@@ -0,0 +1,23 @@
+#pragma once
+#include "core/configuration_fwd.hpp"
+#include "core/node_manager.hpp"
+#include "core/node_status_registry_fwd.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+
+namespace miximus::core {
+
+/**
+ * Save the configuration to `path` on a background thread whenever it changes,
+ * at most once per `interval`. Edits made while a save is pending or running
+ * are coalesced into the next one. Save metrics are published as status of the
+ * application settings node.
+ */
+std::unique_ptr<node_manager_s::adapter_i> create_autosave_adapter(configuration_s&                    configuration,
+                                                                   std::filesystem::path               path,
+                                                                   std::chrono::steady_clock::duration interval,
+                                                                   node_status_registry_s*             status_registry);
+
+} // namespace miximus::core
@@ -14,6 +14,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 namespace miximus::core {
 namespace {
@@ -63,7 +64,7 @@ class websocket_config_s final : public node_manager_s::adapter_i
                           const std::optional<origin_info_s>& origin) final;
     void emit_add_connection(const connection_s& con, const std::optional<origin_info_s>& origin) final;
     void emit_remove_connection(const connection_s& con, const std::optional<origin_info_s>& origin) final;
-    void emit_node_status(std::string_view id, const nlohmann::json& status) final;
+    void emit_node_statuses(const std::shared_ptr<const nlohmann::json>& statuses) final;
 
   public:
     websocket_config_s(node_manager_s&          manager,
@@ -109,10 +110,10 @@ void websocket_config_s::handle_font_registry(const web_message::font_registry_r
                 font_registry_.refresh();
                 break;
         }
-        server_.send_message_sync(web_message::result_s{.token = token}, origin_id);
+        server_.send_message(web_message::result_s{.token = token}, origin_id);
     } catch (const std::exception& e) {
         getlog("http")->error("Failed to refresh font registry: {}", e.what());
-        server_.send_message_sync(web_message::error_s{.token = token, .error = error_e::internal_error}, origin_id);
+        server_.send_message(web_message::error_s{.token = token, .error = error_e::internal_error}, origin_id);
     }
 }
 
@@ -122,9 +123,9 @@ void websocket_config_s::handle_add_node(const web_message::add_node_request_s&
     const auto origin = make_origin_info(origin_id, message.token);
     const auto result = manager_.handle_add_node(message.type, message.options, origin);
     if (result == error_e::no_error) {
-        server_.send_message_sync(web_message::result_s{.token = token}, origin_id);
+        server_.send_message(web_message::result_s{.token = token}, origin_id);
     } else {
-        server_.send_message_sync(web_message::error_s{.token = token, .error = result}, origin_id);
+        server_.send_message(web_message::error_s{.token = token, .error = result}, origin_id);
     }
 }
 
@@ -134,9 +135,9 @@ void websocket_config_s::handle_remove_node(const web_message::remove_node_reque
     const auto origin = make_origin_info(origin_id, message.token);
     const auto result = manager_.handle_remove_node(message.id, origin);
     if (result == error_e::no_error) {
-        server_.send_message_sync(web_message::result_s{.token = token}, origin_id);
+        server_.send_message(web_message::result_s{.token = token}, origin_id);
     } else {
-        server_.send_message_sync(web_message::error_s{.token = token, .error = result}, origin_id);
+        server_.send_message(web_message::error_s{.token = token, .error = result}, origin_id);
     }
 }
 
@@ -146,9 +147,9 @@ void websocket_config_s::handle_update_node(const web_message::update_node_reque
     const auto origin = make_origin_info(origin_id, message.token);
     const auto result = manager_.handle_update_node(message.id, message.options, origin);
     if (result.error == error_e::no_error) {
-        server_.send_message_sync(web_message::result_s{.token = token}, origin_id);
+        server_.send_message(web_message::result_s{.token = token}, origin_id);
     } else {
-        server_.send_message_sync(web_message::error_s{.token = token, .error = result.error}, origin_id);
+        server_.send_message(web_message::error_s{.token = token, .error = result.error}, origin_id);
     }
 }
 
@@ -158,9 +159,9 @@ void websocket_config_s::handle_add_connection(const web_message::add_connection
     const auto origin = make_origin_info(origin_id, message.token);
     const auto result = manager_.handle_add_connection(message.connection, origin);
     if (result == error_e::no_error) {
-        server_.send_message_sync(web_message::result_s{.token = token}, origin_id);
+        server_.send_message(web_message::result_s{.token = token}, origin_id);
     } else {
-        server_.send_message_sync(web_message::error_s{.token = token, .error = result}, origin_id);
+        server_.send_message(web_message::error_s{.token = token, .error = result}, origin_id);
     }
 }
 
@@ -171,19 +172,48 @@ void websocket_config_s::handle_remove_connection(const web_message::remove_conn
     const auto origin = make_origin_info(origin_id, message.token);
     const auto result = manager_.handle_remove_connection(message.connection, origin);
     if (result == error_e::no_error) {
-        server_.send_message_sync(web_message::result_s{.token = token}, origin_id);
+        server_.send_message(web_message::result_s{.token = token}, origin_id);
     } else {
-        server_.send_message_sync(web_message::error_s{.token = token, .error = result}, origin_id);
+        server_.send_message(web_message::error_s{.token = token, .error = result}, origin_id);
     }
 }
 
 void websocket_config_s::handle_config(const web_message::config_request_s& message, int64_t origin_id)
 {
-    const auto token = message.token.value_or("");
-    server_.send_message_sync(
+    const auto token      = message.token.value_or("");
+    auto&      change_log = configuration_.change_log();
+
+    // A reconnecting client only needs what it missed, which is far cheaper
+    // than serializing every node and status again
+    if (message.log_id == change_log.id() && message.since_version.has_value()) {
+        const auto since_status_version = message.since_status_version.value_or(*message.since_version);
+        if (auto changes = change_log.changes_since(*message.since_version, since_status_version)) {
+            web_message::config_changes_s result{.commands = std::move(changes->commands)};
+            for (const auto& id : changes->status_ids) {
+                if (auto status = configuration_.get_node_status(id)) {
+                    result.status.emplace(id, std::move(*status));
+                }
+            }
+
+            server_.send_message(
+                web_message::config_result_s{
+                    .token   = token,
+                    .log_id  = change_log.id(),
+                    .version = changes->version,
+                    .changes = std::move(result),
+                },
+                origin_id);
+            return;
+        }
+    }
+
+    auto [snapshot, version] = configuration_.get_versioned_snapshot();
+    server_.send_message(
         web_message::config_result_s{
-            .token  = token,
-            .config = configuration_.get_snapshot().get<web_message::config_s>(),
+            .token   = token,
+            .log_id  = change_log.id(),
+            .version = version,
+            .config  = snapshot.get<web_message::config_s>(),
         },
         origin_id);
 }
@@ -191,7 +221,7 @@ void websocket_config_s::handle_config(const web_message::config_request_s& mess
 void websocket_config_s::handle_node_status(const web_message::node_status_request_s& message, int64_t origin_id)
 {
     const auto token = message.token.value_or("");
-    server_.send_message_sync(
+    server_.send_message(
         web_message::node_status_result_s{
             .token  = token,
             .id     = message.id,
@@ -205,20 +235,21 @@ void websocket_config_s::emit_add_node(std::string_view                    type,
                                        const nlohmann::json&               options,
                                        const std::optional<origin_info_s>& origin)
 {
-    server_.broadcast_message_sync(web_message::add_node_command_s{
+    server_.broadcast_message(configuration_.change_log().append(web_message::add_node_command_s{
         .origin_id    = get_origin_id(origin),
         .origin_token = get_origin_token(origin),
         .node         = {.type = std::string(type), .id = std::string(id), .options = options},
-    });
+    }));
 }
 
 void websocket_config_s::emit_remove_node(std::string_view id, const std::optional<origin_info_s>& origin)
 {
-    server_.broadcast_message_sync(web_message::remove_node_command_s{
+    server_.broadcast_message(configuration_.change_log().append(web_message::remove_node_command_s{
         .origin_id    = get_origin_id(origin),
         .origin_token = get_origin_token(origin),
         .id           = std::string(id),
-    });
+    }));
+    configuration_.change_log().remove_node_status(id);
 }
 
 void websocket_config_s::emit_update_node(std::string_view                    id,
@@ -226,39 +257,38 @@ void websocket_config_s::emit_update_node(std::string_view                    id
                                           bool                                has_corrected_values,
                                           const std::optional<origin_info_s>& origin)
 {
-    server_.broadcast_message_sync(web_message::update_node_command_s{
+    server_.broadcast_message(configuration_.change_log().append(web_message::update_node_command_s{
         .origin_id            = get_origin_id(origin),
         .origin_token         = get_origin_token(origin),
         .id                   = std::string(id),
         .options              = options,
         .has_corrected_values = has_corrected_values,
-    });
+    }));
 }
 
 void websocket_config_s::emit_add_connection(const connection_s& con, const std::optional<origin_info_s>& origin)
 {
-    server_.broadcast_message_sync(web_message::add_connection_command_s{
+    server_.broadcast_message(configuration_.change_log().append(web_message::add_connection_command_s{
         .origin_id    = get_origin_id(origin),
         .origin_token = get_origin_token(origin),
         .connection   = con,
-    });
+    }));
 }
 
 void websocket_config_s::emit_remove_connection(const connection_s& con, const std::optional<origin_info_s>& origin)
 {
-    server_.broadcast_message_sync(web_message::remove_connection_command_s{
+    server_.broadcast_message(configuration_.change_log().append(web_message::remove_connection_command_s{
         .origin_id    = get_origin_id(origin),
         .origin_token = get_origin_token(origin),
         .connection   = con,
-    });
+    }));
 }
 
-void websocket_config_s::emit_node_status(std::string_view id, const nlohmann::json& status)
+void websocket_config_s::emit_node_statuses(const std::shared_ptr<const nlohmann::json>& statuses)
 {
-    server_.broadcast_message_sync(web_message::node_status_command_s{
-        .id     = std::string(id),
-        .status = status,
-    });
+    // Called on the render thread; the server serializes the batch on its own thread.
+    const auto version = configuration_.change_log().append_statuses(*statuses);
+    server_.broadcast_node_statuses(statuses, version);
 }
 
 } // namespace
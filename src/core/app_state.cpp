@@ -6,7 +6,9 @@
 #include "gpu/transfer/detail/texture_transfer_backend_factory.hpp"
 #include "gpu/transfer/texture_readback.hpp"
 #include "gpu/transfer/texture_upload.hpp"
+#include "media/source_sync_group.hpp"
 #include "nodes/decklink/registry.hpp"
+#include "nodes/framebuffer_pool.hpp"
 #include "nodes/ndi/registry.hpp"
 #include "render/font/font_loader.hpp"
 #include "render/font/font_registry.hpp"
@@ -43,10 +45,15 @@ app_state_s::app_state_s(command_line_options_s command_line_options)
     , ndi_registry_(nodes::ndi::ndi_registry_s::create_ndi_registry())
     , font_registry_(render::font_registry_s::create_font_registry())
     , status_registry_(std::make_unique<node_status_registry_s>())
+    , source_sync_registry_(std::make_unique<media::source_sync_registry_s>())
+    , framebuffer_pool_(std::make_unique<nodes::framebuffer_pool_s>())
 {
     // Transfer backend initialization must happen on the root GL context. It is
     // intentionally part of app startup rather than context construction so a
     // failed optional backend simply selects the persistent-PBO implementation.
+    gpu::context_s::set_shader_cache_directory(command_line_options_.shader_cache_path);
+    ctx_->start_shader_warm_up();
+
     const gpu::context_scope_s context_scope(*ctx_);
     auto                       fallback_texture = std::make_unique<gpu::texture_s>(
         gpu::vec2i_t{FALLBACK_TEXTURE_DIMENSION, FALLBACK_TEXTURE_DIMENSION}, gpu::texture_s::pixel_format_e::rgba_f16);
@@ -64,6 +71,8 @@ app_state_s::app_state_s(command_line_options_s command_line_options)
 
 app_state_s::app_state_s(test_state_t /*test_state*/, command_line_options_s command_line_options)
     : command_line_options_(std::move(command_line_options))
+    , source_sync_registry_(std::make_unique<media::source_sync_registry_s>())
+    , framebuffer_pool_(std::make_unique<nodes::framebuffer_pool_s>())
 {
 }
 
@@ -88,6 +97,7 @@ app_state_s::~app_state_s()
     texture_upload_service_.reset();
     {
         const gpu::context_scope_s context_scope(*ctx_);
+        framebuffer_pool_.reset();
         fallback_texture_.reset();
         gpu::transfer::detail::shutdown_texture_transfer_backends();
     }
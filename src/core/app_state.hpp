@@ -7,8 +7,10 @@
 #include "gpu/transfer/texture_readback_fwd.hpp"
 #include "gpu/transfer/texture_upload_fwd.hpp"
 #include "gpu/types.hpp"
+#include "media/source_sync_group_fwd.hpp"
 #include "nodes/decklink/registry_fwd.hpp"
 #include "nodes/frame_execution_fwd.hpp"
+#include "nodes/framebuffer_pool_fwd.hpp"
 #include "nodes/ndi/registry_fwd.hpp"
 #include "render/font/font_registry_fwd.hpp"
 #include "types/frame_rate.hpp"
@@ -53,11 +55,20 @@ class app_state_s
             gpu::vec2i_t default_size{DEFAULT_WIDTH, DEFAULT_HEIGHT};
         };
 
+        struct gpu_memory_settings_s
+        {
+            static constexpr int MAX_BUDGET_MB = 262'144;
+
+            // Zero leaves GPU memory unlimited
+            int budget_mb{0};
+        };
+
         frame_rate_s               frame_rate{DEFAULT_FRAME_RATE};
         framebuffer_settings_s     framebuffer;
         decklink_output_settings_s decklink_output;
         ndi_output_settings_s      ndi_output;
         screen_output_settings_s   screen_output;
+        gpu_memory_settings_s      gpu_memory;
     };
 
   private:
@@ -79,6 +90,8 @@ class app_state_s
     std::unique_ptr<nodes::ndi::ndi_registry_s>                ndi_registry_;
     std::unique_ptr<render::font_registry_s>                   font_registry_;
     std::unique_ptr<node_status_registry_s>                    status_registry_;
+    std::unique_ptr<media::source_sync_registry_s>             source_sync_registry_;
+    std::unique_ptr<nodes::framebuffer_pool_s>                 framebuffer_pool_;
 
     frame_settings_s frame_settings_{};
     frame_context_s  frame_context_{};
@@ -106,6 +119,8 @@ class app_state_s
     auto font_registry() noexcept { return font_registry_.get(); }
     auto thread_pool() noexcept { return thread_pool_.get(); }
     auto status_registry() noexcept { return status_registry_.get(); }
+    auto source_sync_registry() noexcept { return source_sync_registry_.get(); }
+    auto framebuffer_pool() noexcept { return framebuffer_pool_.get(); }
 
     const command_line_options_s& command_line_options() const noexcept { return command_line_options_; }
 
@@ -118,6 +133,10 @@ class app_state_s
     {
         nodes::submitted_node_set_t submitted_nodes;
         nodes::executed_node_set_t  executed_nodes;
+        // Nodes whose execute has returned, a subset of executed_nodes
+        nodes::finished_node_set_t  finished_nodes;
+        // Nodes keeping their outputs from an earlier frame instead of executing
+        nodes::reused_node_set_t    reused_nodes;
     } frame_info;
 };
 
@@ -6,6 +6,8 @@
 
 #include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <format>
 #include <limits>
 #include <sstream>
 #include <stdexcept>
@@ -17,6 +19,8 @@ namespace {
 
 namespace program_options = boost::program_options;
 
+constexpr uint64_t MAX_HTTP_THREADS = 64;
+
 template <typename String>
 program_options::options_description make_options_description()
 {
@@ -26,6 +30,16 @@ program_options::options_description make_options_description()
     add_option("log-debug", "Enable debug logging");
     add_option("log-trace", "Enable trace logging");
     add_option("settings", program_options::value<String>(), "Path to the settings file");
+    add_option("shader-cache",
+               program_options::value<String>(),
+               "Directory for compiled shader programs, defaults to shader_cache next to the settings file. An "
+               "empty value disables the cache");
+    add_option("autosave-interval",
+               program_options::value<double>(),
+               "Seconds between saves of the settings file while it is being edited, 0 disables autosave");
+    add_option("http-threads",
+               program_options::value<uint64_t>(),
+               "Number of threads serving HTTP and WebSocket connections");
     add_option("stop-after", program_options::value<double>(), "Stop after a positive number of seconds");
     add_option("test-render-delay-ms",
                program_options::value<uint64_t>(),
@@ -79,6 +93,32 @@ command_line_options_s parse_command_line_options_impl(int argc, Character** arg
         }
     }
 
+    if (values.contains("shader-cache")) {
+        if constexpr (std::same_as<Character, char>) {
+            result.shader_cache_path = utils::path_from_utf8(values["shader-cache"].as<string_t>());
+        } else {
+            result.shader_cache_path = values["shader-cache"].as<string_t>();
+        }
+    } else {
+        result.shader_cache_path = result.settings_path.parent_path() / "shader_cache";
+    }
+
+    if (values.contains("autosave-interval")) {
+        const auto seconds = values["autosave-interval"].as<double>();
+        if (!std::isfinite(seconds) || seconds < 0.0) {
+            throw_invalid_option("--autosave-interval requires a non-negative number of seconds");
+        }
+        result.autosave_interval = std::chrono::duration<double>{seconds};
+    }
+
+    if (values.contains("http-threads")) {
+        const auto threads = values["http-threads"].as<uint64_t>();
+        if (threads == 0 || threads > MAX_HTTP_THREADS) {
+            throw_invalid_option(std::format("--http-threads requires a number between 1 and {}", MAX_HTTP_THREADS));
+        }
+        result.http_threads = static_cast<size_t>(threads);
+    }
+
     if (values.contains("stop-after")) {
         const auto seconds = values["stop-after"].as<double>();
         if (!std::isfinite(seconds) || seconds <= 0.0) {
@@ -2,6 +2,7 @@
 #include <spdlog/common.h>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <optional>
@@ -18,8 +19,14 @@ struct render_thread_delay_test_options_s
 
 struct command_line_options_s
 {
+    static constexpr std::chrono::duration<double> DEFAULT_AUTOSAVE_INTERVAL{5.0};
+    static constexpr size_t                        DEFAULT_HTTP_THREADS{2};
+
     spdlog::level::level_enum                         log_level{spdlog::level::info};
     std::filesystem::path                             settings_path;
+    std::filesystem::path                             shader_cache_path; // Empty disables
+    std::chrono::duration<double>                     autosave_interval{DEFAULT_AUTOSAVE_INTERVAL}; // Zero disables
+    size_t                                            http_threads{DEFAULT_HTTP_THREADS};
     std::optional<std::chrono::duration<double>>      stop_after;
     std::optional<render_thread_delay_test_options_s> render_thread_delay_test;
     bool                                              show_help{};
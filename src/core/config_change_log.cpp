@@ -0,0 +1,89 @@
+#include "config_change_log.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <utility>
+
+namespace miximus::core {
+namespace {
+
+std::string make_log_id()
+{
+    std::random_device device;
+    std::ostringstream id;
+    id << std::hex << std::setfill('0') << std::setw(8) << device() << std::setw(8) << device();
+    return std::move(id).str();
+}
+
+} // namespace
+
+config_change_log_s::config_change_log_s(size_t capacity)
+    : id_(make_log_id())
+    , capacity_(std::max<size_t>(capacity, 1))
+{
+}
+
+uint64_t config_change_log_s::version() const
+{
+    std::scoped_lock lock(mutex_);
+    return version_;
+}
+
+void config_change_log_s::record_locked(nlohmann::json command)
+{
+    entries_.push_back({.version = version_, .command = std::move(command)});
+    while (entries_.size() > capacity_) {
+        truncated_version_ = entries_.front().version;
+        entries_.pop_front();
+    }
+}
+
+uint64_t config_change_log_s::append_statuses(const nlohmann::json& statuses)
+{
+    std::scoped_lock lock(mutex_);
+    ++version_;
+    for (const auto& [id, delta] : statuses.items()) {
+        status_versions_[id] = version_;
+    }
+    return version_;
+}
+
+void config_change_log_s::remove_node_status(std::string_view node_id)
+{
+    std::scoped_lock lock(mutex_);
+    if (auto it = status_versions_.find(node_id); it != status_versions_.end()) {
+        status_versions_.erase(it);
+    }
+}
+
+std::optional<config_change_log_s::changes_s> config_change_log_s::changes_since(uint64_t version,
+                                                                                uint64_t status_version) const
+{
+    std::scoped_lock lock(mutex_);
+
+    if (version < truncated_version_ || version > version_ || status_version > version_) {
+        return std::nullopt;
+    }
+
+    changes_s changes{.version = version_};
+
+    const auto first = std::upper_bound(entries_.begin(), entries_.end(), version, [](uint64_t v, const entry_s& e) {
+        return v < e.version;
+    });
+    changes.commands.reserve(static_cast<size_t>(std::distance(first, entries_.end())));
+    for (auto it = first; it != entries_.end(); ++it) {
+        changes.commands.push_back(it->command);
+    }
+
+    for (const auto& [id, changed] : status_versions_) {
+        if (changed > status_version) {
+            changes.status_ids.push_back(id);
+        }
+    }
+
+    return changes;
+}
+
+} // namespace miximus::core
@@ -0,0 +1,102 @@
+#pragma once
+#include "utils/transparent_string_hash.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace miximus::core {
+
+/**
+ * Bounded log of the configuration commands broadcast to clients, with one
+ * monotonically increasing version shared by commands and node status
+ * changes. A reconnecting client reports the last versions it saw and is sent
+ * only what it missed; a full snapshot is needed once the commands it missed
+ * have been truncated from the log.
+ */
+class config_change_log_s
+{
+    struct entry_s
+    {
+        uint64_t       version{};
+        nlohmann::json command;
+    };
+
+    using status_version_map_t =
+        std::unordered_map<std::string, uint64_t, utils::transparent_string_hash, std::equal_to<>>;
+
+    mutable std::mutex   mutex_;
+    std::string          id_;
+    size_t               capacity_;
+    uint64_t             version_{};
+    uint64_t             truncated_version_{}; // Newest version dropped from entries_
+    std::deque<entry_s>  entries_;
+    status_version_map_t status_versions_; // Version of the last status change of each node
+
+    void record_locked(nlohmann::json command);
+
+  public:
+    struct changes_s
+    {
+        uint64_t                    version{};
+        std::vector<nlohmann::json> commands;
+        std::vector<std::string>    status_ids; // Nodes whose status changed
+    };
+
+    explicit config_change_log_s(size_t capacity);
+    ~config_change_log_s() = default;
+
+    config_change_log_s(const config_change_log_s&)            = delete;
+    config_change_log_s(config_change_log_s&&)                 = delete;
+    config_change_log_s& operator=(const config_change_log_s&) = delete;
+    config_change_log_s& operator=(config_change_log_s&&)      = delete;
+
+    /**
+     * Random per process, so versions reported by a client that was connected
+     * to a previous run are never mistaken for versions of this log.
+     */
+    const std::string& id() const { return id_; }
+
+    uint64_t version() const;
+
+    /**
+     * Stamp a command message with the next version and record it. Returns the
+     * serialized command, ready to be broadcast.
+     */
+    template <typename Command>
+    nlohmann::json append(Command command)
+    {
+        std::scoped_lock lock(mutex_);
+        command.version     = ++version_;
+        nlohmann::json json = command;
+        record_locked(json);
+        return json;
+    }
+
+    /**
+     * Stamp one tick of status deltas, an object keyed by node id, with the
+     * next version. Only the ids are kept; the values are read back from the
+     * status registry when a client catches up.
+     */
+    uint64_t append_statuses(const nlohmann::json& statuses);
+
+    void remove_node_status(std::string_view node_id);
+
+    /**
+     * Commands newer than `version` and nodes whose status changed after
+     * `status_version`, or nullopt when the log no longer reaches back to
+     * `version` or either version is from the future.
+     */
+    std::optional<changes_s> changes_since(uint64_t version, uint64_t status_version) const;
+};
+
+} // namespace miximus::core
@@ -8,20 +8,22 @@
 #include "types/connection.hpp"
 #include "utils/filesystem.hpp"
 #include "utils/lookup.hpp"
+#include "utils/parallel_for.hpp"
 
 #include <nlohmann/json.hpp>
 
 #include <cstdint>
 #include <format>
 #include <fstream>
-#include <iomanip>
 #include <limits>
 #include <mutex>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace {
 using namespace miximus;
@@ -50,9 +52,9 @@ uint32_t get_schema_version(const json& object, std::string_view description)
 
 struct node_load_info_s
 {
-    const miximus::nodes::node_definition_s* definition;
+    const miximus::nodes::node_definition_s* definition{};
     std::string                              type;
-    uint32_t                                 original_version;
+    uint32_t                                 original_version{};
 };
 
 using node_load_info_map_t = std::unordered_map<std::string, node_load_info_s>;
@@ -66,66 +68,92 @@ get_migration(const node_load_info_s& info, uint32_t version, std::string_view t
     return info.definition->migrations[version - 1];
 }
 
-void require_no_error(error_e error, std::string_view operation, std::string_view id)
+// What serializing a node needs, copied so the document can be built without the node lock
+struct node_snapshot_s
 {
-    if (error != error_e::no_error) {
-        throw std::runtime_error(std::format("Failed to {} {}: {}", operation, id, enum_to_string(error)));
+    std::string id;
+    std::string type;
+    uint32_t    schema_version{};
+    json        options;
+};
+
+node_snapshot_s snapshot_node(std::string_view                             id,
+                              const miximus::nodes::node_record_s&         record,
+                              const miximus::nodes::node_definition_map_t& definitions)
+{
+    const auto type       = record.node->type();
+    const auto definition = definitions.find(type);
+    if (definition == definitions.end()) {
+        throw std::logic_error(std::format("Node type {} is not registered", type));
     }
+
+    return {
+        .id             = std::string(id),
+        .type           = std::string(type),
+        .schema_version = definition->second.schema_version(),
+        .options        = record.state.options,
+    };
 }
 
-json serialize_node(std::string_view                         id,
-                    const miximus::nodes::node_record_s&     record,
-                    const miximus::nodes::node_definition_s& definition)
+json serialize_node(node_snapshot_s node)
 {
     return {
-        {"id",             id                         },
-        {"type",           record.node->type()        },
-        {"schema_version", definition.schema_version()},
-        {"options",        record.state.options       },
+        {"id",             std::move(node.id)     },
+        {"type",           std::move(node.type)   },
+        {"schema_version", node.schema_version    },
+        {"options",        std::move(node.options)},
     };
 }
 
-node_load_info_map_t migrate_nodes(json& nodes, const miximus::nodes::node_definition_map_t& definitions)
+node_load_info_s migrate_node(json& node, const miximus::nodes::node_definition_map_t& definitions)
 {
-    node_load_info_map_t node_info;
-    node_info.reserve(nodes.size());
+    const auto type = node.at("type").get<std::string_view>();
+    const auto id   = node.at("id").get<std::string_view>();
 
-    for (auto& node : nodes) {
-        const auto type = node.at("type").get<std::string_view>();
-        const auto id   = node.at("id").get<std::string>();
+    const auto definition = definitions.find(type);
+    if (definition == definitions.end()) {
+        throw std::runtime_error(std::format("Node {} has unknown type {}", id, type));
+    }
 
-        const auto definition = definitions.find(type);
-        if (definition == definitions.end()) {
-            throw std::runtime_error(std::format("Node {} has unknown type {}", id, type));
-        }
+    const auto original_version = get_schema_version(node, std::format("Node {} ({})", id, type));
+    const auto current_version  = definition->second.schema_version();
+    if (original_version > current_version) {
+        throw std::runtime_error(std::format("Node {} ({}) uses schema version {}, but this application supports {}",
+                                             id,
+                                             type,
+                                             original_version,
+                                             current_version));
+    }
 
-        const auto original_version = get_schema_version(node, std::format("Node {} ({})", id, type));
-        const auto current_version  = definition->second.schema_version();
-        if (original_version > current_version) {
-            throw std::runtime_error(
-                std::format("Node {} ({}) uses schema version {}, but this application supports {}",
-                            id,
-                            type,
-                            original_version,
-                            current_version));
+    node_load_info_s info{
+        .definition       = &definition->second,
+        .type             = std::string(type),
+        .original_version = original_version,
+    };
+    auto& options = node.at("options");
+    for (auto version = original_version; version < current_version; ++version) {
+        const auto& migration = get_migration(info, version, info.type);
+        if (migration.migrate_options) {
+            migration.migrate_options(options);
         }
+    }
+    node["schema_version"] = current_version;
 
-        const node_load_info_s info{
-            .definition       = &definition->second,
-            .type             = std::string(type),
-            .original_version = original_version,
-        };
-        auto& options = node.at("options");
-        for (auto version = original_version; version < current_version; ++version) {
-            const auto& migration = get_migration(info, version, type);
-            if (migration.migrate_options) {
-                migration.migrate_options(options);
-            }
-        }
-        node["schema_version"] = current_version;
+    return info;
+}
+
+node_load_info_map_t migrate_nodes(json& nodes, const miximus::nodes::node_definition_map_t& definitions)
+{
+    // Every node migrates independently, so large show files are spread over all cores
+    std::vector<node_load_info_s> infos(nodes.size());
+    miximus::utils::parallel_for(nodes.size(), [&](size_t i) { infos[i] = migrate_node(nodes[i], definitions); });
 
-        if (!node_info.emplace(id, info).second) {
-            throw std::runtime_error(std::format("Duplicate node id {}", id));
+    node_load_info_map_t node_info;
+    node_info.reserve(nodes.size());
+    for (size_t i = 0; i < infos.size(); ++i) {
+        auto id = nodes[i].at("id").get<std::string>();
+        if (!node_info.emplace(std::move(id), std::move(infos[i])).second) {
+            throw std::runtime_error(std::format("Duplicate node id {}", nodes[i].at("id").get<std::string_view>()));
         }
     }
 
@@ -198,23 +226,30 @@ void configuration_s::load(json config)
     const auto node_info = migrate_nodes(nodes, node_manager_.node_definitions_);
     migrate_connections(connections, node_info);
 
-    for (const auto& node : nodes) {
-        const auto type = node.at("type").get<std::string_view>();
-        const auto id   = node.at("id").get<std::string_view>();
+    // The settings are applied together with the graph, so a file that fails
+    // to load leaves the running settings untouched as well
+    std::vector<node_manager_s::node_load_s> loaded_nodes;
+    const json*                              settings_options = nullptr;
+    loaded_nodes.reserve(nodes.size());
+    for (auto& node : nodes) {
+        auto type = node.at("type").get<std::string>();
+        auto id   = node.at("id").get<std::string>();
         if (id == nodes::system::SETTINGS_NODE_ID) {
             if (type != nodes::system::SETTINGS_NODE_TYPE) {
                 throw std::runtime_error("The reserved application settings node has the wrong type");
             }
-            require_no_error(node_manager_.handle_update_node(id, node.at("options")).error, "update node", id);
+            settings_options = &node.at("options");
         } else {
-            require_no_error(node_manager_.handle_add_node(type, id, node.at("options")), "create node", id);
+            loaded_nodes.push_back({
+                .type    = std::move(type),
+                .id      = std::move(id),
+                .options = std::move(node.at("options")),
+            });
         }
     }
 
-    for (const auto& connection : connections) {
-        const auto parsed = connection.get<connection_s>();
-        require_no_error(node_manager_.handle_add_connection(parsed), "create connection from node", parsed.from_node);
-    }
+    node_manager_.load_graph(
+        std::move(loaded_nodes), connections.get<std::vector<connection_s>>(), settings_options);
 }
 
 void configuration_s::load_file(const std::filesystem::path& path)
@@ -222,15 +257,28 @@ void configuration_s::load_file(const std::filesystem::path& path)
     auto log = getlog("app");
     log->info("Reading settings from {}", utils::path_to_utf8(path));
 
-    std::ifstream file(path);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         log->error("Failed to open settings file {}", utils::path_to_utf8(path));
         return;
     }
 
+    // Parsing from one contiguous buffer is much faster than pulling
+    // characters through the stream one at a time
+    const auto size = file.tellg();
+    if (size < 0) {
+        throw std::runtime_error(std::format("Failed to read settings file {}", utils::path_to_utf8(path)));
+    }
+
+    std::string contents(static_cast<size_t>(size), '\0');
+    file.seekg(0);
+    if (!file.read(contents.data(), static_cast<std::streamsize>(contents.size()))) {
+        throw std::runtime_error(std::format("Failed to read settings file {}", utils::path_to_utf8(path)));
+    }
+
     json config;
     try {
-        config = json::parse(file);
+        config = json::parse(contents);
     } catch (const json::parse_error& error) {
         throw std::runtime_error(
             std::format("Failed to parse settings file {}: {}", utils::path_to_utf8(path), error.what()));
@@ -239,23 +287,42 @@ void configuration_s::load_file(const std::filesystem::path& path)
     load(std::move(config));
 }
 
-json configuration_s::serialize(bool include_status) const
+json configuration_s::serialize(bool include_status, uint64_t* change_log_version) const
 {
-    const std::unique_lock lock(node_manager_.nodes_mutex_);
+    // The render thread takes the node mutex every frame, so only the plain
+    // values are copied while holding it and the document is built after
+    std::vector<node_snapshot_s> node_snapshots;
+    nodes::con_set_t             connection_snapshots;
+    json                         status;
+    {
+        const std::unique_lock lock(node_manager_.nodes_mutex_);
 
-    auto nodes       = json::array();
-    auto connections = json::array();
+        // Commands are logged while the node mutex is held, so this version
+        // matches the nodes and connections copied below exactly.
+        if (change_log_version != nullptr) {
+            *change_log_version = change_log_.version();
+        }
 
-    for (const auto& [id, record] : node_manager_.nodes_) {
-        const auto definition = node_manager_.node_definitions_.find(record.node->type());
-        if (definition == node_manager_.node_definitions_.end()) {
-            throw std::logic_error(std::format("Node type {} is not registered", record.node->type()));
+        node_snapshots.reserve(node_manager_.nodes_.size());
+        for (const auto& [id, record] : node_manager_.nodes_) {
+            node_snapshots.emplace_back(snapshot_node(id, record, node_manager_.node_definitions_));
         }
+        connection_snapshots = node_manager_.connections_;
 
-        nodes.emplace_back(serialize_node(id, record, definition->second));
+        if (include_status) {
+            status =
+                node_manager_.status_registry_ != nullptr ? node_manager_.status_registry_->get_all() : json::object();
+        }
     }
 
-    for (const auto& connection : node_manager_.connections_) {
+    auto nodes       = json::array();
+    auto connections = json::array();
+
+    for (auto& node : node_snapshots) {
+        nodes.emplace_back(serialize_node(std::move(node)));
+    }
+
+    for (const auto& connection : connection_snapshots) {
         connections.emplace_back(connection);
     }
 
@@ -266,8 +333,7 @@ json configuration_s::serialize(bool include_status) const
     };
 
     if (include_status) {
-        result["status"] =
-            node_manager_.status_registry_ != nullptr ? node_manager_.status_registry_->get_all() : json::object();
+        result["status"] = std::move(status);
     }
 
     return result;
@@ -277,6 +343,13 @@ json configuration_s::get_config() const { return serialize(false); }
 
 json configuration_s::get_snapshot() const { return serialize(true); }
 
+std::pair<json, uint64_t> configuration_s::get_versioned_snapshot() const
+{
+    uint64_t version{};
+    auto     snapshot = serialize(true, &version);
+    return {std::move(snapshot), version};
+}
+
 std::optional<json> configuration_s::get_node(std::string_view id) const
 {
     const std::unique_lock lock(node_manager_.nodes_mutex_);
@@ -286,12 +359,7 @@ std::optional<json> configuration_s::get_node(std::string_view id) const
         return std::nullopt;
     }
 
-    const auto definition = node_manager_.node_definitions_.find(record->second.node->type());
-    if (definition == node_manager_.node_definitions_.end()) {
-        throw std::logic_error(std::format("Node type {} is not registered", record->second.node->type()));
-    }
-
-    return serialize_node(record->first, record->second, definition->second);
+    return serialize_node(snapshot_node(record->first, record->second, node_manager_.node_definitions_));
 }
 
 std::optional<json> configuration_s::get_node_status(std::string_view id) const
@@ -304,20 +372,50 @@ std::optional<json> configuration_s::get_node_status(std::string_view id) const
     return node_manager_.status_registry_ != nullptr ? node_manager_.status_registry_->get(id) : json::object();
 }
 
-void configuration_s::save_file(const std::filesystem::path& path) const
+size_t configuration_s::save_file(const std::filesystem::path& path) const
 {
-    auto log = getlog("app");
-    log->info("Writing settings to {}", utils::path_to_utf8(path));
+    // The node lock is only held while node options and connections are
+    // copied; building the document, formatting and disk I/O run without it
+    const auto contents = get_config().dump(2);
 
-    std::ofstream file(path);
-    if (!file.is_open()) {
-        throw std::runtime_error(std::format("Failed to open settings file {} for writing", utils::path_to_utf8(path)));
+    auto temp_path = path;
+    temp_path += ".tmp";
+
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error(
+                std::format("Failed to open settings file {} for writing", utils::path_to_utf8(temp_path)));
+        }
+
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        file.close();
+        // Without the sync a power loss after the rename can leave an empty
+        // or truncated file, the data may still only be in the OS cache
+        if (!file || !utils::sync_to_disk(temp_path)) {
+            std::error_code ignored;
+            std::filesystem::remove(temp_path, ignored);
+            throw std::runtime_error(std::format("Failed to write settings file {}", utils::path_to_utf8(temp_path)));
+        }
     }
 
-    file << std::setfill(' ') << std::setw(2) << get_config();
-    if (!file) {
-        throw std::runtime_error(std::format("Failed to write settings file {}", utils::path_to_utf8(path)));
+    // Replacing the synced file with a rename means a crash or power loss
+    // mid-write leaves the previous settings intact instead of a truncated file
+    std::error_code error;
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        std::error_code ignored;
+        std::filesystem::remove(temp_path, ignored);
+        throw std::runtime_error(std::format(
+            "Failed to replace settings file {}: {}", utils::path_to_utf8(path), error.message()));
     }
+
+    // The rename itself is only durable once the directory is synced, until
+    // then either the old or the new file survives. Windows cannot sync a
+    // directory this way and journals the rename on its own.
+    (void)utils::sync_to_disk(path.has_parent_path() ? path.parent_path() : std::filesystem::path("."));
+
+    return contents.size();
 }
 
 } // namespace miximus::core
@@ -1,22 +1,27 @@
 #pragma once
+#include "core/config_change_log.hpp"
 #include "core/node_manager_fwd.hpp"
 
 #include <nlohmann/json_fwd.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string_view>
+#include <utility>
 
 namespace miximus::core {
 
 class configuration_s
 {
-    static constexpr uint32_t SCHEMA_VERSION = 1;
+    static constexpr uint32_t SCHEMA_VERSION      = 1;
+    static constexpr size_t   CHANGE_LOG_CAPACITY = 4096;
 
-    node_manager_s& node_manager_;
+    node_manager_s&     node_manager_;
+    config_change_log_s change_log_{CHANGE_LOG_CAPACITY};
 
-    nlohmann::json serialize(bool include_status) const;
+    nlohmann::json serialize(bool include_status, uint64_t* change_log_version = nullptr) const;
 
   public:
     explicit configuration_s(node_manager_s& node_manager)
@@ -24,6 +29,8 @@ class configuration_s
     {
     }
 
+    config_change_log_s& change_log() { return change_log_; }
+
     void load(nlohmann::json config);
     void load_file(const std::filesystem::path& path);
 
@@ -31,7 +38,16 @@ class configuration_s
     nlohmann::json                get_snapshot() const;
     std::optional<nlohmann::json> get_node(std::string_view id) const;
     std::optional<nlohmann::json> get_node_status(std::string_view id) const;
-    void                          save_file(const std::filesystem::path& path) const;
+
+    /**
+     * Write the configuration to a temporary file next to `path` and rename it
+     * over `path`, so the file on disk is always either the previous or the new
+     * settings. Callable from any thread. Returns the number of bytes written.
+     */
+    size_t save_file(const std::filesystem::path& path) const;
+
+    // Snapshot together with the change log version it is current as of
+    std::pair<nlohmann::json, uint64_t> get_versioned_snapshot() const;
 };
 
 } // namespace miximus::core
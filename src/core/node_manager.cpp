@@ -4,13 +4,16 @@
 #include "core/frame_scheduler.hpp"
 #include "core/node_status_registry.hpp"
 #include "gpu/context.hpp"
+#include "gpu/memory_registry.hpp"
 #include "logger/logger.hpp"
 #include "nodes/frame_execution.hpp"
+#include "nodes/framebuffer_pool.hpp"
 #include "nodes/interface.hpp"
 #include "nodes/node.hpp"
 #include "nodes/system/register.hpp"
 #include "types/node_status_json.hpp"
 #include "utils/flicks.hpp"
+#include "utils/parallel_for.hpp"
 #include "web_server/server.hpp"
 
 #include <nlohmann/json.hpp>
@@ -18,12 +21,15 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <format>
 #include <memory>
 #include <mutex>
 #include <random>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -78,6 +84,54 @@ bool is_connection_circular(const miximus::nodes::node_map_t& nodes,
     return false;
 }
 
+[[noreturn]] void throw_connection_error(const miximus::connection_s& con, miximus::error_e error)
+{
+    throw std::runtime_error(std::format("Failed to create connection {}:{} -> {}:{}: {}",
+                                         con.from_node,
+                                         con.from_interface,
+                                         con.to_node,
+                                         con.to_interface,
+                                         miximus::enum_to_string(error)));
+}
+
+// Kahn's algorithm over the whole edge list: if some nodes never run out of
+// unvisited inputs, they are part of a cycle.
+bool has_circular_connections(const miximus::nodes::con_set_t& connections)
+{
+    std::unordered_map<std::string_view, std::vector<std::string_view>> downstream;
+    std::unordered_map<std::string_view, size_t>                        input_count;
+
+    for (const auto& con : connections) {
+        downstream[con.from_node].push_back(con.to_node);
+        input_count.try_emplace(con.from_node, 0);
+        ++input_count[con.to_node];
+    }
+
+    std::vector<std::string_view> ready;
+    for (const auto& [id, count] : input_count) {
+        if (count == 0) {
+            ready.push_back(id);
+        }
+    }
+
+    size_t visited = 0;
+    while (!ready.empty()) {
+        const auto id = ready.back();
+        ready.pop_back();
+        ++visited;
+
+        if (const auto it = downstream.find(id); it != downstream.end()) {
+            for (const auto& to_node : it->second) {
+                if (--input_count[to_node] == 0) {
+                    ready.push_back(to_node);
+                }
+            }
+        }
+    }
+
+    return visited != input_count.size();
+}
+
 std::string generate_node_id(const miximus::nodes::node_map_t& nodes)
 {
     // Keep this fixed across targets. Fifteen bytes fit the std::string SSO
@@ -103,6 +157,36 @@ std::string generate_node_id(const miximus::nodes::node_map_t& nodes)
 
     return id;
 }
+
+// Returns whether the budget is exceeded
+bool publish_gpu_memory_status(miximus::core::node_status_registry_s* status_registry,
+                               const miximus::nodes::node_map_t&      nodes)
+{
+    using namespace miximus;
+
+    const auto& registry = gpu::memory_registry_s::global();
+    const auto  usage    = registry.usage_by_owner();
+    for (const auto& [id, record] : nodes) {
+        const auto it         = usage.find(id);
+        const auto node_usage = it != usage.end() ? it->second : gpu::memory_registry_s::usage_s{};
+        status_registry->write(id,
+                               status::gpu_memory_status_s{
+                                   .gpu_memory_bytes       = node_usage.bytes,
+                                   .gpu_memory_allocations = node_usage.allocations,
+                               });
+    }
+
+    const auto shared      = usage.find(std::string_view{});
+    const auto over_budget = registry.over_budget();
+    status_registry->write(nodes::system::SETTINGS_NODE_ID,
+                           status::application_gpu_memory_status_s{
+                               .gpu_memory_total_bytes  = registry.total_bytes(),
+                               .gpu_memory_shared_bytes = shared != usage.end() ? shared->second.bytes : 0,
+                               .gpu_memory_budget_bytes = registry.budget(),
+                               .gpu_memory_over_budget  = over_budget,
+                           });
+    return over_budget;
+}
 } // namespace
 
 namespace miximus::core {
@@ -156,11 +240,30 @@ error_e node_manager_s::handle_add_node_locked(std::string_view
         return error_e::duplicate_id;
     }
 
-    auto [node, error] = create_node(type);
+    auto [record, error] = create_node_record(type, id, options);
     if (error != error_e::no_error) {
         return error;
     }
 
+    const auto [node_it, inserted] = nodes_.emplace(id, std::move(record));
+    assert(inserted);
+    dirty_nodes_.emplace(id_str);
+
+    for (auto& adapter : adapters_) {
+        adapter->emit_add_node(type, id, node_it->second.state.options, origin);
+    }
+
+    return error;
+}
+
+std::pair<nodes::node_record_s, error_e>
+node_manager_s::create_node_record(std::string_view type, std::string_view id, const json& options) const
+{
+    auto [node, error] = create_node(type);
+    if (error != error_e::no_error) {
+        return {{}, error};
+    }
+
     node->init(id);
 
     nodes::node_record_s record;
@@ -169,11 +272,11 @@ error_e node_manager_s::handle_add_node_locked(std::string_view
     const auto default_result  = node->set_options(record.state.options, default_options);
     if (default_result.error != error_e::no_error || default_result.has_corrected_values) {
         _log()->error("Node type {} has invalid or non-canonical default options", type);
-        return error_e::internal_error;
+        return {{}, error_e::internal_error};
     }
 
     if (const auto result = node->set_options(record.state.options, options); result.error != error_e::no_error) {
-        return result.error;
+        return {{}, result.error};
     }
 
     // Prime the state with a con_set_t for each interface
@@ -181,16 +284,138 @@ error_e node_manager_s::handle_add_node_locked(std::string_view
         record.state.con_map.emplace(iface_id, nodes::con_set_t{});
     }
 
-    record.node                    = std::move(node);
-    const auto [node_it, inserted] = nodes_.emplace(id, std::move(record));
-    assert(inserted);
-    dirty_nodes_.emplace(id_str);
+    record.node = std::move(node);
+    return {std::move(record), error_e::no_error};
+}
 
-    for (auto& adapter : adapters_) {
-        adapter->emit_add_node(type, id, node_it->second.state.options, origin);
+void node_manager_s::load_graph(std::vector<node_load_s>  loaded_nodes,
+                                std::vector<connection_s> loaded_connections,
+                                const json*               settings_options)
+{
+    using dir_e = nodes::interface_i::dir_e;
+
+    // Nodes are constructed and configured in parallel, without the lock; nothing
+    // else can see them until the whole graph is committed below.
+    std::vector<nodes::node_record_s> records(loaded_nodes.size());
+    utils::parallel_for(loaded_nodes.size(), [&](size_t i) {
+        const auto& load = loaded_nodes[i];
+        if (load.id == nodes::system::SETTINGS_NODE_ID || load.type == nodes::system::SETTINGS_NODE_TYPE) {
+            throw std::runtime_error(std::format("Node {} uses the reserved application settings id or type", load.id));
+        }
+
+        auto [record, error] = create_node_record(load.type, load.id, load.options);
+        if (error != error_e::no_error) {
+            throw std::runtime_error(std::format("Failed to create node {}: {}", load.id, enum_to_string(error)));
+        }
+        records[i] = std::move(record);
+    });
+
+    const std::unique_lock lock(nodes_mutex_);
+
+    const bool only_settings_node = nodes_.size() == 1 && nodes_.contains(nodes::system::SETTINGS_NODE_ID);
+    if (!only_settings_node || !connections_.empty()) {
+        throw std::logic_error("Cannot load a graph into a non-empty node manager");
     }
 
-    return error;
+    // The graph is assembled on the side and swapped in whole, so a failure
+    // below leaves the manager untouched
+    nodes::node_map_t graph(nodes_);
+    graph.reserve(graph.size() + records.size());
+
+    bool settings_corrected = false;
+    if (settings_options != nullptr) {
+        auto&      settings = graph.at(std::string(nodes::system::SETTINGS_NODE_ID));
+        const auto result   = settings.node->set_options(settings.state.options, *settings_options);
+        if (result.error != error_e::no_error) {
+            throw std::runtime_error(std::format("Failed to update node {}: {}",
+                                                 nodes::system::SETTINGS_NODE_ID,
+                                                 enum_to_string(result.error)));
+        }
+        settings_corrected = result.has_corrected_values;
+    }
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (!graph.emplace(loaded_nodes[i].id, std::move(records[i])).second) {
+            throw std::runtime_error(std::format("Duplicate node id {}", loaded_nodes[i].id));
+        }
+    }
+
+    // Same checks as handle_add_connection, except for cycles, which are found
+    // in one pass over the finished graph instead of one search per connection
+    nodes::con_set_t       connections;
+    std::set<connection_s> unique_connections;
+    connections.reserve(loaded_connections.size());
+    for (auto& con : loaded_connections) {
+        auto from_node_it = graph.find(con.from_node);
+        auto to_node_it   = graph.find(con.to_node);
+        if (from_node_it == graph.end() || to_node_it == graph.end()) {
+            throw_connection_error(con, error_e::not_found);
+        }
+
+        const auto* from_iface = from_node_it->second.node->find_interface(con.from_interface);
+        const auto* to_iface   = to_node_it->second.node->find_interface(con.to_interface);
+        if (from_iface == nullptr || to_iface == nullptr) {
+            throw_connection_error(con, error_e::not_found);
+        }
+
+        const auto from_dir = from_iface->direction();
+        const auto to_dir   = to_iface->direction();
+        if (from_dir == dir_e::input && to_dir == dir_e::output) {
+            std::swap(con.from_node, con.to_node);
+            std::swap(con.from_interface, con.to_interface);
+            std::swap(from_iface, to_iface);
+            std::swap(from_node_it, to_node_it);
+        } else if (from_dir == dir_e::input || to_dir == dir_e::output) {
+            throw_connection_error(con, error_e::invalid_type);
+        }
+
+        if (!to_iface->accepts(from_iface->type())) {
+            throw_connection_error(con, error_e::invalid_type);
+        }
+        if (!unique_connections.insert(con).second) {
+            throw_connection_error(con, error_e::duplicate_id);
+        }
+
+        nodes::con_set_t removed_connections;
+        from_iface->add_connection(
+            &from_node_it->second.state.con_map.at(con.from_interface), con, &removed_connections);
+        to_iface->add_connection(&to_node_it->second.state.con_map.at(con.to_interface), con, &removed_connections);
+        connections.emplace_back(std::move(con));
+
+        // A later connection displaces an earlier one on a single input, as it would when added one at a time
+        for (const auto& rcon : removed_connections) {
+            std::erase(graph.find(rcon.from_node)->second.state.con_map.at(rcon.from_interface), rcon);
+            std::erase(graph.find(rcon.to_node)->second.state.con_map.at(rcon.to_interface), rcon);
+            unique_connections.erase(rcon);
+            std::erase(connections, rcon);
+        }
+    }
+
+    if (has_circular_connections(connections)) {
+        throw std::runtime_error("Configuration connections are circular");
+    }
+
+    nodes_.swap(graph);
+    connections_ = std::move(connections);
+    for (const auto& [id, _] : nodes_) {
+        dirty_nodes_.emplace(id);
+    }
+
+    _log()->info("Loaded {} nodes and {} connections", loaded_nodes.size(), connections_.size());
+
+    // Adapters are normally attached after loading, in which case there is nothing to publish
+    for (auto& adapter : adapters_) {
+        if (settings_options != nullptr) {
+            const auto& settings = nodes_.find(nodes::system::SETTINGS_NODE_ID)->second;
+            adapter->emit_update_node(
+                nodes::system::SETTINGS_NODE_ID, settings.state.options, settings_corrected, std::nullopt);
+        }
+        for (const auto& load : loaded_nodes) {
+            adapter->emit_add_node(load.type, load.id, nodes_.find(load.id)->second.state.options, std::nullopt);
+        }
+        for (const auto& con : connections_) {
+            adapter->emit_add_connection(con, std::nullopt);
+        }
+    }
 }
 
 error_e node_manager_s::handle_remove_node(std::string_view id, const std::optional<origin_info_s>& origin)
@@ -423,8 +648,13 @@ void node_manager_s::add_adapter(std::unique_ptr<adapter_i>&& adapter)
 
 void node_manager_s::clear_adapters()
 {
-    const std::unique_lock lock(nodes_mutex_);
-    adapters_.clear();
+    adapter_list_t adapters;
+    {
+        const std::unique_lock lock(nodes_mutex_);
+        adapters.swap(adapters_);
+    }
+    // Destroyed outside the lock, an adapter may wait for a thread that reads the configuration
+    adapters.clear();
 }
 
 void node_manager_s::tick_one_frame(app_state_s* app, frame_scheduler_s& scheduler)
@@ -453,6 +683,13 @@ void node_manager_s::tick_one_frame(app_state_s* app, frame_scheduler_s& schedul
                         nodes_copy_.insert_or_assign(it->first, it->second);
                     }
                 }
+                // Application settings reach nodes without a connection, so
+                // no node keeps its outputs across a settings change
+                if (dirty_nodes_.contains(std::string(nodes::system::SETTINGS_NODE_ID))) {
+                    for (auto& [_, record] : nodes_copy_) {
+                        record.executed_version.reset();
+                    }
+                }
                 _log()->info(
                     "Updated render graph: {} changed, {} removed", dirty_nodes_.size(), removed_nodes_.size());
                 dirty_nodes_.clear();
@@ -482,7 +719,9 @@ void node_manager_s::tick_one_frame(app_state_s* app, frame_scheduler_s& schedul
         frame_settings.decklink_output.buffer_frames = decklink_output_buffer_frames;
         frame_settings.ndi_output.buffer_frames      = ndi_output_buffer_frames;
         frame_settings.screen_output.buffer_frames   = screen_output_buffer_frames;
+        frame_settings.gpu_memory.budget_mb          = settings_state.options.at("gpu_memory_budget_mb").get<int>();
         app->begin_frame(frame_settings, scheduler.begin_frame(frame_rate));
+        gpu::memory_registry_s::global().set_budget(static_cast<size_t>(frame_settings.gpu_memory.budget_mb) << 20U);
 
         {
             const auto& frame_context = app->frame_context();
@@ -496,7 +735,8 @@ void node_manager_s::tick_one_frame(app_state_s* app, frame_scheduler_s& schedul
 
         const auto prepare_start   = utils::flicks_now();
         const auto demanding_nodes = nodes::prepare_all_nodes(app, nodes_copy_);
-        const auto prepare_end     = utils::flicks_now();
+        nodes::select_reused_nodes(app, nodes_copy_);
+        const auto prepare_end = utils::flicks_now();
 
         app->frame_info.submitted_nodes.clear();
         app->frame_info.submitted_nodes.reserve(nodes_copy_.size());
@@ -505,12 +745,15 @@ void node_manager_s::tick_one_frame(app_state_s* app, frame_scheduler_s& schedul
 
         app->frame_info.executed_nodes.clear();
         app->frame_info.executed_nodes.reserve(nodes_copy_.size());
+        app->frame_info.finished_nodes.clear();
+        app->frame_info.finished_nodes.reserve(nodes_copy_.size());
         nodes::execute_demanding_nodes(app, nodes_copy_, demanding_nodes);
         const auto execute_end = utils::flicks_now();
 
         const auto finish_end = execute_end;
 
         nodes::complete_all_nodes(app, nodes_copy_);
+        app->framebuffer_pool()->end_frame();
         const auto complete_end = utils::flicks_now();
 
         const auto now = std::chrono::steady_clock::now();
@@ -528,16 +771,28 @@ void node_manager_s::tick_one_frame(app_state_s* app, frame_scheduler_s& schedul
                                               .demanding_node_count   = demanding_nodes.size(),
                                               .submitted_node_count   = app->frame_info.submitted_nodes.size(),
                                               .executed_node_count    = app->frame_info.executed_nodes.size(),
+                                              .reused_node_count      = app->frame_info.reused_nodes.size(),
                                           });
-            next_lifecycle_status_ = now + 1s;
+
+            const auto over_budget = publish_gpu_memory_status(app->status_registry(), nodes_copy_);
+            if (over_budget && !gpu_memory_over_budget_) {
+                const auto& registry = gpu::memory_registry_s::global();
+                _log()->warn("GPU memory use of {} MiB exceeds the budget of {} MiB",
+                             registry.total_bytes() >> 20U,
+                             registry.budget() >> 20U);
+            }
+            gpu_memory_over_budget_ = over_budget;
+            next_lifecycle_status_  = now + 1s;
         }
     }
 
-    // Broadcast status changes collected during this tick
-    const auto status_updates = app->status_registry()->flush();
-    for (const auto& update : status_updates) {
+    // Broadcast status changes collected during this tick as a single batch.
+    // Serialization is left to the adapters, off the render thread.
+    auto status_updates = app->status_registry()->flush();
+    if (!status_updates.empty()) {
+        const auto statuses = std::make_shared<const nlohmann::json>(std::move(status_updates));
         for (auto& adapter : adapters_) {
-            adapter->emit_node_status(update.node_id, update.status);
+            adapter->emit_node_statuses(statuses);
         }
     }
 }
@@ -553,7 +808,7 @@ void node_manager_s::clear_nodes(app_state_s* app)
     removed_nodes_.clear();
 }
 
-std::pair<std::shared_ptr<nodes::node_i>, error_e> node_manager_s::create_node(std::string_view type)
+std::pair<std::shared_ptr<nodes::node_i>, error_e> node_manager_s::create_node(std::string_view type) const
 {
     auto it = node_definitions_.find(type);
     if (it == node_definitions_.end()) {
@@ -18,8 +18,10 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace miximus::core {
@@ -40,7 +42,10 @@ class node_manager_s
                                       const std::optional<origin_info_s>& origin)                                = 0;
         virtual void emit_add_connection(const connection_s& con, const std::optional<origin_info_s>& origin)    = 0;
         virtual void emit_remove_connection(const connection_s& con, const std::optional<origin_info_s>& origin) = 0;
-        virtual void emit_node_status(std::string_view id, const nlohmann::json& status)                         = 0;
+        // One call per tick with an object mapping node ids to status deltas.
+        // The batch is immutable and shared between adapters, so it can be
+        // handed to another thread without copying.
+        virtual void emit_node_statuses(const std::shared_ptr<const nlohmann::json>& statuses)                   = 0;
 
       public:
         adapter_i()          = default;
@@ -64,14 +69,24 @@ class node_manager_s
     adapter_list_t                        adapters_;
     node_status_registry_s*               status_registry_{nullptr};
     std::chrono::steady_clock::time_point next_lifecycle_status_{};
+    bool                                  gpu_memory_over_budget_{};
 
     error_e handle_add_node_locked(std::string_view                    type,
                                    std::string_view                    id,
                                    const nlohmann::json&               options,
                                    const std::optional<origin_info_s>& origin);
     error_e remove_connection_locked(const connection_s& con, const std::optional<origin_info_s>& origin);
+    std::pair<nodes::node_record_s, error_e>
+    create_node_record(std::string_view type, std::string_view id, const nlohmann::json& options) const;
 
   public:
+    struct node_load_s
+    {
+        std::string    type;
+        std::string    id;
+        nlohmann::json options;
+    };
+
     node_manager_s();
     ~node_manager_s() = default;
 
@@ -89,6 +104,18 @@ class node_manager_s
     error_e handle_remove_connection(const connection_s&                 con,
                                      const std::optional<origin_info_s>& origin = std::nullopt);
 
+    /**
+     * Bulk load a show file into a manager holding only the settings node.
+     * Nodes are constructed and configured in parallel outside the lock, the
+     * connections are validated in one pass and everything, including the
+     * `settings_options` when given, is committed as a single render graph
+     * update. Throws std::runtime_error naming the first node or connection
+     * that fails, in which case nothing is applied.
+     */
+    void load_graph(std::vector<node_load_s>  loaded_nodes,
+                    std::vector<connection_s> loaded_connections,
+                    const nlohmann::json*     settings_options = nullptr);
+
     nlohmann::json get_node_status(std::string_view id) const;
 
     void add_adapter(std::unique_ptr<adapter_i>&& adapter);
@@ -97,7 +124,7 @@ class node_manager_s
     void tick_one_frame(app_state_s*, frame_scheduler_s&);
     void clear_nodes(app_state_s*);
 
-    std::pair<std::shared_ptr<nodes::node_i>, error_e> create_node(std::string_view type);
+    std::pair<std::shared_ptr<nodes::node_i>, error_e> create_node(std::string_view type) const;
 };
 
 } // namespace miximus::core
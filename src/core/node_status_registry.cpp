@@ -3,57 +3,54 @@
 #include <nlohmann/json.hpp>
 
 namespace miximus::core {
+namespace {
 
-void node_status_registry_s::write(std::string_view node_id, nlohmann::json status)
+nlohmann::json read_slots(const std::vector<std::unique_ptr<node_status_slot_i>>& slots)
 {
-    std::scoped_lock lock(mutex_);
-    auto [state, _]         = states_.try_emplace(std::string(node_id), nlohmann::json::object());
-    nlohmann::json* pending = nullptr;
-
-    for (auto& [name, value] : status.items()) {
-        if (const auto current = state->second.find(name); current != state->second.end() && *current == value) {
-            continue;
-        }
-
-        state->second[name] = value;
-        if (pending == nullptr) {
-            pending = &pending_.try_emplace(state->first, nlohmann::json::object()).first->second;
+    auto status = nlohmann::json::object();
+    for (const auto& slot : slots) {
+        if (slot != nullptr) {
+            slot->read(status);
         }
-        (*pending)[name] = std::move(value);
     }
+    return status;
 }
 
+} // namespace
+
 void node_status_registry_s::remove_node(std::string_view node_id)
 {
-    std::scoped_lock lock(mutex_);
-    if (const auto it = states_.find(node_id); it != states_.end()) {
-        states_.erase(it);
-    }
-    if (const auto it = pending_.find(node_id); it != pending_.end()) {
-        pending_.erase(it);
+    std::unique_lock lock(mutex_);
+    if (const auto it = nodes_.find(node_id); it != nodes_.end()) {
+        nodes_.erase(it);
     }
 }
 
-std::vector<node_status_registry_s::status_update_s> node_status_registry_s::flush()
+nlohmann::json node_status_registry_s::flush()
 {
-    std::scoped_lock lock(mutex_);
+    std::shared_lock lock(mutex_);
 
-    std::vector<status_update_s> result;
-    result.reserve(pending_.size());
-    for (auto& [node_id, status] : pending_) {
-        result.push_back({node_id, std::move(status)});
+    auto result = nlohmann::json::object();
+    for (const auto& [node_id, slots] : nodes_) {
+        nlohmann::json delta;
+        for (const auto& slot : slots) {
+            if (slot != nullptr) {
+                slot->flush(delta);
+            }
+        }
+        if (!delta.is_null()) {
+            result.emplace(node_id, std::move(delta));
+        }
     }
-
-    pending_.clear();
     return result;
 }
 
 nlohmann::json node_status_registry_s::get(std::string_view node_id) const
 {
-    std::scoped_lock lock(mutex_);
+    std::shared_lock lock(mutex_);
 
-    if (auto it = states_.find(node_id); it != states_.end()) {
-        return it->second;
+    if (auto it = nodes_.find(node_id); it != nodes_.end()) {
+        return read_slots(it->second);
     }
 
     return nlohmann::json::object();
@@ -61,8 +58,13 @@ nlohmann::json node_status_registry_s::get(std::string_view node_id) const
 
 nlohmann::json node_status_registry_s::get_all() const
 {
-    std::scoped_lock lock(mutex_);
-    return states_;
+    std::shared_lock lock(mutex_);
+
+    auto result = nlohmann::json::object();
+    for (const auto& [node_id, slots] : nodes_) {
+        result.emplace(node_id, read_slots(slots));
+    }
+    return result;
 }
 
 } // namespace miximus::core
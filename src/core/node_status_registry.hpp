@@ -1,9 +1,13 @@
 #pragma once
+#include "core/node_status_slot.hpp"
+#include "types/node_status_json.hpp"
 #include "utils/transparent_string_hash.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -13,20 +17,45 @@ namespace miximus::core {
 
 class node_status_registry_s
 {
-  public:
-    struct status_update_s
-    {
-        std::string    node_id;
-        nlohmann::json status;
-    };
+    // Slots indexed by node_status_slot_index<T>(), created on the first write of each type
+    using slot_list_t = std::vector<std::unique_ptr<node_status_slot_i>>;
+    using node_map_t  = std::unordered_map<std::string, slot_list_t, utils::transparent_string_hash, std::equal_to<>>;
 
-  private:
-    using state_map_t =
-        std::unordered_map<std::string, nlohmann::json, utils::transparent_string_hash, std::equal_to<>>;
+    // Writers share the lock; it is only taken exclusively to add or remove slots
+    mutable std::shared_mutex mutex_;
+    node_map_t                nodes_;
 
-    mutable std::mutex mutex_;
-    state_map_t        states_;
-    state_map_t        pending_;
+    template <typename T>
+    node_status_slot_s<T>* find_slot(std::string_view node_id) const
+    {
+        const auto node = nodes_.find(node_id);
+        if (node == nodes_.end()) {
+            return nullptr;
+        }
+        const auto index = node_status_slot_index<T>();
+        if (index >= node->second.size()) {
+            return nullptr;
+        }
+        return static_cast<node_status_slot_s<T>*>(node->second[index].get());
+    }
+
+    template <typename T>
+    node_status_slot_s<T>& create_slot(std::string_view node_id)
+    {
+        auto node = nodes_.find(node_id);
+        if (node == nodes_.end()) {
+            node = nodes_.emplace(std::string(node_id), slot_list_t{}).first;
+        }
+        const auto index = node_status_slot_index<T>();
+        if (index >= node->second.size()) {
+            node->second.resize(index + 1);
+        }
+        auto& slot = node->second[index];
+        if (slot == nullptr) {
+            slot = std::make_unique<node_status_slot_s<T>>();
+        }
+        return static_cast<node_status_slot_s<T>&>(*slot);
+    }
 
   public:
     node_status_registry_s()  = default;
@@ -36,11 +65,25 @@ class node_status_registry_s
     node_status_registry_s& operator=(const node_status_registry_s&) = delete;
 
     /**
-     * Write a status object for a node. Typed status structs convert to JSON
-     * through ADL before this function is entered. Thread-safe and callable
-     * from any thread; unchanged fields are filtered out.
+     * Write a typed status struct for a node. Thread-safe and callable from
+     * any thread. After the first write of a type for a node this neither
+     * allocates nor converts to JSON, and writers only contend on the slot of
+     * the same node and type. Unchanged fields are filtered out on flush.
      */
-    void write(std::string_view node_id, nlohmann::json status);
+    template <described_json_object T>
+    void write(std::string_view node_id, const T& status)
+    {
+        {
+            std::shared_lock lock(mutex_);
+            if (auto* slot = find_slot<T>(node_id); slot != nullptr) {
+                slot->write(status);
+                return;
+            }
+        }
+
+        std::unique_lock lock(mutex_);
+        create_slot<T>(node_id).write(status);
+    }
 
     /**
      * Remove all status entries for a node. Called when a node is destroyed.
@@ -48,10 +91,10 @@ class node_status_registry_s
     void remove_node(std::string_view node_id);
 
     /**
-     * Drain pending changes and return per-node status deltas. Multiple writes
-     * to a node during one tick are merged into a single update.
+     * Collect the fields that changed since the previous flush and return them
+     * as one object mapping node ids to status deltas. Render thread only.
      */
-    std::vector<status_update_s> flush();
+    nlohmann::json flush();
 
     /**
      * Return the current status object for a single node (for pull queries).
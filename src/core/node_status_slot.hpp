@@ -0,0 +1,130 @@
+#pragma once
+#include "types/json_contract.hpp"
+
+#include <boost/describe.hpp>
+#include <boost/mp11.hpp>
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+namespace miximus::core {
+
+// Latest value of one status struct type for one node. Writers only copy the
+// struct under the slot's own mutex, which does not allocate for plain timing
+// structs and reuses capacity for the ones holding strings or lists. Field
+// comparison and JSON conversion happen when the render thread flushes.
+class node_status_slot_i
+{
+  protected:
+    std::atomic_bool dirty_{};
+
+  public:
+    node_status_slot_i()          = default;
+    virtual ~node_status_slot_i() = default;
+
+    node_status_slot_i(const node_status_slot_i&)            = delete;
+    node_status_slot_i(node_status_slot_i&&)                 = delete;
+    node_status_slot_i& operator=(const node_status_slot_i&) = delete;
+    node_status_slot_i& operator=(node_status_slot_i&&)      = delete;
+
+    // Render thread only. Adds the fields that changed since the previous
+    // flush to `delta`, which is left untouched when nothing changed.
+    virtual void flush(nlohmann::json& delta) = 0;
+
+    // Adds every field of the latest value to `status`. Callable from any thread.
+    virtual void read(nlohmann::json& status) = 0;
+};
+
+template <described_json_object T>
+class node_status_slot_s final : public node_status_slot_i
+{
+    using members_t =
+        boost::describe::describe_members<T, boost::describe::mod_public | boost::describe::mod_inherited>;
+
+    std::mutex mutex_;
+    T          latest_{};
+
+    // Owned by the flushing thread
+    T                snapshot_{};
+    std::optional<T> published_;
+
+    template <typename Member>
+    static void write_member(nlohmann::json& json, const char* name, const Member& value)
+    {
+        if constexpr (miximus::detail::optional_traits<Member>::value) {
+            if (value.has_value()) {
+                json[name] = *value;
+            } else {
+                json[name] = nullptr;
+            }
+        } else {
+            json[name] = value;
+        }
+    }
+
+  public:
+    void write(const T& value)
+    {
+        {
+            std::scoped_lock lock(mutex_);
+            latest_ = value;
+        }
+        dirty_.store(true, std::memory_order_release);
+    }
+
+    void flush(nlohmann::json& delta) final
+    {
+        if (!dirty_.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+
+        {
+            std::scoped_lock lock(mutex_);
+            snapshot_ = latest_;
+        }
+
+        boost::mp11::mp_for_each<members_t>([&](auto member) {
+            const auto& value = snapshot_.*member.pointer;
+            if (!published_.has_value() || !(value == (*published_).*member.pointer)) {
+                write_member(delta, member.name, value);
+            }
+        });
+
+        // Swapping keeps the capacity of both copies for the next flush
+        if (!published_.has_value()) {
+            published_.emplace();
+        }
+        std::swap(*published_, snapshot_);
+    }
+
+    void read(nlohmann::json& status) final
+    {
+        std::scoped_lock lock(mutex_);
+        boost::mp11::mp_for_each<members_t>(
+            [&](auto member) { write_member(status, member.name, latest_.*member.pointer); });
+    }
+};
+
+namespace detail {
+
+inline size_t next_node_status_slot_index()
+{
+    static std::atomic_size_t next_index;
+    return next_index.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+// Dense per-type index used to place a status type's slot in a node's slot list
+template <typename T>
+size_t node_status_slot_index()
+{
+    static const size_t index = detail::next_node_status_slot_index();
+    return index;
+}
+
+} // namespace miximus::core
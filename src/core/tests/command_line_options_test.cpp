@@ -31,7 +31,10 @@ TEST(CommandLineOptions, DefaultsSettingsPathRelativeToExecutable)
     const auto options = core::parse_command_line_options(static_cast<int>(arguments.size()), arguments.data());
 
     EXPECT_EQ(options.settings_path, "/opt/miximus/bin/settings.json");
+    EXPECT_EQ(options.shader_cache_path, "/opt/miximus/bin/shader_cache");
     EXPECT_EQ(options.log_level, spdlog::level::info);
+    EXPECT_EQ(options.autosave_interval, core::command_line_options_s::DEFAULT_AUTOSAVE_INTERVAL);
+    EXPECT_EQ(options.http_threads, core::command_line_options_s::DEFAULT_HTTP_THREADS);
     EXPECT_FALSE(options.stop_after.has_value());
     EXPECT_FALSE(options.render_thread_delay_test.has_value());
 }
@@ -104,6 +107,58 @@ TEST(CommandLineOptions, PreservesNativeWindowsSettingsPath)
 }
 #endif
 
+TEST(CommandLineOptions, ParsesShaderCachePath)
+{
+    auto argument_values = std::array{
+        std::string{"miximus"},
+        std::string{"--settings"},
+        std::string{"/srv/show/settings.json"},
+    };
+    auto arguments = make_arguments(argument_values);
+
+    auto options = core::parse_command_line_options(static_cast<int>(arguments.size()), arguments.data());
+    EXPECT_EQ(options.shader_cache_path, "/srv/show/shader_cache");
+
+    argument_values[1] = "--shader-cache";
+    argument_values[2] = "/var/cache/miximus";
+    arguments          = make_arguments(argument_values);
+    options            = core::parse_command_line_options(static_cast<int>(arguments.size()), arguments.data());
+    EXPECT_EQ(options.shader_cache_path, "/var/cache/miximus");
+
+    argument_values[2] = "";
+    arguments          = make_arguments(argument_values);
+    options            = core::parse_command_line_options(static_cast<int>(arguments.size()), arguments.data());
+    EXPECT_TRUE(options.shader_cache_path.empty());
+}
+
+TEST(CommandLineOptions, ParsesAutosaveInterval)
+{
+    auto argument_values = std::array{std::string{"miximus"}, std::string{"--autosave-interval"}, std::string{"0"}};
+    auto arguments       = make_arguments(argument_values);
+
+    const auto options = core::parse_command_line_options(static_cast<int>(arguments.size()), arguments.data());
+    EXPECT_EQ(options.autosave_interval.count(), 0.0);
+
+    argument_values[2] = "inf";
+    arguments          = make_arguments(argument_values);
+    EXPECT_THROW((void)core::parse_command_line_options(static_cast<int>(arguments.size()), arguments.data()),
+                 std::invalid_argument);
+}
+
+TEST(CommandLineOptions, ParsesHttpThreads)
+{
+    auto argument_values = std::array{std::string{"miximus"}, std::string{"--http-threads"}, std::string{"4"}};
+    auto arguments       = make_arguments(argument_values);
+
+    const auto options = core::parse_command_line_options(static_cast<int>(arguments.size()), arguments.data());
+    EXPECT_EQ(options.http_threads, 4U);
+
+    argument_values[2] = "0";
+    arguments          = make_arguments(argument_values);
+    EXPECT_THROW((void)core::parse_command_line_options(static_cast<int>(arguments.size()), arguments.data()),
+                 std::invalid_argument);
+}
+
 TEST(CommandLineOptions, RequiresCompleteRenderDelayConfiguration)
 {
     auto argument_values = std::array{std::string{"miximus"}, std::string{"--test-render-delay-ms"}, std::string{"12"}};
@@ -0,0 +1,77 @@
+#include "core/config_change_log.hpp"
+#include "types/web_message_json.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace miximus::core::tests {
+
+TEST(config_change_log, returns_the_commands_missed_since_a_version)
+{
+    config_change_log_s log(8);
+
+    const auto added = log.append(web_message::add_node_command_s{.node = {.type = "ndi_input", .id = "input-1"}});
+    EXPECT_EQ(added["version"], 1);
+    EXPECT_EQ(added["topic"], "add_node");
+
+    log.append(web_message::update_node_command_s{.id = "input-1", .options = {{"name", "Camera"}}});
+    log.append(web_message::remove_node_command_s{.id = "input-1"});
+    EXPECT_EQ(log.version(), 3);
+
+    const auto changes = log.changes_since(1, 1);
+    ASSERT_TRUE(changes.has_value());
+    EXPECT_EQ(changes->version, 3);
+    ASSERT_EQ(changes->commands.size(), 2);
+    EXPECT_EQ(changes->commands[0]["topic"], "update_node");
+    EXPECT_EQ(changes->commands[0]["version"], 2);
+    EXPECT_EQ(changes->commands[1]["topic"], "remove_node");
+
+    const auto current = log.changes_since(3, 3);
+    ASSERT_TRUE(current.has_value());
+    EXPECT_TRUE(current->commands.empty());
+    EXPECT_TRUE(current->status_ids.empty());
+}
+
+TEST(config_change_log, requires_a_snapshot_once_missed_commands_are_truncated)
+{
+    config_change_log_s log(2);
+    for (int i = 0; i < 3; ++i) {
+        log.append(web_message::remove_node_command_s{.id = std::to_string(i)});
+    }
+
+    EXPECT_FALSE(log.changes_since(0, 0).has_value());
+
+    const auto changes = log.changes_since(1, 1);
+    ASSERT_TRUE(changes.has_value());
+    EXPECT_EQ(changes->commands.size(), 2);
+
+    // Versions from the future belong to another run of the server
+    EXPECT_FALSE(log.changes_since(4, 0).has_value());
+    EXPECT_FALSE(log.changes_since(3, 4).has_value());
+}
+
+TEST(config_change_log, status_changes_share_the_version_sequence)
+{
+    config_change_log_s log(8);
+
+    const auto first = log.append_statuses({{"a", {{"connected", true}}}, {"b", {{"connected", false}}}});
+    log.append(web_message::remove_node_command_s{.id = "a"});
+    log.remove_node_status("a");
+    const auto second = log.append_statuses({{"c", {{"connected", true}}}});
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 3);
+
+    const auto changes = log.changes_since(first, first);
+    ASSERT_TRUE(changes.has_value());
+    ASSERT_EQ(changes->commands.size(), 1);
+    EXPECT_EQ(changes->status_ids, std::vector<std::string>{"c"});
+
+    // Status frames may lag behind commands for rate limited clients
+    const auto lagging = log.changes_since(second, 0);
+    ASSERT_TRUE(lagging.has_value());
+    EXPECT_TRUE(lagging->commands.empty());
+    EXPECT_EQ(lagging->status_ids.size(), 2);
+}
+
+} // namespace miximus::core::tests
@@ -0,0 +1,92 @@
+#include "core/adapters/adapter_autosave.hpp"
+#include "core/configuration.hpp"
+#include "core/node_manager.hpp"
+#include "core/node_status_registry.hpp"
+#include "nodes/system/register.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace miximus::core::tests {
+namespace {
+
+class configuration_autosave_test : public ::testing::Test
+{
+  protected:
+    std::filesystem::path directory_;
+    std::filesystem::path path_;
+
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path() /
+                     ("miximus_autosave_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(directory_);
+        path_ = directory_ / "settings.json";
+    }
+
+    void TearDown() override
+    {
+        std::error_code ignored;
+        std::filesystem::remove_all(directory_, ignored);
+    }
+
+    nlohmann::json read_settings() const
+    {
+        std::ifstream file(path_, std::ios::binary);
+        return nlohmann::json::parse(file, nullptr, false);
+    }
+};
+
+} // namespace
+
+TEST_F(configuration_autosave_test, save_replaces_the_file_without_leaving_a_temporary)
+{
+    node_manager_s  manager;
+    configuration_s configuration(manager);
+
+    {
+        std::ofstream file(path_);
+        file << "previous";
+    }
+
+    const auto bytes = configuration.save_file(path_);
+
+    EXPECT_EQ(bytes, std::filesystem::file_size(path_));
+    EXPECT_EQ(read_settings(), configuration.get_config());
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory_), std::filesystem::directory_iterator()),
+              1);
+}
+
+TEST_F(configuration_autosave_test, writes_changes_in_the_background)
+{
+    node_manager_s         manager;
+    configuration_s        configuration(manager);
+    node_status_registry_s status_registry;
+
+    manager.add_adapter(create_autosave_adapter(configuration, path_, std::chrono::milliseconds(10), &status_registry));
+    ASSERT_EQ(manager.handle_add_node("lerp_f64", "a", nlohmann::json::object()), error_e::no_error);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (status_registry.get(nodes::system::SETTINGS_NODE_ID).value("autosave_count", uint64_t{0}) == 0 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    manager.clear_adapters();
+
+    const auto status = status_registry.get(nodes::system::SETTINGS_NODE_ID);
+    EXPECT_GE(status.value("autosave_count", uint64_t{0}), 1U);
+    EXPECT_EQ(status.value("autosave_failures", uint64_t{0}), 0U);
+    EXPECT_EQ(status.value("autosave_bytes", uintmax_t{0}), std::filesystem::file_size(path_));
+    EXPECT_EQ(read_settings(), configuration.get_config());
+}
+
+} // namespace miximus::core::tests
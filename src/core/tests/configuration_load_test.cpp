@@ -0,0 +1,114 @@
+#include "core/configuration.hpp"
+#include "core/node_manager.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+namespace miximus::core::tests {
+namespace {
+
+nlohmann::json lerp_node(const std::string& id)
+{
+    return {
+        {"type",    "lerp_f64"             },
+        {"id",      id                     },
+        {"options", nlohmann::json::object()},
+    };
+}
+
+nlohmann::json connection(const std::string& from_node, const std::string& to_node, const std::string& to_interface)
+{
+    return {
+        {"from_node",      from_node   },
+        {"from_interface", "res"       },
+        {"to_node",        to_node     },
+        {"to_interface",   to_interface},
+    };
+}
+
+} // namespace
+
+TEST(configuration_load, bulk_loads_nodes_and_connections)
+{
+    node_manager_s  manager;
+    configuration_s configuration(manager);
+
+    // The second connection to the same input displaces the first, as it would
+    // when connections are added one at a time
+    configuration.load({
+        {"schema_version", 1},
+        {"nodes", {lerp_node("a"), lerp_node("b"), lerp_node("c")}},
+        {"connections",
+         {connection("a", "b", "a"), connection("a", "c", "t"), connection("b", "c", "t"), connection("a", "b", "b")}},
+    });
+
+    const auto config = configuration.get_config();
+    EXPECT_EQ(config["nodes"].size(), 4); // Including the application settings node
+    EXPECT_EQ(config["connections"].size(), 3);
+    EXPECT_TRUE(configuration.get_node("b").has_value());
+
+    const auto& connections = config["connections"];
+    EXPECT_EQ(std::count(connections.begin(), connections.end(), connection("a", "c", "t")), 0);
+    EXPECT_EQ(std::count(connections.begin(), connections.end(), connection("b", "c", "t")), 1);
+}
+
+TEST(configuration_load, rejects_circular_connections_without_applying_anything)
+{
+    node_manager_s  manager;
+    configuration_s configuration(manager);
+
+    EXPECT_THROW(configuration.load({
+                     {"schema_version", 1},
+                     {"nodes", {lerp_node("a"), lerp_node("b")}},
+                     {"connections", {connection("a", "b", "a"), connection("b", "a", "a")}},
+                 }),
+                 std::runtime_error);
+
+    EXPECT_EQ(configuration.get_config()["nodes"].size(), 1);
+    EXPECT_FALSE(configuration.get_node("a").has_value());
+}
+
+TEST(configuration_load, keeps_the_settings_when_the_graph_fails_to_load)
+{
+    node_manager_s  manager;
+    configuration_s configuration(manager);
+    const auto      settings = configuration.get_node("$app")->at("options");
+
+    EXPECT_THROW(configuration.load({
+                     {"schema_version", 1},
+                     {"nodes",
+                      {{{"type", "application_settings"}, {"id", "$app"}, {"options", {{"gpu_memory_budget_mb", 512}}}},
+                       lerp_node("a"),
+                       lerp_node("b")}},
+                     {"connections", {connection("a", "b", "a"), connection("b", "a", "a")}},
+                 }),
+                 std::runtime_error);
+
+    EXPECT_EQ(configuration.get_node("$app")->at("options"), settings);
+}
+
+TEST(configuration_load, reports_the_first_invalid_node)
+{
+    node_manager_s  manager;
+    configuration_s configuration(manager);
+
+    try {
+        configuration.load({
+            {"schema_version", 1},
+            {"nodes",
+             {lerp_node("a"),
+              {{"type", "no_such_type"}, {"id", "first"}, {"options", nlohmann::json::object()}},
+              {{"type", "no_such_type"}, {"id", "second"}, {"options", nlohmann::json::object()}}}},
+            {"connections", nlohmann::json::array()},
+        });
+        FAIL() << "Loading an unknown node type succeeded";
+    } catch (const std::runtime_error& error) {
+        EXPECT_EQ(std::string(error.what()), "Node first has unknown type no_such_type");
+    }
+}
+
+} // namespace miximus::core::tests
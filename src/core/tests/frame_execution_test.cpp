@@ -1,6 +1,9 @@
 #include "core/app_state.hpp"
+#include "gpu/context.hpp"
+#include "gpu/framebuffer.hpp"
 #include "nodes/composite/register.hpp"
 #include "nodes/frame_execution.hpp"
+#include "nodes/framebuffer_pool.hpp"
 #include "nodes/interface.hpp"
 #include "nodes/node.hpp"
 #include "nodes/node_map.hpp"
@@ -8,8 +11,11 @@
 #include "nodes/switch/register.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <exception>
 #include <gtest/gtest.h>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -20,12 +26,16 @@ using namespace miximus;
 
 class test_node_s final : public nodes::node_i
 {
-    std::string                       type_;
-    std::vector<std::string>*         events_{};
-    bool                              demands_execution_{};
-    nodes::input_interface_s<double>  source_{*this, "source"};
-    nodes::input_interface_s<double>  input_{*this, "input"};
-    nodes::output_interface_s<double> output_{*this, "out"};
+    std::string                                    type_;
+    std::vector<std::string>*                      events_{};
+    bool                                           demands_execution_{};
+    std::optional<uint64_t>                        content_version_;
+    bool                                           retains_outputs_{true};
+    nodes::input_interface_s<double>               source_{*this, "source"};
+    nodes::input_interface_s<double>               input_{*this, "input"};
+    nodes::input_interface_s<gpu::framebuffer_s*>  fb_in_{*this, "fb_in"};
+    nodes::output_interface_s<double>              output_{*this, "out"};
+    nodes::output_interface_s<gpu::framebuffer_s*> fb_out_{*this, "fb_out"};
 
     void record(std::string_view phase) const { events_->emplace_back(std::string(phase) + ":" + type_); }
 
@@ -46,10 +56,21 @@ class test_node_s final : public nodes::node_i
 
     std::string_view type() const final { return type_; }
 
+    void set_demands_execution(bool demands) { demands_execution_ = demands; }
+    void set_content_version(std::optional<uint64_t> version) { content_version_ = version; }
+    void set_retains_outputs(bool retains) { retains_outputs_ = retains; }
+
     void prepare(core::app_state_s* /*app*/, const nodes::node_state_s& /*state*/, prepare_result_s* result) final
     {
         record("prepare");
         result->demands_execution = demands_execution_;
+        result->content_version   = content_version_;
+    }
+
+    bool retain_outputs(core::app_state_s* /*app*/) final
+    {
+        record("retain");
+        return retains_outputs_;
     }
 
     void submit(core::app_state_s* app, const nodes::node_map_t& nodes, const nodes::node_state_s& state) final
@@ -65,8 +86,14 @@ class test_node_s final : public nodes::node_i
     {
         (void)source_.resolve_value(app, nodes, state);
         (void)input_.resolve_value(app, nodes, state);
+        if (!fb_in_.connections(state).empty()) {
+            fb_out_.set_value(fb_in_.resolve_value(app, nodes, state));
+        }
         output_.set_value(1.0);
         record("execute");
+        if (app->frame_info.finished_nodes.contains(type_)) {
+            record("finished_early");
+        }
     }
 
     void complete(core::app_state_s* /*app*/) final { record("complete"); }
@@ -121,6 +148,36 @@ void connect(nodes::node_map_t* nodes, std::string_view from, std::string_view t
     node->second.state.con_map[input_name].emplace_back(std::move(connection));
 }
 
+// Framebuffer connections are stored on both nodes, as the node manager does
+void connect_framebuffer(nodes::node_map_t* nodes, std::string_view from, std::string_view to)
+{
+    const connection_s connection{
+        .from_node      = std::string(from),
+        .from_interface = "fb_out",
+        .to_node        = std::string(to),
+        .to_interface   = "fb_in",
+    };
+    nodes->at(std::string(from)).state.con_map["fb_out"].emplace_back(connection);
+    nodes->at(std::string(to)).state.con_map["fb_in"].emplace_back(connection);
+}
+
+test_node_s& test_node(nodes::node_map_t* nodes, std::string_view id)
+{
+    return static_cast<test_node_s&>(*nodes->at(std::string(id)).node);
+}
+
+void run_frame(core::app_state_s* app, nodes::node_map_t* nodes)
+{
+    const auto demanding_nodes = nodes::prepare_all_nodes(app, *nodes);
+    nodes::select_reused_nodes(app, *nodes);
+    app->frame_info.submitted_nodes.clear();
+    nodes::submit_demanding_nodes(app, *nodes, demanding_nodes);
+    app->frame_info.executed_nodes.clear();
+    app->frame_info.finished_nodes.clear();
+    nodes::execute_demanding_nodes(app, *nodes, demanding_nodes);
+    nodes::complete_all_nodes(app, *nodes);
+}
+
 size_t count_event(const std::vector<std::string>& events, std::string_view event)
 {
     return static_cast<size_t>(std::ranges::count(events, event));
@@ -189,6 +246,25 @@ TEST(FrameExecution, ExecuteOnceSuppressesSharedAndRepeatedRequests)
     EXPECT_EQ(count_event(events, "execute:shared"), 1);
 }
 
+TEST(FrameExecution, NodesAreFinishedOnlyAfterTheirExecuteReturns)
+{
+    std::vector<std::string> events;
+    nodes::node_map_t        graph;
+    core::app_state_s        app(core::app_state_s::test_state_t{});
+    add_node(&graph, "source", &events);
+    add_node(&graph, "sink", &events);
+    add_node(&graph, "inactive", &events);
+    connect(&graph, "source", "sink", "input");
+
+    ASSERT_TRUE(nodes::execute_node_once(&app, graph, "sink"));
+    EXPECT_EQ(app.frame_info.finished_nodes, app.frame_info.executed_nodes);
+    EXPECT_TRUE(app.frame_info.finished_nodes.contains("source"));
+    EXPECT_TRUE(app.frame_info.finished_nodes.contains("sink"));
+    EXPECT_FALSE(app.frame_info.finished_nodes.contains("inactive"));
+    EXPECT_EQ(count_event(events, "finished_early:source"), 0);
+    EXPECT_EQ(count_event(events, "finished_early:sink"), 0);
+}
+
 TEST(FrameExecution, SubmitOnceSuppressesSharedAndRepeatedRequests)
 {
     std::vector<std::string> events;
@@ -263,4 +339,162 @@ TEST(FrameExecution, MixSubmissionUsesOptionRouteOrBothConnectedControlRoutes)
     }
 }
 
+TEST(FrameExecution, UnchangedNodesKeepTheirOutputsUntilAVersionChanges)
+{
+    std::vector<std::string> events;
+    nodes::node_map_t        graph;
+    core::app_state_s        app(core::app_state_s::test_state_t{});
+    add_node(&graph, "source", &events);
+    add_node(&graph, "sink", &events, true);
+    connect(&graph, "source", "sink", "input");
+    test_node(&graph, "source").set_content_version(0);
+    test_node(&graph, "sink").set_content_version(0);
+
+    run_frame(&app, &graph);
+    run_frame(&app, &graph);
+    run_frame(&app, &graph);
+    EXPECT_EQ(count_event(events, "execute:source"), 1);
+    EXPECT_EQ(count_event(events, "execute:sink"), 1);
+    EXPECT_EQ(count_event(events, "submit:sink"), 1);
+    EXPECT_EQ(app.frame_info.reused_nodes.size(), 2);
+    EXPECT_TRUE(app.frame_info.executed_nodes.empty());
+
+    test_node(&graph, "source").set_content_version(1);
+    run_frame(&app, &graph);
+    EXPECT_EQ(count_event(events, "execute:source"), 2);
+    EXPECT_EQ(count_event(events, "execute:sink"), 2);
+    EXPECT_TRUE(app.frame_info.reused_nodes.empty());
+}
+
+TEST(FrameExecution, NodesWithoutVersionExecuteTheirDependentsEveryFrame)
+{
+    std::vector<std::string> events;
+    nodes::node_map_t        graph;
+    core::app_state_s        app(core::app_state_s::test_state_t{});
+    add_node(&graph, "live", &events);
+    add_node(&graph, "static", &events);
+    add_node(&graph, "sink", &events, true);
+    connect(&graph, "live", "sink", "input");
+    connect(&graph, "static", "sink", "source");
+    test_node(&graph, "static").set_content_version(0);
+    test_node(&graph, "sink").set_content_version(0);
+
+    run_frame(&app, &graph);
+    run_frame(&app, &graph);
+    EXPECT_EQ(count_event(events, "execute:live"), 2);
+    EXPECT_EQ(count_event(events, "execute:sink"), 2);
+    EXPECT_EQ(count_event(events, "execute:static"), 1);
+    EXPECT_TRUE(app.frame_info.reused_nodes.contains("static"));
+}
+
+TEST(FrameExecution, NodesMissingAFrameExecuteBeforeBeingReused)
+{
+    std::vector<std::string> events;
+    nodes::node_map_t        graph;
+    core::app_state_s        app(core::app_state_s::test_state_t{});
+    add_node(&graph, "source", &events);
+    add_node(&graph, "monitor", &events, true);
+    add_node(&graph, "sink", &events, true);
+    connect(&graph, "source", "monitor", "input");
+    connect(&graph, "source", "sink", "input");
+    for (const auto id : {"source", "monitor", "sink"}) {
+        test_node(&graph, id).set_content_version(0);
+    }
+
+    run_frame(&app, &graph);
+    EXPECT_EQ(count_event(events, "execute:sink"), 1);
+
+    // The source changes while the sink is not demanded
+    test_node(&graph, "sink").set_demands_execution(false);
+    test_node(&graph, "source").set_content_version(1);
+    run_frame(&app, &graph);
+    EXPECT_EQ(count_event(events, "execute:source"), 2);
+    EXPECT_EQ(count_event(events, "execute:sink"), 1);
+
+    test_node(&graph, "sink").set_demands_execution(true);
+    run_frame(&app, &graph);
+    EXPECT_TRUE(app.frame_info.reused_nodes.contains("source"));
+    EXPECT_EQ(count_event(events, "execute:sink"), 2);
+}
+
+TEST(FrameExecution, FramebufferChainsAreReusedAsAWhole)
+{
+    std::vector<std::string> events;
+    nodes::node_map_t        graph;
+    core::app_state_s        app(core::app_state_s::test_state_t{});
+    add_node(&graph, "framebuffer", &events);
+    add_node(&graph, "background", &events);
+    add_node(&graph, "overlay", &events);
+    add_node(&graph, "live", &events);
+    add_node(&graph, "sink", &events, true);
+    connect_framebuffer(&graph, "framebuffer", "background");
+    connect_framebuffer(&graph, "background", "overlay");
+    connect(&graph, "overlay", "sink", "input");
+    for (const auto id : {"framebuffer", "background", "overlay", "sink"}) {
+        test_node(&graph, id).set_content_version(0);
+    }
+
+    run_frame(&app, &graph);
+    run_frame(&app, &graph);
+    EXPECT_EQ(count_event(events, "execute:framebuffer"), 1);
+    EXPECT_EQ(count_event(events, "retain:framebuffer"), 1);
+
+    // The overlay has to be drawn again, so the target is cleared and redrawn from the start
+    connect(&graph, "live", "overlay", "input");
+    run_frame(&app, &graph);
+    EXPECT_EQ(count_event(events, "execute:framebuffer"), 2);
+    EXPECT_EQ(count_event(events, "execute:background"), 2);
+    EXPECT_EQ(count_event(events, "execute:overlay"), 2);
+    EXPECT_EQ(count_event(events, "retain:framebuffer"), 1);
+}
+
+TEST(FrameExecution, RefusedOutputsExecuteTheNodeAndItsDependents)
+{
+    std::vector<std::string> events;
+    nodes::node_map_t        graph;
+    core::app_state_s        app(core::app_state_s::test_state_t{});
+    add_node(&graph, "source", &events);
+    add_node(&graph, "sink", &events, true);
+    connect(&graph, "source", "sink", "input");
+    test_node(&graph, "source").set_content_version(0);
+    test_node(&graph, "sink").set_content_version(0);
+
+    run_frame(&app, &graph);
+    test_node(&graph, "source").set_retains_outputs(false);
+    run_frame(&app, &graph);
+    EXPECT_EQ(count_event(events, "retain:source"), 1);
+    EXPECT_EQ(count_event(events, "execute:source"), 2);
+    EXPECT_EQ(count_event(events, "execute:sink"), 2);
+    EXPECT_TRUE(app.frame_info.reused_nodes.empty());
+}
+
+TEST(FrameExecution, RetainRefusesTheTargetOfAnOwnerThatChangedSizeOnceReleased)
+{
+    std::unique_ptr<gpu::context_s> context;
+    try {
+        context = gpu::context_s::create_unique_context();
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "No GL context: " << e.what();
+    }
+    const gpu::context_scope_s context_scope(*context);
+
+    nodes::node_map_t graph;
+    core::app_state_s app(core::app_state_s::test_state_t{});
+    auto*             pool = app.framebuffer_pool();
+
+    (void)pool->acquire(app, graph, "framebuffer", {.dimensions = {256, 256}});
+    pool->end_frame();
+
+    // The node changes size, its old target still carries its name
+    auto* resized = pool->acquire(app, graph, "framebuffer", {.dimensions = {512, 512}});
+    app.frame_info.finished_nodes.emplace("framebuffer");
+    auto* other = pool->acquire(app, graph, "other", {.dimensions = {512, 512}});
+    ASSERT_EQ(other, resized);
+    pool->end_frame();
+
+    EXPECT_FALSE(pool->retain("framebuffer", resized));
+    EXPECT_TRUE(pool->retain("other", other));
+    pool->end_frame();
+}
+
 } // namespace
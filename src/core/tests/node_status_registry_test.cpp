@@ -3,6 +3,9 @@
 
 #include <chrono>
 #include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace miximus::core::tests {
 
@@ -28,6 +31,9 @@ TEST(node_status_registry, described_status_is_serialized_and_delta_filtered)
                   {"source_queue_discontinuities",         0      },
                   {"source_queue_transfer_failures",       0      },
                   {"source_queue_transfer_cancellations",  0      },
+                  {"source_frame_records",                 0      },
+                  {"source_frame_records_reused",          0      },
+                  {"source_frame_record_allocations",      0      },
                   {"source_recovered_rate",                59.94  },
                   {"source_observed_rate",                 nullptr},
                   {"source_phase_offset_us",               125    },
@@ -39,14 +45,14 @@ TEST(node_status_registry, described_status_is_serialized_and_delta_filtered)
 
     auto updates = registry.flush();
     ASSERT_EQ(updates.size(), 1);
-    EXPECT_EQ(updates.front().status, registry.get("decklink"));
+    EXPECT_EQ(updates["decklink"], registry.get("decklink"));
 
     source_status.source_queue_pushed = 2;
     registry.write("decklink", source_status);
 
     updates = registry.flush();
     ASSERT_EQ(updates.size(), 1);
-    EXPECT_EQ(updates.front().status,
+    EXPECT_EQ(updates["decklink"],
               nlohmann::json({
                   {"source_queue_pushed", 2},
     }));
@@ -72,4 +78,55 @@ TEST(node_status_registry, typed_status_groups_are_merged_into_node_status)
     ASSERT_EQ(registry.flush().size(), 1);
 }
 
+TEST(node_status_registry, flush_batches_every_node_delta_of_a_tick)
+{
+    node_status_registry_s registry;
+    registry.write("input", status::connected_status_s{.connected = true});
+    registry.write("output", status::connected_status_s{.connected = false});
+    registry.write("input", status::connected_status_s{.connected = false});
+    registry.write("removed", status::connected_status_s{.connected = true});
+    registry.remove_node("removed");
+
+    EXPECT_EQ(registry.flush(),
+              nlohmann::json({
+                  {"input",  {{"connected", false}}},
+                  {"output", {{"connected", false}}},
+    }));
+    EXPECT_TRUE(registry.flush().empty());
+}
+
+TEST(node_status_registry, concurrent_writers_flush_their_latest_values)
+{
+    constexpr uint64_t WRITES_PER_THREAD = 10'000;
+
+    node_status_registry_s   registry;
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 4; ++i) {
+        writers.emplace_back([&registry, id = "source" + std::to_string(i)] {
+            status::source_timing_status_s source_status;
+            for (uint64_t frame = 1; frame <= WRITES_PER_THREAD; ++frame) {
+                source_status.source_queue_pushed = frame;
+                registry.write(id, source_status);
+            }
+        });
+    }
+
+    // Flushing while the writers run must only ever publish whole values
+    for (int i = 0; i < 100; ++i) {
+        const auto updates = registry.flush();
+        for (const auto& [id, delta] : updates.items()) {
+            EXPECT_TRUE(delta.contains("source_queue_pushed")) << id;
+        }
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    registry.flush();
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(registry.get("source" + std::to_string(i))["source_queue_pushed"], WRITES_PER_THREAD);
+    }
+    EXPECT_TRUE(registry.flush().empty());
+}
+
 } // namespace miximus::core::tests
@@ -93,6 +93,7 @@ TEST(SettingsNode, ProvidesTheDefaultSettings)
     EXPECT_EQ(defaults.at("ndi_output_buffer_frames").get<int>(), ndi_output_buffer_limits_s::DEFAULT_FRAME_COUNT);
     EXPECT_EQ(defaults.at("screen_output_buffer_frames").get<int>(),
               screen_output_buffer_limits_s::DEFAULT_FRAME_COUNT);
+    EXPECT_EQ(defaults.at("gpu_memory_budget_mb").get<int>(), 0);
 }
 
 TEST(SettingsNode, CorrectsDefaultFramebufferSize)
@@ -180,6 +181,30 @@ TEST(SettingsNode, CorrectsScreenOutputBufferSettings)
     EXPECT_EQ(state.at("screen_output_buffer_frames").get<int>(), screen_output_buffer_limits_s::MINIMUM_FRAME_COUNT);
 }
 
+TEST(SettingsNode, CorrectsGpuMemoryBudget)
+{
+    using gpu_memory_settings_s = core::app_state_s::frame_settings_s::gpu_memory_settings_s;
+
+    const auto           settings = create_settings_node();
+    auto                 state    = settings->get_default_options();
+    const nlohmann::json update{
+        {"gpu_memory_budget_mb", 10'000'000}
+    };
+    const auto result = settings->set_options(state, update);
+
+    EXPECT_EQ(result.error, error_e::no_error);
+    EXPECT_TRUE(result.has_corrected_values);
+    EXPECT_EQ(state.at("gpu_memory_budget_mb").get<int>(), gpu_memory_settings_s::MAX_BUDGET_MB);
+
+    const auto minimum_result = settings->set_options(state,
+                                                      {
+                                                          {"gpu_memory_budget_mb", -1}
+    });
+    EXPECT_EQ(minimum_result.error, error_e::no_error);
+    EXPECT_TRUE(minimum_result.has_corrected_values);
+    EXPECT_EQ(state.at("gpu_memory_budget_mb").get<int>(), 0);
+}
+
 TEST(SettingsNode, ReportsAndStoresCanonicalCorrections)
 {
     const auto           settings = create_settings_node();
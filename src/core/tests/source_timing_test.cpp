@@ -1,14 +1,21 @@
 #include "media/media_clock.hpp"
+#include "media/rate_regression.hpp"
+#include "media/source_sync_group.hpp"
 #include "media/timed_source_queue.hpp"
 #include "utils/flicks.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <deque>
 #include <future>
 #include <gtest/gtest.h>
 #include <optional>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace {
 using namespace miximus;
@@ -158,6 +165,135 @@ TEST(MediaToProgramClock, ChangesRecoveredRateWithoutMovingTheCurrentPhase)
               current_source_pts + FRAME_DURATION + DRIFT_PER_FRAME);
 }
 
+// The long double block fit the clock used before rate_regression_s; kept as
+// the reference for accuracy and throughput.
+struct long_double_rate_fit_s
+{
+    long double media_sum{};
+    long double program_sum{};
+    long double media_squared_sum{};
+    long double media_program_sum{};
+    size_t      count{};
+
+    void add(double media, double program)
+    {
+        const auto x = static_cast<long double>(media);
+        const auto y = static_cast<long double>(program);
+        media_sum += x;
+        program_sum += y;
+        media_squared_sum += x * x;
+        media_program_sum += x * y;
+        ++count;
+    }
+
+    std::optional<double> slope() const
+    {
+        const auto n = static_cast<long double>(count);
+        return static_cast<double>(((n * media_program_sum) - (media_sum * program_sum)) /
+                                   ((n * media_squared_sum) - (media_sum * media_sum)));
+    }
+};
+
+// Offsets from a block reference with ~40 ppm drift and callback jitter.
+std::pair<double, double> rate_observation(uint64_t frame)
+{
+    const auto media   = static_cast<double>(FRAME_DURATION.count()) * static_cast<double>(frame);
+    const auto jitter  = static_cast<double>(((frame * 7'919) % 2'001)) - 1'000.0;
+    const auto program = std::round((media * 1.00004) + (jitter * 3'000.0));
+    return {media, program};
+}
+
+TEST(RateRegression, MatchesTheExtendedPrecisionBlockFit)
+{
+    media::rate_regression_s regression;
+    long_double_rate_fit_s   reference;
+    EXPECT_FALSE(regression.slope().has_value());
+
+    for (uint64_t frame = 1; frame <= 600; ++frame) {
+        const auto [media, program] = rate_observation(frame);
+        regression.add(media, program);
+        reference.add(media, program);
+    }
+
+    EXPECT_EQ(regression.size(), 600);
+    EXPECT_NEAR(require_value(regression.slope()), require_value(reference.slope()), 1e-13);
+    EXPECT_NEAR(require_value(regression.slope()), 1.00004, 1e-5);
+}
+
+TEST(RateRegression, SlidingWindowMatchesAFreshFitAfterManyRemovals)
+{
+    constexpr size_t WINDOW = 600;
+
+    media::rate_regression_s              regression;
+    std::deque<std::pair<double, double>> window;
+    for (uint64_t frame = 1; frame <= 100'000; ++frame) {
+        const auto observation = rate_observation(frame);
+        regression.add(observation.first, observation.second);
+        window.push_back(observation);
+        if (window.size() > WINDOW) {
+            regression.remove(window.front().first, window.front().second);
+            window.pop_front();
+        }
+    }
+
+    long_double_rate_fit_s reference;
+    for (const auto& [media, program] : window) {
+        reference.add(media, program);
+    }
+    EXPECT_EQ(regression.size(), WINDOW);
+    EXPECT_NEAR(require_value(regression.slope()), require_value(reference.slope()), 1e-12);
+}
+
+TEST(MediaToProgramClock, ObservedRateMatchesTheExtendedPrecisionBlockFit)
+{
+    media::media_to_program_clock_s clock;
+    long_double_rate_fit_s          reference;
+    ASSERT_EQ(clock.observe(make_media_clock_sample(1, {}), {}), media::media_clock_observation_e::initialized);
+    for (uint64_t frame = 1; frame <= 600; ++frame) {
+        const auto [media, program] = rate_observation(frame);
+        reference.add(media, program);
+        ASSERT_EQ(clock.observe(make_media_clock_sample(frame + 1, FRAME_DURATION * static_cast<int64_t>(frame)),
+                                utils::flicks{static_cast<utils::flicks::rep>(program)}),
+                  media::media_clock_observation_e::updated);
+    }
+
+    EXPECT_NEAR(require_value(clock.observed_rate()), require_value(reference.slope()), 1e-13);
+    EXPECT_NEAR(require_value(clock.recovered_rate()), require_value(reference.slope()), 1e-13);
+}
+
+TEST(RateRegression, ThroughputAgainstTheExtendedPrecisionFit)
+{
+    constexpr uint64_t OBSERVATIONS = 2'000'000;
+    constexpr uint64_t BLOCK        = 600;
+
+    std::vector<std::pair<double, double>> observations;
+    observations.reserve(BLOCK);
+    for (uint64_t frame = 1; frame <= BLOCK; ++frame) {
+        observations.push_back(rate_observation(frame));
+    }
+
+    const auto measure = [&](auto fit) {
+        double     slope_sum{};
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < OBSERVATIONS; ++i) {
+            const auto& [media, program] = observations[i % BLOCK];
+            fit.add(media, program);
+            if (i % BLOCK == BLOCK - 1) {
+                slope_sum += require_value(fit.slope());
+                fit = {};
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::pair(slope_sum, std::chrono::duration<double, std::nano>(elapsed).count() / OBSERVATIONS);
+    };
+
+    const auto [double_slopes, double_ns]       = measure(media::rate_regression_s{});
+    const auto [reference_slopes, reference_ns] = measure(long_double_rate_fit_s{});
+    RecordProperty("double_ns_per_observation", std::to_string(double_ns));
+    RecordProperty("long_double_ns_per_observation", std::to_string(reference_ns));
+    EXPECT_NEAR(double_slopes, reference_slopes, 1e-9);
+}
+
 TEST(TimedSourceQueue, SelectsNewestEligibleFrameAndThenRepeatsIt)
 {
     media::timed_source_queue_s<int> queue;
@@ -629,4 +765,191 @@ TEST(TimedSourceQueue, RepeatsDeterministicallyWhenTheSourceRateIsLower)
 
     EXPECT_EQ(queue.metrics().repeated, 4);
 }
+
+TEST(TimedSourceQueue, ConcurrentCaptureAndRenderThreadsNeverLoseFrames)
+{
+    constexpr size_t FRAME_COUNT   = 20'000;
+    constexpr auto   TARGET_TIME   = utils::to_flicks(100.0);
+    constexpr auto   SOURCE_ORIGIN = utils::to_flicks(40.0);
+
+    using queue_t = media::timed_source_queue_s<int>;
+
+    queue_t                           queue({.capacity = 4});
+    std::vector<queue_t::frame_ptr_t> frames(FRAME_COUNT);
+    std::atomic_bool                  producer_done;
+
+    std::thread producer([&] {
+        for (size_t i = 0; i < FRAME_COUNT; ++i) {
+            const auto offset = FRAME_DURATION * static_cast<utils::flicks::rep>(i);
+            frames[i]         = queue.create_frame(
+                make_media_clock_sample(i + 1, SOURCE_ORIGIN + offset), TARGET_TIME + offset, static_cast<int>(i));
+            queue.push(frames[i]);
+            if (i % 64 == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer_done = true;
+    });
+
+    size_t committed{};
+    int    last_payload = -1;
+    for (size_t program_frame = 0;; ++program_frame) {
+        const bool done        = producer_done.load();
+        const auto program_pts = FRAME_DURATION * static_cast<utils::flicks::rep>(program_frame);
+        queue.advance(program_pts, TARGET_TIME + program_pts);
+        // Generous tolerance keeps the render side selecting while the two
+        // threads run at unrelated rates.
+        const auto ticket = queue.select(program_pts, utils::to_flicks(1'000.0));
+        if (ticket.selection() == media::prepared_frame_selection_e::new_frame) {
+            ASSERT_TRUE(ticket.frame()->mark_submitted());
+            ASSERT_TRUE(ticket.frame()->mark_ready());
+            ASSERT_TRUE(queue.commit(ticket));
+            ASSERT_GT(ticket.frame()->payload(), last_payload);
+            last_payload = ticket.frame()->payload();
+            ++committed;
+        }
+        // Simulate graph reloads racing the capture callback.
+        if (program_frame % 997 == 0) {
+            queue.reset();
+        }
+        if (done) {
+            break;
+        }
+    }
+    producer.join();
+    queue.reset();
+
+    size_t ready{};
+    for (const auto& frame : frames) {
+        const auto readiness = frame->readiness();
+        // A frame lost inside the handoff would never leave the reserved state.
+        ASSERT_NE(readiness, media::source_frame_readiness_e::reserved);
+        if (readiness == media::source_frame_readiness_e::ready) {
+            ++ready;
+        }
+    }
+    EXPECT_EQ(ready, committed);
+    EXPECT_GT(committed, 0);
+    EXPECT_EQ(queue.metrics().pushed, FRAME_COUNT);
+    EXPECT_EQ(queue.metrics().queued, 0);
+}
+
+TEST(TimedSourceQueue, RecyclesFrameRecordsAndFallsBackToTheHeapWhenExhausted)
+{
+    media::timed_source_queue_s<int>::frame_ptr_t retained;
+    {
+        media::timed_source_queue_s<int> queue({.capacity = 2});
+        const auto                       records = queue.metrics().frame_records.records;
+        ASSERT_GT(records, 2);
+
+        for (int i = 0; i < 100; ++i) {
+            (void)queue.create_frame(make_media_clock_sample(1, {}), {}, i);
+        }
+        // Released records go back on top of the free list, so one record serves every frame
+        EXPECT_EQ(queue.metrics().frame_records.reused, 99);
+        EXPECT_EQ(queue.metrics().frame_records.allocations, 0);
+
+        std::vector<media::timed_source_queue_s<int>::frame_ptr_t> held;
+        for (size_t i = 0; i <= records; ++i) {
+            held.push_back(queue.create_frame(make_media_clock_sample(1, {}), {}, static_cast<int>(i)));
+        }
+        EXPECT_EQ(queue.metrics().frame_records.allocations, 1);
+        retained = held.front();
+    }
+
+    // A record held past the queue keeps its pool, and its payload, alive.
+    EXPECT_EQ(retained->payload(), 0);
+}
+
+TEST(SourceSyncGroup, MembersSelectFramesFromTheSameInstantWhenOneArrivesLate)
+{
+    constexpr auto TARGET_TIME = utils::to_flicks(100.0);
+    constexpr auto ORIGIN_A    = utils::to_flicks(40.0);
+    constexpr auto ORIGIN_B    = utils::to_flicks(7.0);
+    constexpr auto TOLERANCE   = FRAME_DURATION / 2;
+
+    media::source_sync_registry_s    registry;
+    media::timed_source_queue_s<int> queue_a;
+    media::timed_source_queue_s<int> queue_b;
+
+    const auto push = [&](media::timed_source_queue_s<int>& queue, utils::flicks origin, int frame) {
+        const auto offset = FRAME_DURATION * frame;
+        queue.push(queue.create_frame(make_media_clock_sample(static_cast<uint64_t>(frame) + 1, origin + offset),
+                                      TARGET_TIME + offset,
+                                      frame));
+    };
+    const auto present = [&](media::timed_source_queue_s<int>& queue, utils::flicks program_pts) {
+        const auto ticket = queue.select(registry.selection_pts("cameras", program_pts), TOLERANCE);
+        if (ticket.frame() == nullptr) {
+            return -1;
+        }
+        if (ticket.selection() == media::prepared_frame_selection_e::new_frame) {
+            registry.report_selection("cameras", program_pts, ticket.program_pts());
+            EXPECT_TRUE(ticket.frame()->mark_submitted());
+            EXPECT_TRUE(ticket.frame()->mark_ready());
+        }
+        EXPECT_TRUE(ticket.await());
+        EXPECT_TRUE(queue.commit(ticket));
+        return ticket.frame()->payload();
+    };
+
+    push(queue_a, ORIGIN_A, 0);
+    push(queue_b, ORIGIN_B, 0);
+    for (int frame = 1; frame < 8; ++frame) {
+        const auto program_pts = FRAME_DURATION * frame;
+        push(queue_a, ORIGIN_A, frame);
+        // Member B's callback for this instant lands just after the tick on
+        // every other frame.
+        const bool b_late = frame % 2 == 0;
+        if (!b_late) {
+            push(queue_b, ORIGIN_B, frame);
+        }
+
+        queue_a.advance(program_pts, TARGET_TIME + program_pts);
+        queue_b.advance(program_pts, TARGET_TIME + program_pts);
+        registry.offer(
+            "cameras", program_pts, FRAME_DURATION, queue_a.presentable_program_pts(program_pts, TOLERANCE));
+        registry.offer(
+            "cameras", program_pts, FRAME_DURATION, queue_b.presentable_program_pts(program_pts, TOLERANCE));
+
+        const auto shown_a = present(queue_a, program_pts);
+        const auto shown_b = present(queue_b, program_pts);
+        EXPECT_EQ(shown_a, shown_b) << "program frame " << frame;
+        EXPECT_EQ(shown_a, b_late ? frame - 1 : frame);
+
+        if (b_late) {
+            push(queue_b, ORIGIN_B, frame);
+        }
+    }
+
+    // Metrics for the last program frame are finalized by the next one.
+    registry.offer("cameras", FRAME_DURATION * 8, FRAME_DURATION, std::nullopt);
+    const auto metrics = registry.metrics("cameras");
+    EXPECT_EQ(metrics.members, 2);
+    EXPECT_EQ(require_value(metrics.skew), utils::flicks{});
+    EXPECT_EQ(require_value(metrics.skew_max), utils::flicks{});
+    EXPECT_EQ(require_value(metrics.hold_back), utils::flicks{});
+}
+
+TEST(SourceSyncGroup, StalledMembersDoNotHoldTheGroupBack)
+{
+    constexpr auto PROGRAM_PTS = FRAME_DURATION * 4;
+
+    media::source_sync_registry_s registry;
+    registry.offer("group", PROGRAM_PTS, FRAME_DURATION, PROGRAM_PTS);
+    registry.offer("group", PROGRAM_PTS, FRAME_DURATION, PROGRAM_PTS - FRAME_DURATION);
+    registry.offer("group", PROGRAM_PTS, FRAME_DURATION, PROGRAM_PTS - FRAME_DURATION * 2);
+    registry.offer("group", PROGRAM_PTS, FRAME_DURATION, std::nullopt);
+    EXPECT_EQ(registry.selection_pts("group", PROGRAM_PTS), PROGRAM_PTS - FRAME_DURATION);
+    EXPECT_EQ(registry.selection_pts("other", PROGRAM_PTS), PROGRAM_PTS);
+
+    registry.report_selection("group", PROGRAM_PTS, PROGRAM_PTS - FRAME_DURATION);
+    registry.report_selection("group", PROGRAM_PTS, PROGRAM_PTS - FRAME_DURATION * 2);
+    registry.offer("group", PROGRAM_PTS + FRAME_DURATION, FRAME_DURATION, std::nullopt);
+
+    const auto metrics = registry.metrics("group");
+    EXPECT_EQ(metrics.members, 4);
+    EXPECT_EQ(require_value(metrics.skew), FRAME_DURATION);
+    EXPECT_EQ(require_value(metrics.hold_back), FRAME_DURATION);
+}
 } // namespace
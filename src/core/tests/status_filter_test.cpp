@@ -0,0 +1,79 @@
+#include "web_server/detail/status_filter.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+using miximus::web_server::detail::status_filter_s;
+
+const nlohmann::json STATUSES = {
+    {"a", {{"connected", true}, {"fps", 50}}},
+    {"b", {{"connected", false}, {"fps", 25}}},
+    {"c", {{"name", "camera"}}},
+};
+
+std::optional<std::string_view> node_type(std::string_view id)
+{
+    if (id == "a" || id == "b") {
+        return "decklink_input";
+    }
+    if (id == "c") {
+        return "ndi_input";
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+TEST(status_filter_test, empty_filter_passes_everything)
+{
+    const status_filter_s filter(std::nullopt, std::vector<std::string>{}, std::nullopt);
+
+    EXPECT_TRUE(filter.empty());
+    EXPECT_EQ(filter.apply(STATUSES, node_type), STATUSES);
+}
+
+TEST(status_filter_test, selects_nodes_by_id_or_type)
+{
+    const status_filter_s filter(std::vector<std::string>{"a"}, std::vector<std::string>{"ndi_input"}, std::nullopt);
+
+    const nlohmann::json expected = {
+        {"a", STATUSES["a"]},
+        {"c", STATUSES["c"]},
+    };
+    EXPECT_EQ(filter.apply(STATUSES, node_type), expected);
+}
+
+TEST(status_filter_test, ids_alone_do_not_look_up_types)
+{
+    const status_filter_s filter(std::vector<std::string>{"b"}, std::nullopt, std::nullopt);
+
+    const auto result = filter.apply(STATUSES, [](std::string_view) -> std::optional<std::string_view> {
+        ADD_FAILURE() << "unexpected type lookup";
+        return std::nullopt;
+    });
+    EXPECT_EQ(result, nlohmann::json({{"b", STATUSES["b"]}}));
+}
+
+TEST(status_filter_test, drops_fields_and_nodes_left_empty)
+{
+    const status_filter_s filter(std::nullopt, std::nullopt, std::vector<std::string>{"fps"});
+
+    const nlohmann::json expected = {
+        {"a", {{"fps", 50}}},
+        {"b", {{"fps", 25}}},
+    };
+    EXPECT_EQ(filter.apply(STATUSES, node_type), expected);
+}
+
+TEST(status_filter_test, returns_null_when_nothing_matches)
+{
+    const status_filter_s filter(std::vector<std::string>{"missing"}, std::nullopt, std::nullopt);
+
+    EXPECT_TRUE(filter.apply(STATUSES, node_type).is_null());
+}
@@ -1,9 +1,11 @@
 #include "types/web_message.hpp"
+#include "web_server/detail/encoded_message.hpp"
 #include "web_server/server.hpp"
 #include "web_server/typed_server.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <gtest/gtest.h>
@@ -35,31 +37,29 @@ class server_mock_s final : public web_server::server_s
     }
 
     void set_config_getters([[maybe_unused]] const web_server::config_getters_t& getters) final {}
-    void start([[maybe_unused]] uint16_t port, [[maybe_unused]] boost::asio::io_context* service) final {}
-    void stop() final {}
-
-    void send_message(const nlohmann::json& message, int64_t connection_id) final
+    void start([[maybe_unused]] uint16_t                 port,
+               [[maybe_unused]] boost::asio::io_context* command_executor,
+               [[maybe_unused]] size_t                   io_threads) final
     {
-        sent_connection_id = connection_id;
-        sent_message_value = message;
-        did_send           = true;
     }
+    void stop() final {}
 
-    void send_message_sync(const nlohmann::json& message, int64_t connection_id) final
+    void send_message(nlohmann::json message, int64_t connection_id) final
     {
         sent_connection_id = connection_id;
-        sent_message_value = message;
+        sent_message_value = std::move(message);
         did_send           = true;
     }
 
-    void broadcast_message(const nlohmann::json& message) final
+    void broadcast_message(nlohmann::json message) final
     {
-        broadcast_message_value = message;
+        broadcast_message_value = std::move(message);
         did_broadcast           = true;
     }
-    void broadcast_message_sync(const nlohmann::json& message) final
+
+    void broadcast_node_statuses(std::shared_ptr<const nlohmann::json> statuses, uint64_t /*version*/) final
     {
-        broadcast_message_value = message;
+        broadcast_message_value = *statuses;
         did_broadcast           = true;
     }
 };
@@ -73,9 +73,10 @@ TEST(web_message, typed_broadcast_serializes_the_envelope_and_payload)
         {"gain", 0.5      }
     };
 
-    server.broadcast_message_sync(web_message::add_node_command_s{
+    server.broadcast_message(web_message::add_node_command_s{
         .origin_id    = 42,
         .origin_token = "request-7",
+        .version      = 3,
         .node =
             {
                    .type    = "ndi_output",
@@ -91,6 +92,7 @@ TEST(web_message, typed_broadcast_serializes_the_envelope_and_payload)
                   {"topic",        "add_node" },
                   {"origin_id",    42         },
                   {"origin_token", "request-7"},
+                  {"version",      3          },
                   {"node",
                    {
                        {"type", "ndi_output"},
@@ -116,18 +118,39 @@ TEST(web_message, configuration_result_uses_the_shared_configuration_contract)
     };
 
     const auto message = web_message::config_result_s{
-        .token  = "request-1",
-        .config = snapshot.get<web_message::config_s>(),
+        .token   = "request-1",
+        .log_id  = "log-1",
+        .version = 7,
+        .config  = snapshot.get<web_message::config_s>(),
     };
 
     EXPECT_EQ(nlohmann::json(message),
               nlohmann::json({
-                  {"action", "result"   },
-                  {"token",  "request-1"},
-                  {"config", snapshot   },
+                  {"action",  "result"   },
+                  {"token",   "request-1"},
+                  {"log_id",  "log-1"    },
+                  {"version", 7          },
+                  {"config",  snapshot   },
     }));
 }
 
+TEST(web_message, msgpack_and_text_encodings_carry_the_same_message)
+{
+    const nlohmann::json statuses = {
+        {"output-1", {{"connected", true}, {"frames_late", 3}, {"latency_ms", 16.5}}},
+        {"input-1",  {{"active_format", nullptr}}                                   },
+    };
+    const nlohmann::json message = web_message::node_status_command_s{.statuses = statuses};
+
+    web_server::detail::encoded_message_s encoded(message);
+    EXPECT_EQ(nlohmann::json::parse(encoded.text()), message);
+    EXPECT_EQ(nlohmann::json::from_msgpack(encoded.msgpack()), message);
+    EXPECT_LT(encoded.msgpack().size(), encoded.text().size());
+
+    EXPECT_EQ(nlohmann::json(web_message::socket_info_s{.id = 3, .encoding = message_encoding_e::msgpack})["encoding"],
+              "msgpack");
+}
+
 TEST(web_message, typed_subscription_owns_values_after_dispatch)
 {
     server_mock_s                      implementation;
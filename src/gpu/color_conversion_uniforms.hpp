@@ -0,0 +1,36 @@
+#pragma once
+#include "color_transfer.hpp"
+#include "shader.hpp"
+#include "types.hpp"
+
+namespace miximus::gpu {
+
+// Uniform locations of the shaders converting between YUV and RGB
+struct color_conversion_uniforms_s
+{
+    uniform_location_s<int>    target_width;
+    uniform_location_s<mat3>   transfer;
+    uniform_location_s<vec3_t> transfer_offset;
+    uniform_location_s<mat3>   gamut_transfer;
+
+    explicit color_conversion_uniforms_s(const shader_program_s& shader)
+        : target_width(shader.get_uniform_location<int>("target_width"))
+        , transfer(shader.get_uniform_location<mat3>("transfer"))
+        , transfer_offset(shader.get_uniform_location<vec3_t>("transfer_offset"))
+        , gamut_transfer(shader.get_uniform_location<mat3>("gamut_transfer"))
+    {
+    }
+
+    void set(shader_program_s&         shader,
+             int                       width,
+             const color_conversion_s& conversion,
+             const mat3&               gamut_conversion) const
+    {
+        shader.set_uniform(target_width, width);
+        shader.set_uniform(transfer, conversion.matrix);
+        shader.set_uniform(transfer_offset, conversion.offset);
+        shader.set_uniform(gamut_transfer, gamut_conversion);
+    }
+};
+
+} // namespace miximus::gpu
@@ -5,12 +5,16 @@
 #include "glad.hpp"
 #include "logger/logger.hpp"
 #include "shader.hpp"
+#include "shader_binary_cache.hpp"
 #include "static_files/files.hpp"
+#include "utils/filesystem.hpp"
+#include "warm_up_results.hpp"
 #include "wrapper/stb/image.hpp"
 
 #define GLFW_INCLUDE_NONE
 
 #include <GLFW/glfw3.h>
+#include <magic_enum/magic_enum.hpp>
 
 #include <algorithm>
 #include <array>
@@ -20,7 +24,9 @@
 #include <mutex>
 #include <span>
 #include <stdexcept>
+#include <stop_token>
 #include <string_view>
+#include <thread>
 #include <utility>
 
 namespace {
@@ -33,7 +39,7 @@ const auto _log = [] { return getlog("gpu"); };
 
 stb::decoded_image_s load_image(std::string_view filename)
 {
-    const auto file_data = static_files::get_resource_files().get_file_or_throw(filename).unzip();
+    const auto file_data = static_files::get_resource_files().get_file_or_throw(filename).contents();
     auto       image     = stb::decode_image(std::as_bytes(std::span{file_data}), stb::image_channels_e::rgba);
 
     if (image.source_channels() != 4) {
@@ -43,6 +49,84 @@ stb::decoded_image_s load_image(std::string_view filename)
     return image;
 }
 
+struct shader_program_files_s
+{
+    std::string_view vertex;
+    std::string_view fragment;
+    std::string_view compute; // Replaces the other stages when set
+};
+
+// Every program start_shader_warm_up() compiles, in declaration order
+constexpr auto ALL_SHADER_PROGRAMS = magic_enum::enum_values<gpu::shader_program_s::name_e>();
+
+shader_program_files_s shader_program_files(gpu::shader_program_s::name_e name)
+{
+    using name_e = gpu::shader_program_s::name_e;
+
+    shader_program_files_s files{.vertex = "shaders/basic.vs.glsl", .fragment = {}, .compute = {}};
+    switch (name) {
+        case name_e::basic:
+            files.fragment = "shaders/basic.fs.glsl";
+            break;
+        case name_e::texture_mix:
+            files.fragment = "shaders/mix.fs.glsl";
+            break;
+        case name_e::yuv_to_rgb:
+            files.fragment = "shaders/from_yuv.fs.glsl";
+            break;
+        case name_e::uyvy_to_rgb:
+            files.fragment = "shaders/from_uyvy.fs.glsl";
+            break;
+        case name_e::p216_to_rgb:
+            files.fragment = "shaders/from_p216.fs.glsl";
+            break;
+        case name_e::rgb_to_yuv:
+            files.fragment = "shaders/to_yuv.fs.glsl";
+            break;
+        case name_e::apply_gamma:
+            files.fragment = "shaders/apply_gamma.fs.glsl";
+            break;
+        case name_e::encode_rec709_premultiplied:
+            files.fragment = "shaders/encode_rec709_premultiplied.fs.glsl";
+            break;
+        case name_e::strip_gamma:
+            files.fragment = "shaders/strip_gamma.fs.glsl";
+            break;
+        case name_e::rgb_to_uyvy:
+            files.fragment = "shaders/to_uyvy.fs.glsl";
+            break;
+        case name_e::rgb_to_nv12:
+            files.fragment = "shaders/to_nv12.fs.glsl";
+            break;
+        case name_e::rgb_to_p216:
+            files.fragment = "shaders/to_p216.fs.glsl";
+            break;
+        case name_e::layer_composite:
+            files.vertex   = "shaders/layers.vs.glsl";
+            files.fragment = "shaders/layers.fs.glsl";
+            break;
+        case name_e::yuv_to_rgb_compute:
+            files = {.vertex = {}, .fragment = {}, .compute = "shaders/from_yuv.cs.glsl"};
+            break;
+        case name_e::rgb_to_yuv_compute:
+            files = {.vertex = {}, .fragment = {}, .compute = "shaders/to_yuv.cs.glsl"};
+            break;
+        default:
+            throw std::invalid_argument("Unknown shader program");
+    }
+    return files;
+}
+
+std::unique_ptr<gpu::shader_program_s> create_shader_program(gpu::shader_program_s::name_e      name,
+                                                              const gpu::shader_binary_cache_s* cache)
+{
+    const auto files = shader_program_files(name);
+    if (!files.compute.empty()) {
+        return std::make_unique<gpu::shader_program_s>(files.compute, cache);
+    }
+    return std::make_unique<gpu::shader_program_s>(files.vertex, files.fragment, cache);
+}
+
 gpu::context_s::window_settings_s default_window_settings(bool visible)
 {
     auto settings    = gpu::context_s::window_settings_s{};
@@ -298,6 +382,8 @@ context_s::~context_s()
     if (window_ != nullptr) {
         {
             const context_scope_s context_scope(*this);
+            shader_warm_up_.reset();
+            uniform_ring_.reset();
             shaders_.clear();
         }
         glfwDestroyWindow(window_);
@@ -363,6 +449,23 @@ bool context_s::require_current()
     return ok;
 }
 
+context_s* context_s::current() noexcept
+{
+    if (current_stack_.empty()) {
+        return nullptr;
+    }
+    return static_cast<context_s*>(glfwGetWindowUserPointer(current_stack_.back()));
+}
+
+gl_state_cache_s& context_s::current_state_cache()
+{
+    auto* context = current();
+    if (context == nullptr) {
+        throw std::logic_error("No current GL context");
+    }
+    return context->state_cache_;
+}
+
 void context_s::swap_buffers() { glfwSwapBuffers(window_); }
 
 void context_s::finish() { glFinish(); }
@@ -375,47 +478,108 @@ void context_s::terminate() { glfwTerminate(); }
 
 bool context_s::has_extension(const char* ext) { return glfwExtensionSupported(ext) != 0; }
 
-shader_program_s* context_s::get_shader(shader_program_s::name_e name)
+struct context_s::shader_warm_up_s
 {
-    using name_e = shader_program_s::name_e;
+    using programs_t = warm_up_results_s<shader_program_s::name_e, std::unique_ptr<shader_program_s>>;
+
+    std::unique_ptr<context_s> context;
+    programs_t                 programs;
+    std::jthread               thread; // Last, so it is joined before the rest is destroyed
+};
 
+void context_s::set_shader_cache_directory(const std::filesystem::path& directory)
+{
+    if (directory.empty()) {
+        shader_cache_.reset();
+        return;
+    }
+    _log()->info("Caching shader programs in {}", utils::path_to_utf8(directory));
+    shader_cache_ = std::make_unique<shader_binary_cache_s>(directory);
+}
+
+void context_s::start_shader_warm_up()
+{
+    if (shader_warm_up_) {
+        return;
+    }
+
+    auto warm_up = std::make_unique<shader_warm_up_s>();
+    try {
+        warm_up->context = create_unique_context(false, this);
+    } catch (const std::exception& e) {
+        _log()->warn("Skipping shader warm-up, failed to create its context: {}", e.what());
+        return;
+    }
+
+    warm_up->thread = std::jthread([state = warm_up.get()](const std::stop_token& stop_token) {
+        const auto            start = std::chrono::steady_clock::now();
+        const context_scope_s context_scope(*state->context);
+        size_t                count = 0;
+
+        for (const auto name : ALL_SHADER_PROGRAMS) {
+            if (stop_token.stop_requested()) {
+                break;
+            }
+
+            std::unique_ptr<shader_program_s> program;
+            try {
+                program = create_shader_program(name, shader_cache_.get());
+                // Finish before publishing so the linked program is complete
+                // when the other context starts using it
+                glFinish();
+                ++count;
+            } catch (const std::exception& e) {
+                // get_shader() compiles it again and reports the error to its caller
+                _log()->error("Shader warm-up failed: {}", e.what());
+            }
+
+            if (program) {
+                state->programs.publish(name, std::move(program));
+            }
+        }
+        state->programs.finish();
+
+        _log()->info("Warmed up {} shader programs in {:.1f} ms",
+                     count,
+                     std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    });
+
+    shader_warm_up_ = std::move(warm_up);
+}
+
+std::unique_ptr<shader_program_s> context_s::take_warmed_up_shader(shader_program_s::name_e name)
+{
+    if (!shader_warm_up_) {
+        return nullptr;
+    }
+
+    return shader_warm_up_->programs.take(name);
+}
+
+shader_program_s* context_s::get_shader(shader_program_s::name_e name)
+{
     if (auto it = shaders_.find(name); it != shaders_.end()) {
         return it->second.get();
     }
 
-    constexpr std::string_view vertex_shader = "shaders/basic.vs.glsl";
-    std::string_view           fragment_shader;
-    switch (name) {
-        case name_e::basic:
-            fragment_shader = "shaders/basic.fs.glsl";
-            break;
-        case name_e::texture_mix:
-            fragment_shader = "shaders/mix.fs.glsl";
-            break;
-        case name_e::yuv_to_rgb:
-            fragment_shader = "shaders/from_yuv.fs.glsl";
-            break;
-        case name_e::rgb_to_yuv:
-            fragment_shader = "shaders/to_yuv.fs.glsl";
-            break;
-        case name_e::apply_gamma:
-            fragment_shader = "shaders/apply_gamma.fs.glsl";
-            break;
-        case name_e::encode_rec709_premultiplied:
-            fragment_shader = "shaders/encode_rec709_premultiplied.fs.glsl";
-            break;
-        case name_e::strip_gamma:
-            fragment_shader = "shaders/strip_gamma.fs.glsl";
-            break;
-        default:
-            throw std::invalid_argument("Unknown shader program");
+    auto program = take_warmed_up_shader(name);
+    if (!program) {
+        program = create_shader_program(name, shader_cache_.get());
     }
 
-    auto [it, _] = shaders_.emplace(name, std::make_unique<shader_program_s>(vertex_shader, fragment_shader));
+    auto [it, _] = shaders_.emplace(name, std::move(program));
 
     return it->second.get();
 }
 
+uniform_ring_s& context_s::uniform_ring()
+{
+    if (!uniform_ring_) {
+        uniform_ring_ = std::make_unique<uniform_ring_s>();
+    }
+    return *uniform_ring_;
+}
+
 std::unique_ptr<context_s> context_s::create_unique_context(bool visible, context_s* parent)
 {
     return std::make_unique<context_s>(visible, parent);
@@ -1,10 +1,13 @@
 #pragma once
+#include "gl_state_cache.hpp"
 #include "shader.hpp"
 #include "types.hpp"
+#include "uniform_ring.hpp"
 #include "types/settings_option.hpp"
 
 #include <atomic>
 #include <cstdint>
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <optional>
@@ -52,12 +55,21 @@ class context_s
         vec2i_t            dimensions{};
     };
 
+    struct shader_warm_up_s;
+
     static inline thread_local std::vector<GLFWwindow*>                current_stack_;
+    static inline std::unique_ptr<shader_binary_cache_s>               shader_cache_;
     static inline std::atomic<uint64_t>                                monitor_list_version_{0};
     static inline std::map<std::string, monitor_record_s, std::less<>> monitors_;
 
-    GLFWwindow*  window_{};
-    shader_map_t shaders_;
+    GLFWwindow*                       window_{};
+    shader_map_t                      shaders_;
+    std::unique_ptr<shader_warm_up_s> shader_warm_up_;
+    std::unique_ptr<uniform_ring_s>   uniform_ring_;
+    gl_state_cache_s                  state_cache_;
+
+    std::unique_ptr<shader_program_s> take_warmed_up_shader(shader_program_s::name_e name);
+
     void         make_current();
     static void  rewind_current();
     static void  monitor_config_callback(GLFWmonitor* monitor, int event) noexcept;
@@ -75,8 +87,12 @@ class context_s
     vec2i_t get_framebuffer_size();
     recti_s get_window_rect();
 
-    static bool has_current() noexcept;
-    static bool require_current();
+    static bool       has_current() noexcept;
+    static bool       require_current();
+    static context_s* current() noexcept;
+
+    // Binds, blending and pixel store of the current context go through this, throws without one
+    static gl_state_cache_s& current_state_cache();
 
     void swap_buffers();
 
@@ -91,6 +107,25 @@ class context_s
 
     shader_program_s* get_shader(shader_program_s::name_e name);
 
+    // Per-draw uniform blocks of this context, must be used with it current
+    uniform_ring_s& uniform_ring();
+
+    /**
+     * Keep linked shader programs in `directory` across runs. Must be called
+     * before any shader is compiled, an empty path disables the cache.
+     */
+    static void set_shader_cache_directory(const std::filesystem::path& directory);
+
+    /**
+     * Compile every shader program on a hidden context sharing objects with
+     * this one, on a background thread, in name_e order. get_shader() adopts
+     * the finished programs and waits until the requested one is ready or
+     * warm-up has ended, which includes compiling every program before it.
+     * Must be called from the main thread, which GLFW requires for creating
+     * windows.
+     */
+    void start_shader_warm_up();
+
     static std::unique_ptr<context_s> create_unique_context(bool visible = false, context_s* parent = nullptr);
     static std::unique_ptr<context_s> create_unique_context(const window_settings_s& settings,
                                                             context_s*               parent = nullptr);
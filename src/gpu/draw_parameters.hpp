@@ -0,0 +1,22 @@
+#pragma once
+#include "glad.hpp"
+
+#include <glm/vec4.hpp>
+
+namespace miximus::gpu {
+
+// Uniform block holding per-draw textured quad parameters, see common.glsl
+constexpr const char* DRAW_PARAMETERS_BLOCK   = "draw_parameters";
+constexpr GLuint      DRAW_PARAMETERS_BINDING = 0;
+
+// std140 layout of the draw_parameters block, padded to a whole vec4
+struct alignas(16) draw_parameters_s
+{
+    glm::vec4 destination; // offset.xy, scale.zw
+    glm::vec4 source;      // offset.xy, scale.zw
+    float     opacity;
+};
+
+static_assert(sizeof(draw_parameters_s) == 48);
+
+} // namespace miximus::gpu
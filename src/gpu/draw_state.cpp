@@ -1,54 +1,43 @@
 #include "draw_state.hpp"
 
+#include "context.hpp"
+
 namespace miximus::gpu {
 
 namespace {
 constexpr GLuint position_attribute_location           = 0;
 constexpr GLuint texture_coordinate_attribute_location = 1;
+constexpr GLuint vertex_buffer_binding                 = 0;
 } // namespace
 
 void draw_state_s::set_vertex_data(std::span<const vertex_uv> vertices)
 {
-    vertex_array_.bind();
-    vertex_buffer_.bind();
     vertex_buffer_.set_data(vertices);
 
-    // OpenGL represents an offset into the bound vertex buffer through this pointer parameter.
-    glEnableVertexAttribArray(position_attribute_location);
-    glVertexAttribPointer(position_attribute_location,
-                          2,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(vertex_uv),
-                          reinterpret_cast<void*>(offsetof(vertex_uv, pos))); // NOLINT(performance-no-int-to-ptr)
-
-    glEnableVertexAttribArray(texture_coordinate_attribute_location);
-    glVertexAttribPointer(texture_coordinate_attribute_location,
-                          2,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(vertex_uv),
-                          reinterpret_cast<void*>(offsetof(vertex_uv, uv))); // NOLINT(performance-no-int-to-ptr)
+    const auto vao = vertex_array_.id();
+    glVertexArrayVertexBuffer(vao, vertex_buffer_binding, vertex_buffer_.id(), 0, sizeof(vertex_uv));
+
+    glEnableVertexArrayAttrib(vao, position_attribute_location);
+    glVertexArrayAttribFormat(vao, position_attribute_location, 2, GL_FLOAT, GL_FALSE, offsetof(vertex_uv, pos));
+    glVertexArrayAttribBinding(vao, position_attribute_location, vertex_buffer_binding);
+
+    glEnableVertexArrayAttrib(vao, texture_coordinate_attribute_location);
+    glVertexArrayAttribFormat(
+        vao, texture_coordinate_attribute_location, 2, GL_FLOAT, GL_FALSE, offsetof(vertex_uv, uv));
+    glVertexArrayAttribBinding(vao, texture_coordinate_attribute_location, vertex_buffer_binding);
 }
 
 void draw_state_s::draw()
 {
-    vertex_array_.bind();
-
-    if (!blending_enabled_) {
-        glDisablei(GL_BLEND, 0);
-    }
+    auto& state = context_s::current_state_cache();
+    state.bind_vertex_array(vertex_array_.id());
+    state.set_blend(blending_enabled_);
 
     if (shader_ != nullptr) {
         shader_->use();
     }
 
     vertex_buffer_.draw();
-
-    shader_program_s::unuse();
-    if (!blending_enabled_) {
-        glEnablei(GL_BLEND, 0);
-    }
 }
 
 } // namespace miximus::gpu
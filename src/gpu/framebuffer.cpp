@@ -7,40 +7,44 @@
 
 namespace miximus::gpu {
 
-framebuffer_s::framebuffer_s(vec2i_t dimensions, texture_s::pixel_format_e pixel_format)
+framebuffer_s::framebuffer_s(vec2i_t                   dimensions,
+                             texture_s::pixel_format_e pixel_format,
+                             depth_stencil_e           depth_stencil)
     : owned_texture_(std::make_unique<texture_s>(dimensions, pixel_format))
     , texture_(owned_texture_.get())
+    , depth_stencil_(depth_stencil)
 {
     initialize();
 }
 
-framebuffer_s::framebuffer_s(texture_s* texture)
+framebuffer_s::framebuffer_s(texture_s* texture, depth_stencil_e depth_stencil)
     : texture_(texture)
+    , depth_stencil_(depth_stencil)
 {
     initialize();
 }
 
 void framebuffer_s::initialize()
 {
-    glGenFramebuffers(1, &id_);
-    bind();
-
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_->id(), 0);
+    glCreateFramebuffers(1, &id_);
+    glNamedFramebufferTexture(id_, GL_COLOR_ATTACHMENT0, texture_->id(), 0);
 
-    auto tex_dims = texture_->texture_dimensions();
+    if (depth_stencil_ == depth_stencil_e::depth24_stencil8) {
+        auto tex_dims = texture_->texture_dimensions();
 
-    glGenRenderbuffers(1, &rbo_id_);
-    glBindRenderbuffer(GL_RENDERBUFFER, rbo_id_);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, tex_dims.x, tex_dims.y);
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glCreateRenderbuffers(1, &rbo_id_);
+        glNamedRenderbufferStorage(rbo_id_, GL_DEPTH24_STENCIL8, tex_dims.x, tex_dims.y);
+        glNamedFramebufferRenderbuffer(id_, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo_id_);
 
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo_id_);
+        constexpr size_t depth24_stencil8_bytes_per_texel = 4;
+        depth_stencil_memory_ = memory_allocation_s(
+            "depth24_stencil8",
+            static_cast<size_t>(tex_dims.x) * static_cast<size_t>(tex_dims.y) * depth24_stencil8_bytes_per_texel);
+    }
 
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    if (glCheckNamedFramebufferStatus(id_, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         getlog("gpu")->error("Framebuffer is not complete");
     }
-
-    unbind();
 }
 
 framebuffer_s::~framebuffer_s()
@@ -49,7 +53,17 @@ framebuffer_s::~framebuffer_s()
         return;
     }
     glDeleteFramebuffers(1, &id_);
-    glDeleteRenderbuffers(1, &rbo_id_);
+    if (rbo_id_ != 0) {
+        glDeleteRenderbuffers(1, &rbo_id_);
+    }
+}
+
+void framebuffer_s::set_memory_owner(std::string_view owner)
+{
+    if (owned_texture_) {
+        owned_texture_->set_memory_owner(owner);
+    }
+    depth_stencil_memory_.set_owner(owner);
 }
 
 void framebuffer_s::bind() const { glBindFramebuffer(GL_FRAMEBUFFER, id_); }
@@ -69,10 +83,15 @@ void framebuffer_s::begin_render(recti_s viewport, load_op_e load_op) const
 {
     bind();
     glViewport(viewport.pos.x, viewport.pos.y, viewport.size.x, viewport.size.y);
+    texture_->invalidate_mip_maps();
 
     if (load_op == load_op_e::clear) {
+        auto mask = static_cast<GLbitfield>(GL_COLOR_BUFFER_BIT);
+        if (rbo_id_ != 0) {
+            mask |= static_cast<GLbitfield>(GL_DEPTH_BUFFER_BIT) | static_cast<GLbitfield>(GL_STENCIL_BUFFER_BIT);
+        }
         glClearColor(0, 0, 0, 0);
-        glClear(static_cast<GLbitfield>(GL_COLOR_BUFFER_BIT) | static_cast<GLbitfield>(GL_DEPTH_BUFFER_BIT));
+        glClear(mask);
     }
 }
 
@@ -86,6 +105,7 @@ void framebuffer_s::blit(framebuffer_s* target) const
     auto dst_dim = target->texture()->texture_dimensions();
     glBlitNamedFramebuffer(
         id_, target->id(), 0, 0, src_dim.x, src_dim.y, 0, 0, dst_dim.x, dst_dim.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    target->texture()->invalidate_mip_maps();
 }
 
 void framebuffer_s::end_render() { unbind(); }
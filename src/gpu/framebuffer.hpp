@@ -2,6 +2,7 @@
 #include "texture.hpp"
 
 #include <memory>
+#include <string_view>
 
 namespace miximus::gpu {
 
@@ -12,8 +13,6 @@ class framebuffer_s
     std::unique_ptr<texture_s> owned_texture_;
     texture_s*                 texture_{};
 
-    void initialize();
-
   public:
     enum class load_op_e
     {
@@ -21,10 +20,32 @@ class framebuffer_s
         clear,
     };
 
-    framebuffer_s(vec2i_t dimensions, texture_s::pixel_format_e pixel_format);
-    explicit framebuffer_s(texture_s* texture);
+    // Nothing in the compositor uses depth or stencil testing, so the
+    // attachment is only allocated for targets that ask for it
+    enum class depth_stencil_e
+    {
+        none,
+        depth24_stencil8,
+    };
+
+  private:
+    depth_stencil_e     depth_stencil_;
+    memory_allocation_s depth_stencil_memory_;
+
+    void initialize();
+
+  public:
+    framebuffer_s(vec2i_t                   dimensions,
+                  texture_s::pixel_format_e pixel_format,
+                  depth_stencil_e           depth_stencil = depth_stencil_e::none);
+    explicit framebuffer_s(texture_s* texture, depth_stencil_e depth_stencil = depth_stencil_e::none);
     ~framebuffer_s();
 
+    framebuffer_s(const framebuffer_s&)            = delete;
+    framebuffer_s(framebuffer_s&&)                 = delete;
+    framebuffer_s& operator=(const framebuffer_s&) = delete;
+    framebuffer_s& operator=(framebuffer_s&&)      = delete;
+
     void        bind() const;
     void        begin_render(load_op_e load_op = load_op_e::preserve) const;
     void        begin_render(recti_s viewport, load_op_e load_op = load_op_e::preserve) const;
@@ -33,6 +54,10 @@ class framebuffer_s
     static void unbind();
     texture_s*  texture() const noexcept { return texture_; }
     GLuint      id() const noexcept { return id_; }
+    auto        depth_stencil() const noexcept { return depth_stencil_; }
+
+    // Accounts the owned color texture and the depth/stencil attachment to `owner`
+    void set_memory_owner(std::string_view owner);
 };
 
 } // namespace miximus::gpu
@@ -155,6 +155,20 @@ calculate_texture_draw(rect_s bounds, vec2i_t content_dimensions, vec2i_t target
     return result;
 }
 
+/**
+ * Whether a draw shrinks the sampled part of the content by more than half a
+ * pixel along either axis. Only such draws read the texture's mip levels.
+ */
+[[nodiscard]] inline bool
+texture_draw_minifies(const texture_draw_s& draw, vec2i_t content_dimensions, vec2i_t target_dimensions) noexcept
+{
+    const auto source_x      = std::abs(draw.source.size.x) * content_dimensions.x;
+    const auto source_y      = std::abs(draw.source.size.y) * content_dimensions.y;
+    const auto destination_x = std::abs(draw.destination.size.x) * target_dimensions.x;
+    const auto destination_y = std::abs(draw.destination.size.y) * target_dimensions.y;
+    return destination_x + 0.5 < source_x || destination_y + 0.5 < source_y;
+}
+
 /** Convert a normalized rectangle into a pixel rectangle for a target. */
 [[nodiscard]] inline recti_s normalized_to_pixel_rect(rect_s rect, vec2i_t target_dimensions)
 {
@@ -0,0 +1,124 @@
+#include "gl_state_cache.hpp"
+
+#include <utility>
+
+namespace miximus::gpu {
+
+namespace {
+// Never returned by glCreate*, so the next bind of any name goes through
+constexpr GLuint UNKNOWN_NAME = ~GLuint{0};
+
+GLenum pixel_store_pname(gl_state_cache_s::pixel_store_e name)
+{
+    switch (name) {
+        case gl_state_cache_s::pixel_store_e::pack_row_length:
+            return GL_PACK_ROW_LENGTH;
+        case gl_state_cache_s::pixel_store_e::pack_alignment:
+            return GL_PACK_ALIGNMENT;
+        case gl_state_cache_s::pixel_store_e::unpack_row_length:
+            return GL_UNPACK_ROW_LENGTH;
+        case gl_state_cache_s::pixel_store_e::unpack_alignment:
+            return GL_UNPACK_ALIGNMENT;
+    }
+    return GL_UNPACK_ALIGNMENT;
+}
+} // namespace
+
+void gl_state_cache_s::forget_deleted_objects() noexcept
+{
+    const auto deletions = deletions_.load(std::memory_order_acquire);
+    if (deletions == seen_deletions_) {
+        return;
+    }
+    seen_deletions_ = deletions;
+
+    // GL only unbinds a deleted object on the deleting context, so rebind everything once
+    textures_.fill(UNKNOWN_NAME);
+    program_      = UNKNOWN_NAME;
+    vertex_array_ = UNKNOWN_NAME;
+}
+
+bool gl_state_cache_s::track_texture(GLuint unit, GLuint texture) noexcept
+{
+    if (unit >= textures_.size()) {
+        return true;
+    }
+    forget_deleted_objects();
+    return std::exchange(textures_[unit], texture) != texture;
+}
+
+bool gl_state_cache_s::track_program(GLuint program) noexcept
+{
+    forget_deleted_objects();
+    return std::exchange(program_, program) != program;
+}
+
+bool gl_state_cache_s::track_vertex_array(GLuint vertex_array) noexcept
+{
+    forget_deleted_objects();
+    return std::exchange(vertex_array_, vertex_array) != vertex_array;
+}
+
+bool gl_state_cache_s::track_blend(bool enabled) noexcept { return std::exchange(blend_, enabled) != enabled; }
+
+bool gl_state_cache_s::track_pixel_store(pixel_store_e name, GLint value) noexcept
+{
+    auto& cached = pixel_store_.at(static_cast<size_t>(name));
+    return std::exchange(cached, value) != value;
+}
+
+void gl_state_cache_s::bind_texture(GLuint unit, GLuint texture)
+{
+    if (track_texture(unit, texture)) {
+        glBindTextureUnit(unit, texture);
+    }
+}
+
+void gl_state_cache_s::use_program(GLuint program)
+{
+    if (track_program(program)) {
+        glUseProgram(program);
+    }
+}
+
+void gl_state_cache_s::bind_vertex_array(GLuint vertex_array)
+{
+    if (track_vertex_array(vertex_array)) {
+        glBindVertexArray(vertex_array);
+    }
+}
+
+void gl_state_cache_s::set_blend(bool enabled)
+{
+    if (!track_blend(enabled)) {
+        return;
+    }
+    if (enabled) {
+        glEnablei(GL_BLEND, 0);
+    } else {
+        glDisablei(GL_BLEND, 0);
+    }
+}
+
+void gl_state_cache_s::set_pixel_store(pixel_store_e name, GLint value)
+{
+    if (track_pixel_store(name, value)) {
+        glPixelStorei(pixel_store_pname(name), value);
+    }
+}
+
+void gl_state_cache_s::set_unpack_layout(GLint row_length, GLint alignment)
+{
+    set_pixel_store(pixel_store_e::unpack_row_length, row_length);
+    set_pixel_store(pixel_store_e::unpack_alignment, alignment);
+}
+
+void gl_state_cache_s::set_pack_layout(GLint row_length, GLint alignment)
+{
+    set_pixel_store(pixel_store_e::pack_row_length, row_length);
+    set_pixel_store(pixel_store_e::pack_alignment, alignment);
+}
+
+void gl_state_cache_s::object_deleted() noexcept { deletions_.fetch_add(1, std::memory_order_release); }
+
+} // namespace miximus::gpu
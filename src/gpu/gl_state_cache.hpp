@@ -0,0 +1,77 @@
+#pragma once
+#include "glad.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace miximus::gpu {
+
+/**
+ * Shadow copy of the GL state the renderer changes on every draw and
+ * transfer, so changes that would not change anything are skipped and the
+ * previous value never has to be read back with glGet*. Owned per context,
+ * see context_s::current_state_cache(). Every change of the covered state
+ * must go through it, or the shadow copy goes stale.
+ *
+ * Bindings are kept after a draw instead of being reset to zero. Object names
+ * are shared between contexts and reused once deleted, so deleting a texture,
+ * program or vertex array must call object_deleted(), which makes the caches
+ * of all contexts forget the objects they have bound.
+ */
+class gl_state_cache_s
+{
+  public:
+    static constexpr size_t MAX_TEXTURE_UNITS = 32;
+
+    enum class pixel_store_e
+    {
+        pack_row_length,
+        pack_alignment,
+        unpack_row_length,
+        unpack_alignment,
+    };
+
+  private:
+    static inline std::atomic<uint64_t> deletions_{0};
+
+    std::array<GLuint, MAX_TEXTURE_UNITS> textures_{};
+    GLuint                                program_{};
+    GLuint                                vertex_array_{};
+    bool                                  blend_{true}; // context_s enables blending on creation
+    std::array<GLint, 4>                  pixel_store_{0, 4, 0, 4};
+    uint64_t                              seen_deletions_{};
+
+    void forget_deleted_objects() noexcept;
+
+  public:
+    gl_state_cache_s() = default;
+
+    gl_state_cache_s(const gl_state_cache_s&)            = delete;
+    gl_state_cache_s(gl_state_cache_s&&)                 = delete;
+    gl_state_cache_s& operator=(const gl_state_cache_s&) = delete;
+    gl_state_cache_s& operator=(gl_state_cache_s&&)      = delete;
+
+    // Record a value, true when it differs from the cached one and GL has to be told
+    bool track_texture(GLuint unit, GLuint texture) noexcept;
+    bool track_program(GLuint program) noexcept;
+    bool track_vertex_array(GLuint vertex_array) noexcept;
+    bool track_blend(bool enabled) noexcept;
+    bool track_pixel_store(pixel_store_e name, GLint value) noexcept;
+
+    void bind_texture(GLuint unit, GLuint texture);
+    void use_program(GLuint program);
+    void bind_vertex_array(GLuint vertex_array);
+    void set_blend(bool enabled);
+    void set_pixel_store(pixel_store_e name, GLint value);
+
+    // Row length in pixels and alignment of client memory or pixel buffers
+    void set_unpack_layout(GLint row_length, GLint alignment);
+    void set_pack_layout(GLint row_length, GLint alignment);
+
+    // Must be called after deleting a texture, program or vertex array, on any context
+    static void object_deleted() noexcept;
+};
+
+} // namespace miximus::gpu
@@ -0,0 +1,147 @@
+#include "layer_compositor.hpp"
+
+#include "context.hpp"
+#include "texture.hpp"
+#include "vertex.hpp"
+
+#include <boost/container/small_vector.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+
+namespace miximus::gpu {
+
+namespace {
+constexpr GLuint position_attribute_location           = 0;
+constexpr GLuint texture_coordinate_attribute_location = 1;
+constexpr GLuint destination_attribute_location        = 2;
+constexpr GLuint source_attribute_location             = 3;
+constexpr GLuint opacity_attribute_location            = 4;
+constexpr GLuint additive_attribute_location           = 5;
+constexpr GLuint texture_unit_attribute_location       = 6;
+
+constexpr GLuint quad_buffer_binding     = 0;
+constexpr GLuint instance_buffer_binding = 1;
+
+void set_float_attribute(GLuint vao, GLuint location, GLuint binding, GLint size, size_t offset)
+{
+    glEnableVertexArrayAttrib(vao, location);
+    glVertexArrayAttribFormat(vao, location, size, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offset));
+    glVertexArrayAttribBinding(vao, location, binding);
+}
+
+} // namespace
+
+layer_compositor_s::layer_compositor_s(shader_program_s* shader)
+    : shader_(shader)
+{
+    if (shader_ == nullptr) {
+        throw std::invalid_argument("layer compositor shader must not be null");
+    }
+
+    std::array<GLint, MAX_BATCH_TEXTURES> texture_units{};
+    std::iota(texture_units.begin(), texture_units.end(), 0);
+    shader_->set_uniform("layer_textures[0]", texture_units);
+
+    quad_buffer_.set_data(std::span{full_screen_quad_verts_flip_uv});
+    glCreateBuffers(1, &instance_buffer_);
+
+    const auto vao = vertex_array_.id();
+    glVertexArrayVertexBuffer(vao, quad_buffer_binding, quad_buffer_.id(), 0, sizeof(vertex_uv));
+    glVertexArrayVertexBuffer(vao, instance_buffer_binding, instance_buffer_, 0, sizeof(instance_s));
+    glVertexArrayBindingDivisor(vao, instance_buffer_binding, 1);
+
+    set_float_attribute(vao, position_attribute_location, quad_buffer_binding, 2, offsetof(vertex_uv, pos));
+    set_float_attribute(vao, texture_coordinate_attribute_location, quad_buffer_binding, 2, offsetof(vertex_uv, uv));
+    set_float_attribute(
+        vao, destination_attribute_location, instance_buffer_binding, 4, offsetof(instance_s, destination));
+    set_float_attribute(vao, source_attribute_location, instance_buffer_binding, 4, offsetof(instance_s, source));
+    set_float_attribute(vao, opacity_attribute_location, instance_buffer_binding, 1, offsetof(instance_s, opacity));
+    set_float_attribute(vao, additive_attribute_location, instance_buffer_binding, 1, offsetof(instance_s, additive));
+
+    glEnableVertexArrayAttrib(vao, texture_unit_attribute_location);
+    glVertexArrayAttribIFormat(vao, texture_unit_attribute_location, 1, GL_INT, offsetof(instance_s, texture_unit));
+    glVertexArrayAttribBinding(vao, texture_unit_attribute_location, instance_buffer_binding);
+}
+
+layer_compositor_s::~layer_compositor_s()
+{
+    if (!context_s::require_current()) {
+        return;
+    }
+    glDeleteBuffers(1, &instance_buffer_);
+}
+
+void layer_compositor_s::draw(std::span<const layer_s> layers)
+{
+    build_batches(layers, &instances_, [this](std::span<texture_s* const> textures) { draw_batch(textures); });
+}
+
+void layer_compositor_s::build_batches(std::span<const layer_s> layers,
+                                       std::vector<instance_s>* instances,
+                                       const batch_callback_t&  draw_batch)
+{
+    boost::container::small_vector<texture_s*, MAX_BATCH_TEXTURES> textures;
+    instances->clear();
+
+    for (const auto& layer : layers) {
+        if (layer.texture == nullptr || layer.opacity <= 0.0) {
+            continue;
+        }
+
+        auto unit = std::ranges::find(textures, layer.texture);
+        if (unit == textures.end()) {
+            if (textures.size() == MAX_BATCH_TEXTURES) {
+                draw_batch({textures.data(), textures.size()});
+                textures.clear();
+                instances->clear();
+            }
+            unit = textures.insert(textures.end(), layer.texture);
+        }
+
+        const auto& [destination, source] = layer.draw;
+        instances->push_back({
+            .destination  = glm::vec4(destination.pos, destination.size),
+            .source       = glm::vec4(source.pos, source.size),
+            .opacity      = static_cast<float>(layer.opacity),
+            .additive     = layer.blend_mode == blend_mode_e::add ? 1.0F : 0.0F,
+            .texture_unit = static_cast<GLint>(unit - textures.begin()),
+        });
+    }
+
+    if (!instances->empty()) {
+        draw_batch({textures.data(), textures.size()});
+    }
+}
+
+void layer_compositor_s::draw_batch(std::span<texture_s* const> textures)
+{
+    // Orphan the previous contents so the upload does not wait for earlier draws
+    glNamedBufferData(instance_buffer_,
+                      static_cast<GLsizeiptr>(instances_.size() * sizeof(instance_s)),
+                      instances_.data(),
+                      GL_STREAM_DRAW);
+
+    for (size_t i = 0; i < textures.size(); ++i) {
+        textures[i]->bind(static_cast<GLuint>(i));
+    }
+    // The program can sample every unit, one left bound to a target drawn into
+    // now would be a feedback loop. Free when the units are already unbound.
+    for (size_t i = textures.size(); i < MAX_BATCH_TEXTURES; ++i) {
+        texture_s::unbind(static_cast<GLuint>(i));
+    }
+
+    // Other draws may have left blending off, layers rely on the premultiplied blend
+    context_s::current_state_cache().set_blend(true);
+    vertex_array_.bind();
+    shader_->use();
+    glDrawArraysInstanced(GL_TRIANGLES,
+                          0,
+                          static_cast<GLsizei>(full_screen_quad_verts_flip_uv.size()),
+                          static_cast<GLsizei>(instances_.size()));
+}
+
+} // namespace miximus::gpu
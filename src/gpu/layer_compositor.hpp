@@ -0,0 +1,90 @@
+#pragma once
+#include "geometry.hpp"
+#include "shader.hpp"
+#include "texture_fwd.hpp"
+#include "types.hpp"
+#include "vertex_array.hpp"
+#include "vertex_buffer.hpp"
+
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace miximus::gpu {
+
+/**
+ * Draws an ordered list of textured layers into the bound framebuffer with one
+ * shader and an instanced quad per layer. Layers are drawn bottom to top with
+ * premultiplied alpha blending.
+ *
+ * Every distinct texture in a draw call gets its own texture unit. Lists using
+ * more than MAX_BATCH_TEXTURES textures are split into several instanced draws
+ * without changing the drawing order.
+ */
+class layer_compositor_s
+{
+  public:
+    enum class blend_mode_e
+    {
+        normal,
+        add,
+    };
+
+    struct layer_s
+    {
+        texture_s*     texture{};
+        texture_draw_s draw;
+        double         opacity{1.0};
+        blend_mode_e   blend_mode{blend_mode_e::normal};
+    };
+
+    // Fragment shader texture units OpenGL 4 guarantees, must match layers.fs.glsl
+    static constexpr size_t MAX_BATCH_TEXTURES = 16;
+
+    // Per-instance vertex attributes, texture_unit indexes the textures of its batch
+    struct instance_s
+    {
+        glm::vec4 destination;
+        glm::vec4 source;
+        float     opacity;
+        float     additive;
+        GLint     texture_unit;
+    };
+
+    // Called once per draw with its textures, the instances are in the vector passed to build_batches()
+    using batch_callback_t = std::function<void(std::span<texture_s* const> textures)>;
+
+  private:
+    vertex_array_s          vertex_array_;
+    vertex_buffer_s         quad_buffer_;
+    GLuint                  instance_buffer_{};
+    shader_program_s*       shader_{};
+    std::vector<instance_s> instances_;
+
+    void draw_batch(std::span<texture_s* const> textures);
+
+  public:
+    explicit layer_compositor_s(shader_program_s* shader);
+    ~layer_compositor_s();
+
+    layer_compositor_s(const layer_compositor_s&)            = delete;
+    layer_compositor_s(layer_compositor_s&&)                 = delete;
+    layer_compositor_s& operator=(const layer_compositor_s&) = delete;
+    layer_compositor_s& operator=(layer_compositor_s&&)      = delete;
+
+    void draw(std::span<const layer_s> layers);
+
+    /**
+     * Split `layers` into the instanced draws draw() makes, skipping layers
+     * without a texture or opacity. `instances` holds the instances of the
+     * current draw when `draw_batch` is called.
+     */
+    static void build_batches(std::span<const layer_s> layers,
+                              std::vector<instance_s>* instances,
+                              const batch_callback_t&  draw_batch);
+};
+
+} // namespace miximus::gpu
@@ -0,0 +1,128 @@
+#include "gpu/memory_registry.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace miximus::gpu {
+namespace {
+
+void add_usage(memory_registry_s::usage_map_t& map, std::string_view key, size_t bytes)
+{
+    auto it = map.find(key);
+    if (it == map.end()) {
+        it = map.emplace(std::string(key), memory_registry_s::usage_s{}).first;
+    }
+    it->second.bytes += bytes;
+    ++it->second.allocations;
+}
+
+void remove_usage(memory_registry_s::usage_map_t& map, std::string_view key, size_t bytes) noexcept
+{
+    const auto it = map.find(key);
+    if (it == map.end()) {
+        return;
+    }
+    it->second.bytes -= std::min(bytes, it->second.bytes);
+    if (--it->second.allocations == 0) {
+        map.erase(it);
+    }
+}
+
+} // namespace
+
+memory_registry_s& memory_registry_s::global() noexcept
+{
+    static memory_registry_s registry;
+    return registry;
+}
+
+void memory_registry_s::add(std::string_view owner, std::string_view kind, size_t bytes)
+{
+    const std::scoped_lock lock(mutex_);
+    add_usage(owners_, owner, bytes);
+    add_usage(kinds_, kind, bytes);
+    total_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void memory_registry_s::remove(std::string_view owner, std::string_view kind, size_t bytes) noexcept
+{
+    const std::scoped_lock lock(mutex_);
+    remove_usage(owners_, owner, bytes);
+    remove_usage(kinds_, kind, bytes);
+    total_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void memory_registry_s::change_owner(std::string_view from, std::string_view to, size_t bytes)
+{
+    const std::scoped_lock lock(mutex_);
+    add_usage(owners_, to, bytes);
+    remove_usage(owners_, from, bytes);
+}
+
+bool memory_registry_s::has_room_for(size_t bytes) const noexcept
+{
+    const auto budget = budget_bytes_.load(std::memory_order_relaxed);
+    const auto total  = total_bytes_.load(std::memory_order_relaxed);
+    return budget == 0 || (bytes <= budget && total <= budget - bytes);
+}
+
+memory_registry_s::usage_map_t memory_registry_s::usage_by_owner() const
+{
+    const std::scoped_lock lock(mutex_);
+    return owners_;
+}
+
+memory_registry_s::usage_map_t memory_registry_s::usage_by_kind() const
+{
+    const std::scoped_lock lock(mutex_);
+    return kinds_;
+}
+
+memory_allocation_s::memory_allocation_s(std::string_view kind, size_t bytes, memory_registry_s& registry)
+    : registry_(&registry)
+    , owner_(memory_owner_scope_s::current())
+    , kind_(kind)
+    , bytes_(bytes)
+{
+    registry_->add(owner_, kind_, bytes_);
+}
+
+memory_allocation_s::~memory_allocation_s()
+{
+    if (registry_ != nullptr) {
+        registry_->remove(owner_, kind_, bytes_);
+    }
+}
+
+memory_allocation_s::memory_allocation_s(memory_allocation_s&& other) noexcept
+    : registry_(std::exchange(other.registry_, nullptr))
+    , owner_(std::move(other.owner_))
+    , kind_(other.kind_)
+    , bytes_(std::exchange(other.bytes_, 0))
+{
+}
+
+memory_allocation_s& memory_allocation_s::operator=(memory_allocation_s&& other) noexcept
+{
+    if (this != &other) {
+        if (registry_ != nullptr) {
+            registry_->remove(owner_, kind_, bytes_);
+        }
+        registry_ = std::exchange(other.registry_, nullptr);
+        owner_    = std::move(other.owner_);
+        kind_     = other.kind_;
+        bytes_    = std::exchange(other.bytes_, 0);
+    }
+    return *this;
+}
+
+void memory_allocation_s::set_owner(std::string_view owner)
+{
+    if (registry_ == nullptr || owner_ == owner) {
+        return;
+    }
+    registry_->change_owner(owner_, owner, bytes_);
+    owner_ = owner;
+}
+
+} // namespace miximus::gpu
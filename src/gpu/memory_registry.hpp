@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace miximus::gpu {
+
+/**
+ * Process-wide accounting of GPU memory held by textures and framebuffers.
+ *
+ * Every allocation is recorded under the node that owns it and a kind naming
+ * its format, so status can tell which node holds how much. The budget is
+ * advisory for allocations that cannot fail gracefully: caches consult it and
+ * release idle resources first, and transfer slots refuse to grow past it.
+ * A budget of zero means no limit. Safe to use from any thread.
+ */
+class memory_registry_s
+{
+  public:
+    struct usage_s
+    {
+        size_t bytes{};
+        size_t allocations{};
+    };
+
+    using usage_map_t = std::map<std::string, usage_s, std::less<>>;
+
+  private:
+    mutable std::mutex  mutex_;
+    usage_map_t         owners_;
+    usage_map_t         kinds_;
+    std::atomic<size_t> total_bytes_{0};
+    std::atomic<size_t> budget_bytes_{0};
+
+  public:
+    memory_registry_s() = default;
+
+    memory_registry_s(const memory_registry_s&)            = delete;
+    memory_registry_s(memory_registry_s&&)                 = delete;
+    memory_registry_s& operator=(const memory_registry_s&) = delete;
+    memory_registry_s& operator=(memory_registry_s&&)      = delete;
+
+    static memory_registry_s& global() noexcept;
+
+    void add(std::string_view owner, std::string_view kind, size_t bytes);
+    void remove(std::string_view owner, std::string_view kind, size_t bytes) noexcept;
+    void change_owner(std::string_view from, std::string_view to, size_t bytes);
+
+    void   set_budget(size_t bytes) noexcept { budget_bytes_.store(bytes, std::memory_order_relaxed); }
+    size_t budget() const noexcept { return budget_bytes_.load(std::memory_order_relaxed); }
+    size_t total_bytes() const noexcept { return total_bytes_.load(std::memory_order_relaxed); }
+    bool   has_room_for(size_t bytes) const noexcept;
+    bool   over_budget() const noexcept { return !has_room_for(0); }
+
+    usage_map_t usage_by_owner() const;
+    usage_map_t usage_by_kind() const;
+};
+
+/**
+ * One allocation recorded in a memory_registry_s for as long as it lives. The
+ * owner is taken from the memory_owner_scope_s of the allocating thread.
+ */
+class memory_allocation_s
+{
+    memory_registry_s* registry_{};
+    std::string        owner_;
+    std::string_view   kind_;
+    size_t             bytes_{};
+
+  public:
+    memory_allocation_s() = default;
+    // `kind` must outlive the allocation, callers pass string literals or enum names
+    memory_allocation_s(std::string_view kind, size_t bytes, memory_registry_s& registry = memory_registry_s::global());
+    ~memory_allocation_s();
+
+    memory_allocation_s(const memory_allocation_s&)            = delete;
+    memory_allocation_s& operator=(const memory_allocation_s&) = delete;
+    memory_allocation_s(memory_allocation_s&& other) noexcept;
+    memory_allocation_s& operator=(memory_allocation_s&& other) noexcept;
+
+    // Moves the allocation to another owner, for resources handed between nodes
+    void set_owner(std::string_view owner);
+
+    const std::string& owner() const noexcept { return owner_; }
+    size_t             bytes() const noexcept { return bytes_; }
+};
+
+/**
+ * Names the node GPU allocations made on this thread are accounted to until
+ * the scope ends. Scopes nest, the innermost one wins.
+ */
+class memory_owner_scope_s
+{
+    static inline thread_local std::string_view current_;
+
+    std::string_view previous_;
+
+  public:
+    explicit memory_owner_scope_s(std::string_view owner) noexcept
+        : previous_(current_)
+    {
+        current_ = owner;
+    }
+    ~memory_owner_scope_s() { current_ = previous_; }
+
+    memory_owner_scope_s(const memory_owner_scope_s&)            = delete;
+    memory_owner_scope_s(memory_owner_scope_s&&)                 = delete;
+    memory_owner_scope_s& operator=(const memory_owner_scope_s&) = delete;
+    memory_owner_scope_s& operator=(memory_owner_scope_s&&)      = delete;
+
+    // Empty outside of any scope, such allocations are shared by the application
+    static std::string_view current() noexcept { return current_; }
+};
+
+} // namespace miximus::gpu
@@ -1,11 +1,15 @@
 #include "gpu/shader.hpp"
 
 #include "gpu/context.hpp"
+#include "gpu/draw_parameters.hpp"
 #include "logger/logger.hpp"
 #include "static_files/files.hpp"
 
+#include <algorithm>
 #include <array>
 #include <format>
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -39,27 +43,87 @@ void maybe_throw_uniform_type_error(bool             type_matches,
 #endif
 }
 
-} // namespace
+template <typename T>
+struct uniform_type_info;
+
+template <>
+struct uniform_type_info<vec2_t>
+{
+    static constexpr std::string_view expected = "GL_FLOAT_VEC2";
+    static bool                       matches(GLenum type) { return type == GL_FLOAT_VEC2; }
+};
+
+template <>
+struct uniform_type_info<vec3_t>
+{
+    static constexpr std::string_view expected = "GL_FLOAT_VEC3";
+    static bool                       matches(GLenum type) { return type == GL_FLOAT_VEC3; }
+};
+
+template <>
+struct uniform_type_info<mat3>
+{
+    static constexpr std::string_view expected = "GL_FLOAT_MAT3";
+    static bool                       matches(GLenum type) { return type == GL_FLOAT_MAT3; }
+};
+
+template <>
+struct uniform_type_info<double>
+{
+    static constexpr std::string_view expected = "GL_FLOAT";
+    static bool                       matches(GLenum type) { return type == GL_FLOAT; }
+};
+
+template <>
+struct uniform_type_info<int>
+{
+    static constexpr std::string_view expected = "GL_INT, GL_BOOL, or GL_SAMPLER_2D";
+    static bool matches(GLenum type) { return type == GL_INT || type == GL_BOOL || type == GL_SAMPLER_2D; }
+};
+
+constexpr std::string_view version_text         = "#version 330 core\n";
+constexpr std::string_view compute_version_text = "#version 430 core\n";
+
+std::string_view gl_string(GLenum name)
+{
+    const auto* text = reinterpret_cast<const char*>(glGetString(name));
+    return text != nullptr ? std::string_view(text) : std::string_view();
+}
+
+// Program binaries are only valid for the driver that produced them
+std::string driver_identity()
+{
+    return std::format("{}\n{}\n{}", gl_string(GL_VENDOR), gl_string(GL_RENDERER), gl_string(GL_VERSION));
+}
+
+bool program_binaries_supported()
+{
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
 
 class shader_s
 {
     GLuint id_{0};
 
   public:
-    shader_s(std::string_view name, GLenum type)
+    shader_s(std::string_view name,
+             std::string_view version_text,
+             std::string_view common_text,
+             std::string_view shader_text,
+             GLenum           type)
         : id_(glCreateShader(type))
     {
-        const auto& files       = static_files::get_resource_files();
-        const auto  common_text = files.get_file_or_throw("shaders/common.glsl").unzip();
-        const auto  shader_text = files.get_file_or_throw(name).unzip();
-
-        const auto texts = std::array{
-            "#version 330 core\n",
-            common_text.c_str(),
-            shader_text.c_str(),
+        // The cached sources are not null terminated, so pass explicit lengths
+        const auto texts   = std::array{version_text.data(), common_text.data(), shader_text.data()};
+        const auto lengths = std::array{
+            static_cast<GLint>(version_text.size()),
+            static_cast<GLint>(common_text.size()),
+            static_cast<GLint>(shader_text.size()),
         };
 
-        glShaderSource(id_, static_cast<GLsizei>(texts.size()), texts.data(), nullptr);
+        glShaderSource(id_, static_cast<GLsizei>(texts.size()), texts.data(), lengths.data());
         glCompileShader(id_);
 
         GLint is_compiled = 0;
@@ -90,17 +154,112 @@ class shader_s
     GLuint id() const { return id_; }
 };
 
-shader_program_s::shader_program_s(std::string_view vert_name, std::string_view frag_name)
+} // namespace
+
+shader_program_s::shader_program_s(std::string_view             vert_name,
+                                   std::string_view             frag_name,
+                                   const shader_binary_cache_s* cache)
     : program_(glCreateProgram())
 {
-    auto log = getlog("gpu");
-    log->debug(R"(Compiling shader "{}"/"{}")", vert_name, frag_name);
+    const auto& files = static_files::get_resource_files();
+    create(
+        {
+            .version_text = version_text,
+            .common_text  = files.get_file_or_throw("shaders/common.glsl").contents(),
+            .stages       = {
+                {vert_name, files.get_file_or_throw(vert_name).contents(), GL_VERTEX_SHADER},
+                {frag_name, files.get_file_or_throw(frag_name).contents(), GL_FRAGMENT_SHADER},
+            },
+        },
+        cache);
+}
 
-    const shader_s vert(vert_name, GL_VERTEX_SHADER);
-    const shader_s frag(frag_name, GL_FRAGMENT_SHADER);
+shader_program_s::shader_program_s(std::string_view comp_name, const shader_binary_cache_s* cache)
+    : program_(glCreateProgram())
+{
+    const auto& files = static_files::get_resource_files();
+    create(
+        {
+            .version_text = compute_version_text,
+            .common_text  = files.get_file_or_throw("shaders/common.glsl").contents(),
+            .stages       = {
+                {comp_name, files.get_file_or_throw(comp_name).contents(), GL_COMPUTE_SHADER},
+            },
+        },
+        cache);
+    glGetProgramiv(program_, GL_COMPUTE_WORK_GROUP_SIZE, work_group_size_.data());
+}
+
+void shader_program_s::create(const sources_s& sources, const shader_binary_cache_s* cache)
+{
+    const auto name = sources.stages.back().name;
+
+    uint64_t key = 0;
+    if (cache != nullptr) {
+        std::vector<std::string_view> texts{sources.version_text, sources.common_text};
+        for (const auto& stage : sources.stages) {
+            texts.push_back(stage.text);
+        }
+        key = shader_binary_cache_s::make_key(driver_identity(), texts);
+    }
+
+    if (cache != nullptr && load_binary(*cache, key)) {
+        getlog("gpu")->debug(R"(Loaded shader "{}" from cache)", name);
+    } else {
+        const bool store = cache != nullptr && program_binaries_supported();
+        compile(sources, store);
+        if (store) {
+            store_binary(*cache, key);
+        }
+    }
+
+    collect_uniforms();
+    bind_uniform_blocks();
+}
+
+bool shader_program_s::load_binary(const shader_binary_cache_s& cache, uint64_t key)
+{
+    const auto binary = cache.load(key);
+    if (!binary) {
+        return false;
+    }
+
+    glProgramBinary(program_, binary->format, binary->data.data(), static_cast<GLsizei>(binary->data.size()));
 
-    glAttachShader(program_, vert.id());
-    glAttachShader(program_, frag.id());
+    // The driver may reject binaries it produced itself, e.g. after a
+    // configuration change, which leaves the program unlinked
+    GLint is_linked = 0;
+    glGetProgramiv(program_, GL_LINK_STATUS, &is_linked);
+    return is_linked != GL_FALSE;
+}
+
+void shader_program_s::store_binary(const shader_binary_cache_s& cache, uint64_t key) const
+{
+    GLint length = 0;
+    glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    shader_binary_cache_s::binary_s binary;
+    binary.data.resize(static_cast<size_t>(length));
+    glGetProgramBinary(program_, length, nullptr, &binary.format, binary.data.data());
+    cache.store(key, binary);
+}
+
+void shader_program_s::compile(const sources_s& sources, bool retrievable)
+{
+    std::vector<std::unique_ptr<shader_s>> shaders;
+    for (const auto& stage : sources.stages) {
+        getlog("gpu")->debug(R"(Compiling shader "{}")", stage.name);
+        shaders.push_back(
+            std::make_unique<shader_s>(stage.name, sources.version_text, sources.common_text, stage.text, stage.type));
+        glAttachShader(program_, shaders.back()->id());
+    }
+
+    if (retrievable) {
+        glProgramParameteri(program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
 
     glLinkProgram(program_);
 
@@ -118,6 +277,15 @@ shader_program_s::shader_program_s(std::string_view vert_name, std::string_view
         throw std::runtime_error(text.data());
     }
 
+    for (const auto& shader : shaders) {
+        glDetachShader(program_, shader->id());
+    }
+}
+
+void shader_program_s::collect_uniforms()
+{
+    auto log = getlog("gpu");
+
     GLint count = 0;
     glGetProgramiv(program_, GL_ACTIVE_UNIFORMS, &count);
     log->debug("Active Uniforms: {}", count);
@@ -152,11 +320,33 @@ shader_program_s::~shader_program_s()
         return;
     }
     glDeleteProgram(program_);
+    gl_state_cache_s::object_deleted();
 }
 
-void shader_program_s::use() const { glUseProgram(program_); }
+void shader_program_s::bind_uniform_blocks()
+{
+    // GLSL 3.30 cannot declare block bindings, and a program binary does not keep them
+    const auto index = glGetUniformBlockIndex(program_, DRAW_PARAMETERS_BLOCK);
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program_, index, DRAW_PARAMETERS_BINDING);
+    }
+}
 
-void shader_program_s::unuse() { glUseProgram(0); }
+void shader_program_s::use() const { context_s::current_state_cache().use_program(program_); }
+
+void shader_program_s::unuse() { context_s::current_state_cache().use_program(0); }
+
+void shader_program_s::dispatch(vec2i_t invocations) const
+{
+    const auto groups = [](int count, GLint size) {
+        return static_cast<GLuint>((count + std::max(size, 1) - 1) / std::max(size, 1));
+    };
+
+    use();
+    glDispatchCompute(groups(invocations.x, work_group_size_[0]), groups(invocations.y, work_group_size_[1]), 1);
+    // Consumers sample, blit, read back or share the results through CUDA or DVP
+    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+}
 
 const shader_program_s::uniform_s* shader_program_s::find_uniform(std::string_view name) const noexcept
 {
@@ -164,59 +354,106 @@ const shader_program_s::uniform_s* shader_program_s::find_uniform(std::string_vi
     return it != uniforms_.end() ? &it->second : nullptr;
 }
 
-bool shader_program_s::set_uniform(std::string_view name, const vec2_t& val)
+template <typename T>
+uniform_location_s<T> shader_program_s::get_uniform_location(std::string_view name) const
 {
-    if (const auto* uniform = find_uniform(name)) {
-        maybe_throw_uniform_type_error(
-            uniform->type == GL_FLOAT_VEC2, name, uniform->type, uniform->size, "GL_FLOAT_VEC2");
-        glProgramUniform2f(program_, uniform->location, static_cast<float>(val.x), static_cast<float>(val.y));
-        return true;
+    const auto* uniform = find_uniform(name);
+    if (uniform == nullptr) {
+        return {};
     }
-    return false;
+
+    const auto expected = uniform_type_info<T>::expected;
+    maybe_throw_uniform_type_error(
+        uniform_type_info<T>::matches(uniform->type), name, uniform->type, uniform->size, expected);
+    return uniform_location_s<T>(uniform->location);
 }
 
-bool shader_program_s::set_uniform(std::string_view name, const vec3_t& val)
+template uniform_location_s<vec2_t> shader_program_s::get_uniform_location(std::string_view name) const;
+template uniform_location_s<vec3_t> shader_program_s::get_uniform_location(std::string_view name) const;
+template uniform_location_s<mat3> shader_program_s::get_uniform_location(std::string_view name) const;
+template uniform_location_s<double> shader_program_s::get_uniform_location(std::string_view name) const;
+template uniform_location_s<int> shader_program_s::get_uniform_location(std::string_view name) const;
+
+void shader_program_s::set_uniform(uniform_location_s<vec2_t> location, const vec2_t& val)
 {
-    if (const auto* uniform = find_uniform(name)) {
-        maybe_throw_uniform_type_error(
-            uniform->type == GL_FLOAT_VEC3, name, uniform->type, uniform->size, "GL_FLOAT_VEC3");
-        glProgramUniform3f(program_, uniform->location, val.x, val.y, val.z);
-        return true;
+    if (location.valid()) {
+        glProgramUniform2f(program_, location.location_, static_cast<float>(val.x), static_cast<float>(val.y));
     }
-    return false;
 }
 
-bool shader_program_s::set_uniform(std::string_view name, const mat3& val)
+void shader_program_s::set_uniform(uniform_location_s<vec3_t> location, const vec3_t& val)
 {
-    if (const auto* uniform = find_uniform(name)) {
-        maybe_throw_uniform_type_error(
-            uniform->type == GL_FLOAT_MAT3, name, uniform->type, uniform->size, "GL_FLOAT_MAT3");
-        glProgramUniformMatrix3fv(program_, uniform->location, 1, GL_TRUE, &val[0][0]);
-        return true;
+    if (location.valid()) {
+        glProgramUniform3f(program_, location.location_, val.x, val.y, val.z);
     }
-    return false;
 }
 
-bool shader_program_s::set_uniform(std::string_view name, double val)
+void shader_program_s::set_uniform(uniform_location_s<mat3> location, const mat3& val)
 {
-    if (const auto* uniform = find_uniform(name)) {
-        maybe_throw_uniform_type_error(uniform->type == GL_FLOAT, name, uniform->type, uniform->size, "GL_FLOAT");
-        glProgramUniform1f(program_, uniform->location, static_cast<float>(val));
-        return true;
+    if (location.valid()) {
+        glProgramUniformMatrix3fv(program_, location.location_, 1, GL_TRUE, &val[0][0]);
+    }
+}
+
+void shader_program_s::set_uniform(uniform_location_s<double> location, double val)
+{
+    if (location.valid()) {
+        glProgramUniform1f(program_, location.location_, static_cast<float>(val));
     }
-    return false;
+}
+
+void shader_program_s::set_uniform(uniform_location_s<int> location, int val)
+{
+    if (location.valid()) {
+        glProgramUniform1i(program_, location.location_, val);
+    }
+}
+
+bool shader_program_s::set_uniform(std::string_view name, const vec2_t& val)
+{
+    const auto location = get_uniform_location<vec2_t>(name);
+    set_uniform(location, val);
+    return location.valid();
+}
+
+bool shader_program_s::set_uniform(std::string_view name, const vec3_t& val)
+{
+    const auto location = get_uniform_location<vec3_t>(name);
+    set_uniform(location, val);
+    return location.valid();
+}
+
+bool shader_program_s::set_uniform(std::string_view name, const mat3& val)
+{
+    const auto location = get_uniform_location<mat3>(name);
+    set_uniform(location, val);
+    return location.valid();
+}
+
+bool shader_program_s::set_uniform(std::string_view name, double val)
+{
+    const auto location = get_uniform_location<double>(name);
+    set_uniform(location, val);
+    return location.valid();
 }
 
 bool shader_program_s::set_uniform(std::string_view name, int val)
+{
+    const auto location = get_uniform_location<int>(name);
+    set_uniform(location, val);
+    return location.valid();
+}
+
+bool shader_program_s::set_uniform(std::string_view name, std::span<const GLint> vals)
 {
     if (const auto* uniform = find_uniform(name)) {
-        maybe_throw_uniform_type_error(uniform->type == GL_INT || uniform->type == GL_BOOL ||
-                                           uniform->type == GL_SAMPLER_2D,
+        maybe_throw_uniform_type_error((uniform->type == GL_INT || uniform->type == GL_SAMPLER_2D) &&
+                                           std::cmp_less_equal(vals.size(), uniform->size),
                                        name,
                                        uniform->type,
                                        uniform->size,
-                                       "GL_INT, GL_BOOL, or GL_SAMPLER_2D");
-        glProgramUniform1i(program_, uniform->location, val);
+                                       "GL_INT or GL_SAMPLER_2D array");
+        glProgramUniform1iv(program_, uniform->location, static_cast<GLsizei>(vals.size()), vals.data());
         return true;
     }
     return false;
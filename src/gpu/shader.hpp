@@ -1,14 +1,45 @@
 #pragma once
 #include "gpu/glad.hpp"
+#include "gpu/shader_binary_cache.hpp"
 #include "gpu/types.hpp"
 #include "utils/transparent_string_hash.hpp"
 
+#include <array>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace miximus::gpu {
 
+class shader_program_s;
+
+/**
+ * A uniform location resolved once, typically right after the program is
+ * created. Setting a uniform through it skips the name lookup and the type
+ * validation set_uniform() does by name. Locations of missing uniforms are
+ * invalid and setting them does nothing.
+ */
+template <typename T>
+class uniform_location_s
+{
+    GLint location_{-1};
+
+    explicit uniform_location_s(GLint location)
+        : location_(location)
+    {
+    }
+
+    friend class shader_program_s;
+
+  public:
+    uniform_location_s() = default;
+
+    bool valid() const noexcept { return location_ != -1; }
+};
+
 class shader_program_s
 {
     struct uniform_s
@@ -20,10 +51,31 @@ class shader_program_s
 
     using uniform_map_t = std::unordered_map<std::string, uniform_s, utils::transparent_string_hash, std::equal_to<>>;
 
-    GLuint        program_;
-    uniform_map_t uniforms_;
+    struct stage_s
+    {
+        std::string_view name;
+        std::string_view text;
+        GLenum           type;
+    };
+
+    struct sources_s
+    {
+        std::string_view     version_text;
+        std::string_view     common_text;
+        std::vector<stage_s> stages;
+    };
 
+    GLuint               program_;
+    uniform_map_t        uniforms_;
+    std::array<GLint, 3> work_group_size_{};
+
+    void             create(const sources_s& sources, const shader_binary_cache_s* cache);
+    bool             load_binary(const shader_binary_cache_s& cache, uint64_t key);
+    void             store_binary(const shader_binary_cache_s& cache, uint64_t key) const;
+    void             compile(const sources_s& sources, bool retrievable);
+    void             collect_uniforms();
     const uniform_s* find_uniform(std::string_view name) const noexcept;
+    void             bind_uniform_blocks();
 
   public:
     enum name_e
@@ -31,13 +83,27 @@ class shader_program_s
         basic,
         texture_mix,
         yuv_to_rgb,
+        uyvy_to_rgb,
+        p216_to_rgb,
         rgb_to_yuv,
         apply_gamma,
         encode_rec709_premultiplied,
         strip_gamma,
+        rgb_to_uyvy,
+        rgb_to_nv12,
+        rgb_to_p216,
+        layer_composite,
+        yuv_to_rgb_compute,
+        rgb_to_yuv_compute,
     };
 
-    shader_program_s(std::string_view vert_name, std::string_view frag_name);
+    // Loads the linked program from `cache` when it holds a binary for the same
+    // sources and driver, and stores newly linked programs in it
+    shader_program_s(std::string_view             vert_name,
+                     std::string_view             frag_name,
+                     const shader_binary_cache_s* cache = nullptr);
+    // A compute program, which needs GLSL 4.30 where the others use 3.30
+    explicit shader_program_s(std::string_view comp_name, const shader_binary_cache_s* cache = nullptr);
     ~shader_program_s();
 
     shader_program_s(const shader_program_s&) = delete;
@@ -49,11 +115,28 @@ class shader_program_s
     static void unuse();
     GLuint      get_id() { return program_; }
 
+    // Runs a compute program with at least one invocation per element of
+    // `invocations`, then makes its writes visible to all later GL commands
+    void dispatch(vec2i_t invocations) const;
+
+    // Validates the uniform type against T in builds with uniform validation
+    template <typename T>
+    uniform_location_s<T> get_uniform_location(std::string_view name) const;
+
+    void set_uniform(uniform_location_s<vec2_t> location, const vec2_t& val);
+    void set_uniform(uniform_location_s<vec3_t> location, const vec3_t& val);
+    void set_uniform(uniform_location_s<mat3> location, const mat3& val);
+    void set_uniform(uniform_location_s<double> location, double val);
+    void set_uniform(uniform_location_s<int> location, int val);
+
     bool set_uniform(std::string_view name, const vec2_t& val);
     bool set_uniform(std::string_view name, const vec3_t& val);
     bool set_uniform(std::string_view name, const mat3& val);
     bool set_uniform(std::string_view name, double val);
     bool set_uniform(std::string_view name, int val);
+    // Sets consecutive elements of an int or sampler array, `name` is the
+    // first element as OpenGL reports it, e.g. "textures[0]"
+    bool set_uniform(std::string_view name, std::span<const GLint> vals);
 };
 
 } // namespace miximus::gpu
@@ -0,0 +1,150 @@
+#include "gpu/shader_binary_cache.hpp"
+
+#include "logger/logger.hpp"
+#include "utils/filesystem.hpp"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace miximus::gpu {
+namespace {
+
+constexpr uint32_t CACHE_MAGIC   = 0x5342'584D; // "MXBS"
+constexpr uint32_t CACHE_VERSION = 1;
+
+constexpr uint64_t FNV_OFFSET = 14'695'981'039'346'656'037ULL;
+constexpr uint64_t FNV_PRIME  = 1'099'511'628'211ULL;
+
+struct file_header_s
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t reserved;
+    uint64_t size;
+    uint64_t checksum;
+};
+
+const auto _log = [] { return getlog("gpu"); };
+
+uint64_t fnv1a(uint64_t hash, std::span<const std::byte> bytes) noexcept
+{
+    for (const auto byte : bytes) {
+        hash ^= std::to_integer<uint8_t>(byte);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t fnv1a(uint64_t hash, std::string_view text) noexcept { return fnv1a(hash, std::as_bytes(std::span{text})); }
+
+} // namespace
+
+shader_binary_cache_s::shader_binary_cache_s(std::filesystem::path directory)
+    : directory_(std::move(directory))
+{
+}
+
+uint64_t shader_binary_cache_s::make_key(std::string_view driver, std::span<const std::string_view> sources) noexcept
+{
+    // Every part is followed by its length so moving text from one source to
+    // the next changes the key
+    auto key = fnv1a(FNV_OFFSET, driver);
+    key      = (key ^ driver.size()) * FNV_PRIME;
+    for (const auto source : sources) {
+        key = fnv1a(key, source);
+        key = (key ^ source.size()) * FNV_PRIME;
+    }
+    return key;
+}
+
+std::filesystem::path shader_binary_cache_s::entry_path(uint64_t key) const
+{
+    return directory_ / std::format("{:016x}.bin", key);
+}
+
+std::optional<shader_binary_cache_s::binary_s> shader_binary_cache_s::load(uint64_t key) const
+{
+    const auto    path = entry_path(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    std::error_code error;
+    const auto      file_size = std::filesystem::file_size(path, error);
+
+    // Check the size against the file before allocating for it
+    file_header_s header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || error || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.key != key ||
+        header.size != file_size - sizeof(header)) {
+        _log()->debug("Ignoring invalid shader cache entry {}", utils::path_to_utf8(path));
+        return std::nullopt;
+    }
+
+    binary_s binary{.format = static_cast<GLenum>(header.format), .data = {}};
+    binary.data.resize(static_cast<size_t>(header.size));
+    file.read(reinterpret_cast<char*>(binary.data.data()), static_cast<std::streamsize>(binary.data.size()));
+
+    if (!file || fnv1a(FNV_OFFSET, binary.data) != header.checksum) {
+        _log()->debug("Ignoring damaged shader cache entry {}", utils::path_to_utf8(path));
+        return std::nullopt;
+    }
+
+    return binary;
+}
+
+void shader_binary_cache_s::store(uint64_t key, const binary_s& binary) const
+{
+    const auto path = entry_path(key);
+
+    // Several contexts can link the same program at once, so every writer gets
+    // its own temporary file and the last rename wins
+    auto temp_path = path;
+    temp_path += std::format(".{:x}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error) {
+        _log()->warn(
+            "Failed to create shader cache directory {}: {}", utils::path_to_utf8(directory_), error.message());
+        return;
+    }
+
+    const file_header_s header{
+        .magic    = CACHE_MAGIC,
+        .version  = CACHE_VERSION,
+        .key      = key,
+        .format   = static_cast<uint32_t>(binary.format),
+        .reserved = 0,
+        .size     = binary.data.size(),
+        .checksum = fnv1a(FNV_OFFSET, binary.data),
+    };
+
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(binary.data.data()), static_cast<std::streamsize>(binary.data.size()));
+        file.close();
+        if (!file) {
+            std::filesystem::remove(temp_path, error);
+            _log()->warn("Failed to write shader cache entry {}", utils::path_to_utf8(temp_path));
+            return;
+        }
+    }
+
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        _log()->warn("Failed to replace shader cache entry {}: {}", utils::path_to_utf8(path), error.message());
+        std::filesystem::remove(temp_path, error);
+    }
+}
+
+} // namespace miximus::gpu
@@ -0,0 +1,49 @@
+#pragma once
+#include "gpu/glad.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace miximus::gpu {
+
+/**
+ * Linked shader programs saved with glGetProgramBinary, one file per program.
+ *
+ * Entries are keyed by a hash of the driver identification and every source
+ * text that went into the program, so a driver update or an edited shader
+ * simply misses and the program is compiled again. Damaged or foreign files
+ * are treated as misses too. Loading and storing may be called concurrently
+ * from several render threads.
+ */
+class shader_binary_cache_s
+{
+  public:
+    struct binary_s
+    {
+        GLenum                 format{};
+        std::vector<std::byte> data;
+    };
+
+  private:
+    std::filesystem::path directory_;
+
+    std::filesystem::path entry_path(uint64_t key) const;
+
+  public:
+    explicit shader_binary_cache_s(std::filesystem::path directory);
+
+    static uint64_t make_key(std::string_view driver, std::span<const std::string_view> sources) noexcept;
+
+    const std::filesystem::path& directory() const noexcept { return directory_; }
+
+    std::optional<binary_s> load(uint64_t key) const;
+    // Failures are logged, a cache that cannot be written only costs startup time
+    void store(uint64_t key, const binary_s& binary) const;
+};
+
+} // namespace miximus::gpu
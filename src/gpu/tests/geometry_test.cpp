@@ -0,0 +1,47 @@
+#include "gpu/geometry.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+using namespace miximus;
+using namespace miximus::gpu;
+
+TEST(TextureDrawMinifies, FullTargetDrawsAtSourceSizeDoNotMinify)
+{
+    EXPECT_FALSE(texture_draw_minifies({}, {1920, 1080}, {1920, 1080}));
+    EXPECT_FALSE(texture_draw_minifies({}, {1280, 720}, {1920, 1080}));
+}
+
+TEST(TextureDrawMinifies, SmallerTargetsMinify)
+{
+    EXPECT_TRUE(texture_draw_minifies({}, {3840, 2160}, {1920, 1080}));
+    EXPECT_TRUE(texture_draw_minifies({}, {1920, 1081}, {1920, 1079}));
+}
+
+TEST(TextureDrawMinifies, BoxesAndCropsScaleTheComparedRegions)
+{
+    const texture_draw_s quarter_box{.destination = {.pos = {0.5, 0.5}, .size = {0.5, 0.5}}};
+    EXPECT_TRUE(texture_draw_minifies(quarter_box, {1920, 1080}, {1920, 1080}));
+
+    // A half-size crop of a 2x source fills the box at its own pixel size
+    const texture_draw_s cropped{
+        .destination = {.pos = {0.0, 0.0}, .size = {0.5, 0.5}},
+        .source      = {.pos = {0.25, 0.25}, .size = {0.5, 0.5}},
+    };
+    EXPECT_FALSE(texture_draw_minifies(cropped, {1920, 1080}, {1920, 1080}));
+}
+
+TEST(TextureDrawMinifies, FlippedDrawsCompareMagnitudes)
+{
+    const texture_draw_s flipped{.destination = {.pos = {0.0, 1.0}, .size = {1.0, -1.0}}};
+    EXPECT_FALSE(texture_draw_minifies(flipped, {1920, 1080}, {1920, 1080}));
+    EXPECT_TRUE(texture_draw_minifies(flipped, {1920, 1080}, {960, 540}));
+}
+
+TEST(TextureDrawMinifies, RoundingBelowHalfAPixelIsIgnored)
+{
+    const texture_draw_s almost_full{.destination = {.pos = {0.0, 0.0}, .size = {0.9999, 0.9999}}};
+    EXPECT_FALSE(texture_draw_minifies(almost_full, {1920, 1080}, {1920, 1080}));
+}
+
+} // namespace
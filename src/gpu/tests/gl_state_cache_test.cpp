@@ -0,0 +1,60 @@
+#include "gpu/gl_state_cache.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+using namespace miximus::gpu;
+using pixel_store_e = gl_state_cache_s::pixel_store_e;
+
+TEST(GlStateCache, SkipsRebindingTheBoundTexture)
+{
+    gl_state_cache_s cache;
+    EXPECT_FALSE(cache.track_texture(0, 0));
+    EXPECT_TRUE(cache.track_texture(0, 7));
+    EXPECT_FALSE(cache.track_texture(0, 7));
+    EXPECT_TRUE(cache.track_texture(1, 7));
+    EXPECT_TRUE(cache.track_texture(0, 0));
+}
+
+TEST(GlStateCache, PassesThroughUnitsItDoesNotTrack)
+{
+    gl_state_cache_s cache;
+    const auto       unit = static_cast<GLuint>(gl_state_cache_s::MAX_TEXTURE_UNITS);
+    EXPECT_TRUE(cache.track_texture(unit, 3));
+    EXPECT_TRUE(cache.track_texture(unit, 3));
+}
+
+TEST(GlStateCache, ForgetsBindingsWhenAnObjectIsDeleted)
+{
+    gl_state_cache_s cache;
+    EXPECT_TRUE(cache.track_texture(0, 7));
+    EXPECT_TRUE(cache.track_program(4));
+    EXPECT_TRUE(cache.track_vertex_array(2));
+
+    // Names are reused after deletion, so the same name may be a new object
+    gl_state_cache_s::object_deleted();
+    EXPECT_TRUE(cache.track_texture(0, 7));
+    EXPECT_TRUE(cache.track_program(4));
+    EXPECT_TRUE(cache.track_vertex_array(2));
+
+    EXPECT_FALSE(cache.track_texture(0, 7));
+    EXPECT_FALSE(cache.track_program(4));
+    EXPECT_FALSE(cache.track_vertex_array(2));
+}
+
+TEST(GlStateCache, StartsFromTheGlDefaults)
+{
+    gl_state_cache_s cache;
+    EXPECT_FALSE(cache.track_blend(true));
+    EXPECT_TRUE(cache.track_blend(false));
+    EXPECT_FALSE(cache.track_blend(false));
+
+    EXPECT_FALSE(cache.track_pixel_store(pixel_store_e::unpack_row_length, 0));
+    EXPECT_FALSE(cache.track_pixel_store(pixel_store_e::unpack_alignment, 4));
+    EXPECT_FALSE(cache.track_pixel_store(pixel_store_e::pack_alignment, 4));
+    EXPECT_TRUE(cache.track_pixel_store(pixel_store_e::pack_row_length, 1920));
+    EXPECT_FALSE(cache.track_pixel_store(pixel_store_e::pack_row_length, 1920));
+    EXPECT_FALSE(cache.track_pixel_store(pixel_store_e::unpack_row_length, 0));
+}
+
+} // namespace
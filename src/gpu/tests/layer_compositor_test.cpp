@@ -0,0 +1,106 @@
+#include "gpu/layer_compositor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace {
+using namespace miximus::gpu;
+using layer_s      = layer_compositor_s::layer_s;
+using instance_s   = layer_compositor_s::instance_s;
+using blend_mode_e = layer_compositor_s::blend_mode_e;
+
+// Batching only compares texture pointers, so these are never dereferenced
+texture_s* fake_texture(size_t index)
+{
+    return reinterpret_cast<texture_s*>(static_cast<uintptr_t>(0x1000 + (index * 0x100)));
+}
+
+struct batch_s
+{
+    std::vector<texture_s*> textures;
+    std::vector<instance_s> instances;
+};
+
+std::vector<batch_s> build_batches(std::span<const layer_s> layers)
+{
+    std::vector<batch_s>    batches;
+    std::vector<instance_s> instances;
+    layer_compositor_s::build_batches(layers, &instances, [&](std::span<texture_s* const> textures) {
+        batches.push_back({.textures = {textures.begin(), textures.end()}, .instances = instances});
+    });
+    return batches;
+}
+
+TEST(LayerCompositor, SharesATextureUnitBetweenLayersOfTheSameTexture)
+{
+    const std::vector<layer_s> layers{
+        {.texture = fake_texture(0)},
+        {.texture = fake_texture(1)},
+        {.texture = fake_texture(0), .opacity = 0.5, .blend_mode = blend_mode_e::add},
+    };
+
+    const auto batches = build_batches(layers);
+    ASSERT_EQ(batches.size(), 1U);
+    EXPECT_EQ(batches[0].textures, (std::vector{fake_texture(0), fake_texture(1)}));
+
+    const auto& instances = batches[0].instances;
+    ASSERT_EQ(instances.size(), 3U);
+    EXPECT_EQ(instances[0].texture_unit, 0);
+    EXPECT_EQ(instances[1].texture_unit, 1);
+    EXPECT_EQ(instances[2].texture_unit, 0);
+    EXPECT_FLOAT_EQ(instances[2].opacity, 0.5F);
+    EXPECT_FLOAT_EQ(instances[2].additive, 1.0F);
+    EXPECT_FLOAT_EQ(instances[0].additive, 0.0F);
+}
+
+TEST(LayerCompositor, SkipsLayersWithoutTextureOrOpacity)
+{
+    const std::vector<layer_s> layers{
+        {.texture = nullptr},
+        {.texture = fake_texture(0), .opacity = 0.0},
+        {.texture = fake_texture(1)},
+    };
+
+    const auto batches = build_batches(layers);
+    ASSERT_EQ(batches.size(), 1U);
+    EXPECT_EQ(batches[0].textures, std::vector{fake_texture(1)});
+    EXPECT_EQ(batches[0].instances.size(), 1U);
+
+    EXPECT_TRUE(build_batches(std::span<const layer_s>{}).empty());
+}
+
+TEST(LayerCompositor, SplitsBatchesAtTheTextureLimitInDrawingOrder)
+{
+    constexpr auto       limit = layer_compositor_s::MAX_BATCH_TEXTURES;
+    std::vector<layer_s> layers;
+    for (size_t i = 0; i <= limit; ++i) {
+        layers.push_back({
+            .texture = fake_texture(i),
+            .draw    = {.destination = {.pos = {static_cast<double>(i), 0.0}}},
+        });
+    }
+    // Reusing a texture of the first batch after the split needs a unit in the second one
+    layers.push_back({.texture = fake_texture(0)});
+
+    const auto batches = build_batches(layers);
+    ASSERT_EQ(batches.size(), 2U);
+    ASSERT_EQ(batches[0].textures.size(), limit);
+    ASSERT_EQ(batches[0].instances.size(), limit);
+    for (size_t i = 0; i < limit; ++i) {
+        EXPECT_EQ(batches[0].textures[i], fake_texture(i));
+        EXPECT_EQ(batches[0].instances[i].texture_unit, static_cast<GLint>(i));
+        EXPECT_FLOAT_EQ(batches[0].instances[i].destination.x, static_cast<float>(i));
+    }
+
+    EXPECT_EQ(batches[1].textures, (std::vector{fake_texture(limit), fake_texture(0)}));
+    ASSERT_EQ(batches[1].instances.size(), 2U);
+    EXPECT_FLOAT_EQ(batches[1].instances[0].destination.x, static_cast<float>(limit));
+    EXPECT_EQ(batches[1].instances[0].texture_unit, 0);
+    EXPECT_EQ(batches[1].instances[1].texture_unit, 1);
+}
+
+} // namespace
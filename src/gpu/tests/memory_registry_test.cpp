@@ -0,0 +1,83 @@
+#include "gpu/memory_registry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <utility>
+
+namespace {
+using namespace miximus::gpu;
+
+TEST(MemoryRegistry, AccountsAllocationsToTheScopedOwner)
+{
+    memory_registry_s registry;
+    {
+        const memory_owner_scope_s owner("node_a");
+        const memory_allocation_s  texture("rgba_f16", 1000, registry);
+        const memory_allocation_s  depth("depth24_stencil8", 200, registry);
+
+        const auto usage = registry.usage_by_owner();
+        ASSERT_TRUE(usage.contains("node_a"));
+        EXPECT_EQ(usage.at("node_a").bytes, 1200U);
+        EXPECT_EQ(usage.at("node_a").allocations, 2U);
+        EXPECT_EQ(registry.usage_by_kind().at("rgba_f16").bytes, 1000U);
+        EXPECT_EQ(registry.total_bytes(), 1200U);
+    }
+
+    EXPECT_EQ(registry.total_bytes(), 0U);
+    EXPECT_TRUE(registry.usage_by_owner().empty());
+    EXPECT_TRUE(registry.usage_by_kind().empty());
+}
+
+TEST(MemoryRegistry, NestedScopesRestoreTheOuterOwner)
+{
+    EXPECT_TRUE(memory_owner_scope_s::current().empty());
+    {
+        const memory_owner_scope_s outer("outer");
+        {
+            const memory_owner_scope_s inner("inner");
+            EXPECT_EQ(memory_owner_scope_s::current(), "inner");
+        }
+        EXPECT_EQ(memory_owner_scope_s::current(), "outer");
+    }
+    EXPECT_TRUE(memory_owner_scope_s::current().empty());
+}
+
+TEST(MemoryRegistry, MovesAllocationsBetweenOwners)
+{
+    memory_registry_s   registry;
+    memory_allocation_s allocation("rgba_f16", 500, registry);
+    EXPECT_EQ(registry.usage_by_owner().at("").bytes, 500U);
+
+    allocation.set_owner("node_b");
+    const auto usage = registry.usage_by_owner();
+    EXPECT_FALSE(usage.contains(""));
+    EXPECT_EQ(usage.at("node_b").bytes, 500U);
+    EXPECT_EQ(registry.total_bytes(), 500U);
+
+    auto moved = std::move(allocation);
+    EXPECT_EQ(moved.owner(), "node_b");
+    EXPECT_EQ(registry.total_bytes(), 500U);
+
+    moved = memory_allocation_s();
+    EXPECT_EQ(registry.total_bytes(), 0U);
+}
+
+TEST(MemoryRegistry, ZeroBudgetIsUnlimited)
+{
+    memory_registry_s         registry;
+    const memory_allocation_s allocation("rgba_f16", 1000, registry);
+
+    EXPECT_TRUE(registry.has_room_for(1'000'000));
+    EXPECT_FALSE(registry.over_budget());
+
+    registry.set_budget(1500);
+    EXPECT_TRUE(registry.has_room_for(500));
+    EXPECT_FALSE(registry.has_room_for(501));
+    EXPECT_FALSE(registry.over_budget());
+
+    registry.set_budget(800);
+    EXPECT_TRUE(registry.over_budget());
+    EXPECT_FALSE(registry.has_room_for(0));
+}
+
+} // namespace
@@ -0,0 +1,87 @@
+#include "gpu/transfer/readback_wire_format.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace {
+using namespace miximus::gpu;
+using namespace miximus::gpu::transfer;
+using pixel_format_e = texture_s::pixel_format_e;
+
+TEST(ReadbackWireFormat, LaysOutUyvyAsFourBytesPerPixelPair)
+{
+    const auto layout = make_wire_transfer_layout(readback_wire_format_e::uyvy_u8, {1920, 1080});
+    EXPECT_EQ(layout.pixel_format, pixel_format_e::packed_u8);
+    EXPECT_EQ(layout.dimensions, (vec2i_t{960, 1080}));
+    EXPECT_EQ(layout.host_row_stride_bytes, 3840U);
+    EXPECT_EQ(layout.host_buffer_size_bytes, 3840U * 1080U);
+}
+
+TEST(ReadbackWireFormat, PadsV210RowsTo128Bytes)
+{
+    // 48 pixels fill exactly 128 bytes
+    const auto full = make_wire_transfer_layout(readback_wire_format_e::v210, {1920, 1080});
+    EXPECT_EQ(full.pixel_format, pixel_format_e::uyuv_u10);
+    EXPECT_EQ(full.host_row_stride_bytes, 5120U);
+    EXPECT_EQ(full.dimensions, (vec2i_t{1280, 1080}));
+
+    // 1280 pixels take 214 groups of 16 bytes, which round up to 27 blocks of 128
+    const auto padded = make_wire_transfer_layout(readback_wire_format_e::v210, {1280, 720});
+    EXPECT_EQ(padded.host_row_stride_bytes, 3456U);
+    EXPECT_EQ(padded.dimensions, (vec2i_t{864, 720}));
+    EXPECT_EQ(padded.host_buffer_size_bytes, 3456U * 720U);
+
+    const auto narrow = make_wire_transfer_layout(readback_wire_format_e::v210, {2, 1});
+    EXPECT_EQ(narrow.host_row_stride_bytes, 128U);
+}
+
+TEST(ReadbackWireFormat, StacksPlanesBelowTheLumaRows)
+{
+    const auto nv12 = make_wire_transfer_layout(readback_wire_format_e::nv12, {1920, 1080});
+    EXPECT_EQ(nv12.pixel_format, pixel_format_e::packed_u8);
+    EXPECT_EQ(nv12.host_row_stride_bytes, 1920U);
+    EXPECT_EQ(nv12.dimensions, (vec2i_t{480, 1620}));
+    EXPECT_EQ(nv12.host_buffer_size_bytes, 1920U * 1620U);
+
+    const auto p216 = make_wire_transfer_layout(readback_wire_format_e::p216, {1920, 1080});
+    EXPECT_EQ(p216.pixel_format, pixel_format_e::packed_u16);
+    EXPECT_EQ(p216.host_row_stride_bytes, 3840U);
+    EXPECT_EQ(p216.dimensions, (vec2i_t{480, 2160}));
+    EXPECT_EQ(p216.host_buffer_size_bytes, 3840U * 2160U);
+}
+
+TEST(ReadbackWireFormat, KeepsDeviceRowStrides)
+{
+    // Only v210 renders into the padding, the other formats leave it untouched
+    const auto uyvy = make_wire_transfer_layout(readback_wire_format_e::uyvy_u8, {1920, 1080}, 4096);
+    EXPECT_EQ(uyvy.host_row_stride_bytes, 4096U);
+    EXPECT_EQ(uyvy.dimensions.x, 960);
+    EXPECT_EQ(uyvy.host_buffer_size_bytes, 4096U * 1080U);
+
+    const auto v210 = make_wire_transfer_layout(readback_wire_format_e::v210, {1920, 1080}, 5376);
+    EXPECT_EQ(v210.dimensions.x, 1344);
+
+    // Narrower than a row, or not a whole number of texels
+    for (const size_t stride : {3836, 3842}) {
+        EXPECT_THROW(make_wire_transfer_layout(readback_wire_format_e::uyvy_u8, {1920, 1080}, stride),
+                     std::invalid_argument);
+    }
+}
+
+TEST(ReadbackWireFormat, RejectsDimensionsTheFormatCannotSubsample)
+{
+    for (const auto format : {readback_wire_format_e::uyvy_u8,
+                              readback_wire_format_e::v210,
+                              readback_wire_format_e::nv12,
+                              readback_wire_format_e::p216}) {
+        EXPECT_THROW(make_wire_transfer_layout(format, {1281, 720}), std::invalid_argument);
+        EXPECT_THROW(make_wire_transfer_layout(format, {0, 720}), std::invalid_argument);
+    }
+    EXPECT_THROW(make_wire_transfer_layout(readback_wire_format_e::nv12, {1920, 1081}), std::invalid_argument);
+    EXPECT_THROW(make_wire_transfer_layout(readback_wire_format_e::p216, {1922, 1080}), std::invalid_argument);
+    EXPECT_THROW(make_wire_transfer_layout(readback_wire_format_e::texture, {1920, 1080}), std::invalid_argument);
+}
+
+} // namespace
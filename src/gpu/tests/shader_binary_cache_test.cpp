@@ -0,0 +1,99 @@
+#include "gpu/shader_binary_cache.hpp"
+#include "logger/logger.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace {
+using namespace miximus;
+
+class ShaderBinaryCache : public ::testing::Test
+{
+  protected:
+    std::filesystem::path directory_;
+
+    static void SetUpTestSuite()
+    {
+        // The cache logs rejected entries
+        if (getlog("gpu") == nullptr) {
+            logger::init_loggers(spdlog::level::off);
+        }
+    }
+
+    void SetUp() override
+    {
+        const auto suffix = std::chrono::steady_clock::now().time_since_epoch().count();
+        directory_ = std::filesystem::temp_directory_path() / ("miximus_shader_cache_test_" + std::to_string(suffix));
+    }
+
+    void TearDown() override
+    {
+        std::error_code ignored;
+        std::filesystem::remove_all(directory_, ignored);
+    }
+
+    static gpu::shader_binary_cache_s::binary_s make_binary()
+    {
+        return {
+            .format = 0x1234,
+            .data   = {std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}, std::byte{5}},
+        };
+    }
+};
+
+TEST_F(ShaderBinaryCache, RoundTripsStoredBinary)
+{
+    const gpu::shader_binary_cache_s cache(directory_);
+    const auto                       binary = make_binary();
+
+    cache.store(42, binary);
+    const auto loaded = cache.load(42);
+
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->format, binary.format);
+    EXPECT_EQ(loaded->data, binary.data);
+    EXPECT_FALSE(cache.load(43).has_value());
+}
+
+TEST_F(ShaderBinaryCache, IgnoresDamagedEntries)
+{
+    const gpu::shader_binary_cache_s cache(directory_);
+    cache.store(42, make_binary());
+
+    const auto entry = *std::filesystem::directory_iterator(directory_);
+    const auto size  = std::filesystem::file_size(entry.path());
+    {
+        std::fstream file(entry.path(), std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(size - 1));
+        file.put('\x7f');
+    }
+    EXPECT_FALSE(cache.load(42).has_value());
+
+    std::filesystem::resize_file(entry.path(), size - 2);
+    EXPECT_FALSE(cache.load(42).has_value());
+
+    // A new store replaces the damaged entry
+    cache.store(42, make_binary());
+    EXPECT_TRUE(cache.load(42).has_value());
+}
+
+TEST_F(ShaderBinaryCache, KeysDependOnDriverAndEverySource)
+{
+    constexpr std::array<std::string_view, 2> sources{"void main() {}", "out vec4 color;"};
+    constexpr std::array<std::string_view, 2> moved{"void main() {}out", " vec4 color;"};
+
+    const auto key = gpu::shader_binary_cache_s::make_key("vendor 1.0", sources);
+
+    EXPECT_EQ(key, gpu::shader_binary_cache_s::make_key("vendor 1.0", sources));
+    EXPECT_NE(key, gpu::shader_binary_cache_s::make_key("vendor 1.1", sources));
+    EXPECT_NE(key, gpu::shader_binary_cache_s::make_key("vendor 1.0", moved));
+}
+
+} // namespace
@@ -0,0 +1,47 @@
+#include "gpu/warm_up_results.hpp"
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace {
+using namespace miximus::gpu;
+using results_t = warm_up_results_s<int, std::unique_ptr<int>>;
+
+TEST(WarmUpResults, TakesAResultWhileLaterOnesArePending)
+{
+    results_t          results;
+    std::promise<void> taken;
+
+    std::jthread warm_up([&results, taken_future = taken.get_future()] {
+        results.publish(0, std::make_unique<int>(10));
+        // The rest is only published once the first result has been taken
+        taken_future.wait();
+        results.publish(1, std::make_unique<int>(11));
+        results.finish();
+    });
+
+    const auto first = results.take(0);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(*first, 10);
+    taken.set_value();
+
+    const auto second = results.take(1);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(*second, 11);
+}
+
+TEST(WarmUpResults, ReturnsEmptyForKeysNeverPublished)
+{
+    results_t results;
+    results.publish(0, std::make_unique<int>(10));
+    results.finish();
+
+    EXPECT_EQ(results.take(1), nullptr);
+    EXPECT_NE(results.take(0), nullptr);
+    EXPECT_EQ(results.take(0), nullptr);
+}
+
+} // namespace
@@ -2,6 +2,8 @@
 
 #include "context.hpp"
 
+#include <magic_enum/magic_enum.hpp>
+
 #include <algorithm>
 #include <limits>
 #include <stdexcept>
@@ -119,6 +121,32 @@ texture_s::pixel_format_info_s texture_s::pixel_format_info(pixel_format_e pixel
                 .mip_map_levels           = 1,
                 .storage_identical        = true,
             };
+        case pixel_format_e::packed_u8:
+            return {
+                .internal_format          = GL_RGBA8,
+                .external_format          = GL_RGBA,
+                .external_type            = GL_UNSIGNED_BYTE,
+                .min_filter               = GL_NEAREST,
+                .mag_filter               = GL_NEAREST,
+                .host_bytes_per_texel     = 4,
+                .storage_bytes_per_texel  = 4,
+                .display_pixels_per_texel = 1,
+                .mip_map_levels           = 1,
+                .storage_identical        = true,
+            };
+        case pixel_format_e::packed_u16:
+            return {
+                .internal_format          = GL_RGBA16,
+                .external_format          = GL_RGBA,
+                .external_type            = GL_UNSIGNED_SHORT,
+                .min_filter               = GL_NEAREST,
+                .mag_filter               = GL_NEAREST,
+                .host_bytes_per_texel     = 8,
+                .storage_bytes_per_texel  = 8,
+                .display_pixels_per_texel = 1,
+                .mip_map_levels           = 1,
+                .storage_identical        = true,
+            };
     }
     throw std::invalid_argument("Invalid texture pixel_format");
 }
@@ -141,6 +169,11 @@ texture_s::texture_s(vec2i_t dimensions, pixel_format_e pixel_format)
     glTextureParameteri(id_, GL_TEXTURE_MAG_FILTER, info.mag_filter);
 
     glTextureStorage2D(id_, info.mip_map_levels, info.internal_format, texture_dimensions_.x, texture_dimensions_.y);
+
+    if (dimensions.x > 0 && dimensions.y > 0) {
+        memory_ = memory_allocation_s(magic_enum::enum_name(pixel_format),
+                                      estimate_storage_byte_size(dimensions, pixel_format));
+    }
 }
 
 texture_s::~texture_s()
@@ -149,11 +182,17 @@ texture_s::~texture_s()
         return;
     }
     glDeleteTextures(1, &id_);
+    gl_state_cache_s::object_deleted();
 }
 
-void texture_s::bind(GLuint sampler) const { glBindTextureUnit(sampler, id_); }
+void texture_s::bind(GLuint sampler) const { context_s::current_state_cache().bind_texture(sampler, id_); }
 
-void texture_s::unbind(GLuint sampler) { glBindTextureUnit(sampler, 0); }
+void texture_s::unbind(GLuint sampler) { context_s::current_state_cache().bind_texture(sampler, 0); }
+
+void texture_s::bind_image(GLuint unit, GLenum access) const
+{
+    glBindImageTexture(unit, id_, 0, GL_FALSE, 0, access, pixel_format_info(pixel_format_).internal_format);
+}
 
 void texture_s::clear() const
 {
@@ -161,6 +200,7 @@ void texture_s::clear() const
     for (GLsizei level = 0; level < mip_map_levels; ++level) {
         glClearTexImage(id_, level, gl_external_format_, gl_external_type_, nullptr);
     }
+    mip_maps_stale_ = false;
 }
 
 size_t texture_s::estimate_storage_byte_size(vec2i_t dimensions, pixel_format_e pixel_format)
@@ -198,11 +238,22 @@ size_t texture_s::host_row_byte_size(vec2i_t dimensions, pixel_format_e pixel_fo
                             info.host_bytes_per_texel);
 }
 
-void texture_s::generate_mip_maps() const
+void texture_s::update_mip_maps() const
 {
+    if (!mip_maps_stale_) {
+        return;
+    }
     if (pixel_format_info(pixel_format_).mip_map_levels > 1) {
         glGenerateTextureMipmap(id_);
     }
+    mip_maps_stale_ = false;
+}
+
+void texture_s::update_mip_maps_for(const texture_draw_s& draw, vec2i_t target_dimensions) const
+{
+    if (mip_maps_stale_ && texture_draw_minifies(draw, display_dimensions_, target_dimensions)) {
+        update_mip_maps();
+    }
 }
 
 } // namespace miximus::gpu
@@ -1,8 +1,11 @@
 #pragma once
+#include "geometry.hpp"
 #include "glad.hpp"
+#include "memory_registry.hpp"
 #include "types.hpp"
 
 #include <cstddef>
+#include <string_view>
 
 namespace miximus::gpu {
 
@@ -20,6 +23,8 @@ class texture_s
         bgra_u8,
         uyuv_u8,
         uyuv_u10,
+        packed_u8,
+        packed_u16,
     };
 
     struct pixel_format_info_s
@@ -37,12 +42,14 @@ class texture_s
     };
 
   private:
-    GLuint         id_{};
-    vec2i_t        display_dimensions_{};
-    vec2i_t        texture_dimensions_{};
-    GLenum         gl_external_format_{};
-    GLenum         gl_external_type_{};
-    pixel_format_e pixel_format_;
+    GLuint              id_{};
+    vec2i_t             display_dimensions_{};
+    vec2i_t             texture_dimensions_{};
+    GLenum              gl_external_format_{};
+    GLenum              gl_external_type_{};
+    pixel_format_e      pixel_format_;
+    mutable bool        mip_maps_stale_{true};
+    memory_allocation_s memory_;
 
   public:
     texture_s(vec2i_t dimensions, pixel_format_e pixel_format);
@@ -63,11 +70,21 @@ class texture_s
     GLenum                     gl_external_type() const noexcept { return gl_external_type_; }
     pixel_format_e             pixel_format() const noexcept { return pixel_format_; }
     GLuint                     id() const noexcept { return id_; }
+    const memory_allocation_s& memory() const noexcept { return memory_; }
+    void                       set_memory_owner(std::string_view owner) { memory_.set_owner(owner); }
 
     void        bind(GLuint sampler) const;
     static void unbind(GLuint sampler);
     void        clear() const;
-    void        generate_mip_maps() const;
+    // Binds level 0 to an image unit for compute programs, `access` is e.g. GL_WRITE_ONLY
+    void bind_image(GLuint unit, GLenum access) const;
+
+    // Mip levels are generated lazily. Writers of level 0 mark them out of
+    // date, and consumers that minify the texture bring them up to date, so
+    // each written image is reduced at most once and only when it is shrunk.
+    void invalidate_mip_maps() const noexcept { mip_maps_stale_ = true; }
+    void update_mip_maps() const;
+    void update_mip_maps_for(const texture_draw_s& draw, vec2i_t target_dimensions) const;
 };
 
 } // namespace miximus::gpu
@@ -1,5 +1,7 @@
 #include "textured_quad.hpp"
 
+#include "context.hpp"
+#include "draw_parameters.hpp"
 #include "texture.hpp"
 #include "vertex.hpp"
 
@@ -14,6 +16,12 @@ textured_quad_s::textured_quad_s(shader_program_s* shader, uv_e uv)
         throw std::invalid_argument("textured quad shader must not be null");
     }
 
+    auto* context = context_s::current();
+    if (context == nullptr) {
+        throw std::logic_error("textured quad requires a current context");
+    }
+    uniform_ring_ = &context->uniform_ring();
+
     draw_state_.set_shader_program(shader_);
     if (uv == uv_e::flipped) {
         draw_state_.set_vertex_data(full_screen_quad_verts_flip_uv);
@@ -22,13 +30,6 @@ textured_quad_s::textured_quad_s(shader_program_s* shader, uv_e uv)
     }
 }
 
-textured_quad_s::batch_s::~batch_s()
-{
-    if (texture_bound_) {
-        texture_s::unbind(0);
-    }
-}
-
 void textured_quad_s::batch_s::draw(texture_s* texture, rect_s rect, double opacity)
 {
     draw(texture, {.destination = rect}, opacity);
@@ -40,14 +41,14 @@ void textured_quad_s::batch_s::draw(texture_s* texture, const texture_draw_s& dr
         return;
     }
 
-    owner_->shader_->set_uniform("offset", draw.destination.pos);
-    owner_->shader_->set_uniform("scale", draw.destination.size);
-    owner_->shader_->set_uniform("texture_offset", draw.source.pos);
-    owner_->shader_->set_uniform("texture_scale", draw.source.size);
-    owner_->shader_->set_uniform("opacity", opacity);
+    owner_->uniform_ring_->bind(DRAW_PARAMETERS_BINDING,
+                                draw_parameters_s{
+                                    .destination = glm::vec4(draw.destination.pos, draw.destination.size),
+                                    .source      = glm::vec4(draw.source.pos, draw.source.size),
+                                    .opacity     = static_cast<float>(opacity),
+                                });
 
     texture->bind(0);
-    texture_bound_ = true;
     owner_->draw_state_.draw();
 }
 
@@ -63,6 +64,27 @@ void textured_quad_s::draw(texture_s* texture, const texture_draw_s& draw, doubl
     batch.draw(texture, draw, opacity);
 }
 
+const textured_quad_s::mix_uniforms_s& textured_quad_s::mix_uniforms()
+{
+    if (!mix_uniforms_) {
+        shader_->set_uniform("tex", 0);
+        shader_->set_uniform("tex_b", 1);
+        mix_uniforms_ = mix_uniforms_s{
+            .t                    = shader_->get_uniform_location<double>("t"),
+            .a_destination_offset = shader_->get_uniform_location<vec2_t>("a_destination_offset"),
+            .a_destination_scale  = shader_->get_uniform_location<vec2_t>("a_destination_scale"),
+            .a_source_offset      = shader_->get_uniform_location<vec2_t>("a_source_offset"),
+            .a_source_scale       = shader_->get_uniform_location<vec2_t>("a_source_scale"),
+            .b_destination_offset = shader_->get_uniform_location<vec2_t>("b_destination_offset"),
+            .b_destination_scale  = shader_->get_uniform_location<vec2_t>("b_destination_scale"),
+            .b_source_offset      = shader_->get_uniform_location<vec2_t>("b_source_offset"),
+            .b_source_scale       = shader_->get_uniform_location<vec2_t>("b_source_scale"),
+            .video_mix            = shader_->get_uniform_location<int>("video_mix"),
+        };
+    }
+    return *mix_uniforms_;
+}
+
 void textured_quad_s::draw_mix(texture_s*            a,
                                texture_s*            b,
                                double                t,
@@ -74,28 +96,29 @@ void textured_quad_s::draw_mix(texture_s*            a,
         return;
     }
 
-    shader_->set_uniform("offset", vec2_t{0, 0});
-    shader_->set_uniform("scale", vec2_t{1, 1});
-    shader_->set_uniform("texture_offset", vec2_t{0, 0});
-    shader_->set_uniform("texture_scale", vec2_t{1, 1});
-    shader_->set_uniform("tex", 0);
-    shader_->set_uniform("tex_b", 1);
-    shader_->set_uniform("t", t);
-    shader_->set_uniform("a_destination_offset", a_draw.destination.pos);
-    shader_->set_uniform("a_destination_scale", a_draw.destination.size);
-    shader_->set_uniform("a_source_offset", a_draw.source.pos);
-    shader_->set_uniform("a_source_scale", a_draw.source.size);
-    shader_->set_uniform("b_destination_offset", b_draw.destination.pos);
-    shader_->set_uniform("b_destination_scale", b_draw.destination.size);
-    shader_->set_uniform("b_source_offset", b_draw.source.pos);
-    shader_->set_uniform("b_source_scale", b_draw.source.size);
-    shader_->set_uniform("video_mix", mix_space == mix_space_e::video ? 1 : 0);
+    const auto& uniforms = mix_uniforms();
+    shader_->set_uniform(uniforms.t, t);
+    shader_->set_uniform(uniforms.a_destination_offset, a_draw.destination.pos);
+    shader_->set_uniform(uniforms.a_destination_scale, a_draw.destination.size);
+    shader_->set_uniform(uniforms.a_source_offset, a_draw.source.pos);
+    shader_->set_uniform(uniforms.a_source_scale, a_draw.source.size);
+    shader_->set_uniform(uniforms.b_destination_offset, b_draw.destination.pos);
+    shader_->set_uniform(uniforms.b_destination_scale, b_draw.destination.size);
+    shader_->set_uniform(uniforms.b_source_offset, b_draw.source.pos);
+    shader_->set_uniform(uniforms.b_source_scale, b_draw.source.size);
+    shader_->set_uniform(uniforms.video_mix, mix_space == mix_space_e::video ? 1 : 0);
+
+    // The mix shader fits both sources itself, the quad covers the target
+    uniform_ring_->bind(DRAW_PARAMETERS_BINDING,
+                        draw_parameters_s{
+                            .destination = {0, 0, 1, 1},
+                            .source      = {0, 0, 1, 1},
+                            .opacity     = 1.0F,
+                        });
 
     a->bind(0);
     b->bind(1);
     draw_state_.draw();
-    texture_s::unbind(1);
-    texture_s::unbind(0);
 }
 
 } // namespace miximus::gpu
@@ -3,7 +3,9 @@
 #include "geometry.hpp"
 #include "texture_fwd.hpp"
 #include "types.hpp"
+#include "uniform_ring.hpp"
 
+#include <optional>
 #include <utility>
 
 namespace miximus::gpu {
@@ -26,7 +28,6 @@ class textured_quad_s
     class batch_s
     {
         textured_quad_s* owner_{};
-        bool             texture_bound_{};
 
         explicit batch_s(textured_quad_s* owner)
             : owner_(owner)
@@ -36,11 +37,10 @@ class textured_quad_s
         friend class textured_quad_s;
 
       public:
-        ~batch_s();
+        ~batch_s() = default;
 
         batch_s(batch_s&& other) noexcept
             : owner_(std::exchange(other.owner_, nullptr))
-            , texture_bound_(std::exchange(other.texture_bound_, false))
         {
         }
 
@@ -53,10 +53,29 @@ class textured_quad_s
     };
 
   private:
-    draw_state_s      draw_state_;
-    shader_program_s* shader_{};
+    struct mix_uniforms_s
+    {
+        uniform_location_s<double> t;
+        uniform_location_s<vec2_t> a_destination_offset;
+        uniform_location_s<vec2_t> a_destination_scale;
+        uniform_location_s<vec2_t> a_source_offset;
+        uniform_location_s<vec2_t> a_source_scale;
+        uniform_location_s<vec2_t> b_destination_offset;
+        uniform_location_s<vec2_t> b_destination_scale;
+        uniform_location_s<vec2_t> b_source_offset;
+        uniform_location_s<vec2_t> b_source_scale;
+        uniform_location_s<int>    video_mix;
+    };
+
+    draw_state_s                  draw_state_;
+    shader_program_s*             shader_{};
+    uniform_ring_s*               uniform_ring_{};
+    std::optional<mix_uniforms_s> mix_uniforms_;
+
+    const mix_uniforms_s& mix_uniforms();
 
   public:
+    // Must be constructed and used with the same context current
     explicit textured_quad_s(shader_program_s* shader, uv_e uv = uv_e::flipped);
 
     textured_quad_s(const textured_quad_s&)            = delete;
@@ -1,5 +1,6 @@
 #include "cuda.hpp"
 
+#include "gpu/context.hpp"
 #include "gpu/texture.hpp"
 #include "logger/logger.hpp"
 
@@ -34,6 +35,8 @@ bool cuda_transfer_s::supports_direct_image(texture_s::pixel_format_e pixel_form
     // four-byte host and texture-storage representation.
     switch (pixel_format) {
         case texture_s::pixel_format_e::rgba_u8:
+        case texture_s::pixel_format_e::packed_u8:
+        case texture_s::pixel_format_e::packed_u16:
             return texture_s::pixel_format_info(pixel_format).storage_identical;
         case texture_s::pixel_format_e::argb_u8:
         case texture_s::pixel_format_e::bgra_u8:
@@ -371,12 +374,7 @@ bool cuda_transfer_s::submit_transfer()
             return false;
         }
 
-        GLint previous_row_length{};
-        GLint previous_alignment{};
-        glGetIntegerv(GL_UNPACK_ROW_LENGTH, &previous_row_length);
-        glGetIntegerv(GL_UNPACK_ALIGNMENT, &previous_alignment);
-        glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length_);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        context_s::current_state_cache().set_unpack_layout(row_length_, 1);
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_);
         glTextureSubImage2D(texture()->id(),
                             0,
@@ -388,8 +386,6 @@ bool cuda_transfer_s::submit_transfer()
                             texture()->gl_external_type(),
                             nullptr);
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-        glPixelStorei(GL_UNPACK_ROW_LENGTH, previous_row_length);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, previous_alignment);
         return true;
     }
 
@@ -400,23 +396,16 @@ bool cuda_transfer_s::submit_transfer()
     if (!ensure_buffer()) {
         return false;
     }
-    GLint previous_row_length{};
-    GLint previous_alignment{};
-    glGetIntegerv(GL_PACK_ROW_LENGTH, &previous_row_length);
-    glGetIntegerv(GL_PACK_ALIGNMENT, &previous_alignment);
-    glPixelStorei(GL_PACK_ROW_LENGTH, row_length_);
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    context_s::current_state_cache().set_pack_layout(row_length_, 1);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer_);
-    glBindTexture(GL_TEXTURE_2D, texture()->id());
     const bool shader_arranged_bytes = readback_component_mapping_ != readback_component_mapping_e::identity;
-    glGetTexImage(GL_TEXTURE_2D,
-                  0,
-                  shader_arranged_bytes ? GL_RGBA : texture()->gl_external_format(),
-                  shader_arranged_bytes ? GL_UNSIGNED_BYTE : texture()->gl_external_type(),
-                  nullptr);
+    glGetTextureImage(texture()->id(),
+                      0,
+                      shader_arranged_bytes ? GL_RGBA : texture()->gl_external_format(),
+                      shader_arranged_bytes ? GL_UNSIGNED_BYTE : texture()->gl_external_type(),
+                      static_cast<GLsizei>(host_buffer_size_bytes_),
+                      nullptr);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-    glPixelStorei(GL_PACK_ROW_LENGTH, previous_row_length);
-    glPixelStorei(GL_PACK_ALIGNMENT, previous_alignment);
     return copy_buffer_to_host();
 }
 
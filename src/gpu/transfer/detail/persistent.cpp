@@ -1,5 +1,6 @@
 #include "persistent.hpp"
 
+#include "gpu/context.hpp"
 #include "gpu/texture.hpp"
 
 #include <chrono>
@@ -48,45 +49,35 @@ pinned_transfer_s::~pinned_transfer_s()
 
 bool pinned_transfer_s::submit_transfer()
 {
-    const auto id   = texture()->id();
-    const auto dims = texture()->texture_dimensions();
+    const auto id    = texture()->id();
+    const auto dims  = texture()->texture_dimensions();
+    auto&      state = context_s::current_state_cache();
 
     if (direction_ == direction_e::cpu_to_gpu) {
         glFlushMappedNamedBufferRange(id_, 0, static_cast<GLsizeiptr>(host_buffer_size_bytes_));
-        GLint previous_row_length{};
-        GLint previous_alignment{};
-        glGetIntegerv(GL_UNPACK_ROW_LENGTH, &previous_row_length);
-        glGetIntegerv(GL_UNPACK_ALIGNMENT, &previous_alignment);
-        glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length_);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        state.set_unpack_layout(row_length_, 1);
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, id_);
-        glBindTexture(GL_TEXTURE_2D, id);
-        glTexSubImage2D(GL_TEXTURE_2D,
-                        0,
-                        0,
-                        0,
-                        dims.x,
-                        dims.y,
-                        texture()->gl_external_format(),
-                        texture()->gl_external_type(),
-                        nullptr);
+        glTextureSubImage2D(id,
+                            0,
+                            0,
+                            0,
+                            dims.x,
+                            dims.y,
+                            texture()->gl_external_format(),
+                            texture()->gl_external_type(),
+                            nullptr);
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-        glPixelStorei(GL_UNPACK_ROW_LENGTH, previous_row_length);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, previous_alignment);
         transfer_fence_ = std::make_unique<fence_s>();
     } else {
-        GLint previous_row_length{};
-        GLint previous_alignment{};
-        glGetIntegerv(GL_PACK_ROW_LENGTH, &previous_row_length);
-        glGetIntegerv(GL_PACK_ALIGNMENT, &previous_alignment);
-        glPixelStorei(GL_PACK_ROW_LENGTH, row_length_);
-        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        state.set_pack_layout(row_length_, 1);
         glBindBuffer(GL_PIXEL_PACK_BUFFER, id_);
-        glBindTexture(GL_TEXTURE_2D, id);
-        glGetTexImage(GL_TEXTURE_2D, 0, texture()->gl_external_format(), texture()->gl_external_type(), nullptr);
+        glGetTextureImage(id,
+                          0,
+                          texture()->gl_external_format(),
+                          texture()->gl_external_type(),
+                          static_cast<GLsizei>(host_buffer_size_bytes_),
+                          nullptr);
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        glPixelStorei(GL_PACK_ROW_LENGTH, previous_row_length);
-        glPixelStorei(GL_PACK_ALIGNMENT, previous_alignment);
 
         glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
         transfer_fence_ = std::make_unique<fence_s>();
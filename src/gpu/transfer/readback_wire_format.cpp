@@ -0,0 +1,185 @@
+#include "readback_wire_format.hpp"
+
+#include "gpu/context.hpp"
+#include "gpu/framebuffer.hpp"
+#include "gpu/shader.hpp"
+#include "gpu/textured_quad.hpp"
+#include "gpu/transfer/texture_readback.hpp"
+#include "logger/logger.hpp"
+
+#include <exception>
+#include <limits>
+#include <stdexcept>
+
+namespace miximus::gpu::transfer {
+namespace {
+struct wire_format_info_s
+{
+    texture_s::pixel_format_e pixel_format;
+    shader_program_s::name_e  shader;
+    int                       horizontal_alignment;
+    int                       vertical_alignment;
+};
+
+wire_format_info_s wire_format_info(readback_wire_format_e wire_format)
+{
+    switch (wire_format) {
+        case readback_wire_format_e::uyvy_u8:
+            return {
+                .pixel_format         = texture_s::pixel_format_e::packed_u8,
+                .shader               = shader_program_s::name_e::rgb_to_uyvy,
+                .horizontal_alignment = 2,
+                .vertical_alignment   = 1,
+            };
+        case readback_wire_format_e::v210:
+            return {
+                .pixel_format         = texture_s::pixel_format_e::uyuv_u10,
+                .shader               = shader_program_s::name_e::rgb_to_yuv,
+                .horizontal_alignment = 2,
+                .vertical_alignment   = 1,
+            };
+        case readback_wire_format_e::nv12:
+            return {
+                .pixel_format         = texture_s::pixel_format_e::packed_u8,
+                .shader               = shader_program_s::name_e::rgb_to_nv12,
+                .horizontal_alignment = 4,
+                .vertical_alignment   = 2,
+            };
+        case readback_wire_format_e::p216:
+            return {
+                .pixel_format         = texture_s::pixel_format_e::packed_u16,
+                .shader               = shader_program_s::name_e::rgb_to_p216,
+                .horizontal_alignment = 4,
+                .vertical_alignment   = 1,
+            };
+        case readback_wire_format_e::texture:
+            break;
+    }
+    throw std::invalid_argument("readback wire format has no packed encoding");
+}
+
+size_t minimum_row_stride(readback_wire_format_e wire_format, vec2i_t dimensions)
+{
+    const auto width = static_cast<size_t>(dimensions.x);
+    switch (wire_format) {
+        case readback_wire_format_e::uyvy_u8:
+        case readback_wire_format_e::p216:
+            return width * 2;
+        case readback_wire_format_e::v210:
+            return (width + 47) / 48 * 128;
+        case readback_wire_format_e::nv12:
+            return width;
+        case readback_wire_format_e::texture:
+            break;
+    }
+    throw std::invalid_argument("readback wire format has no packed encoding");
+}
+
+shader_program_s* compute_shader_for(context_s* context, readback_wire_format_e wire_format)
+{
+    if (wire_format != readback_wire_format_e::v210) {
+        return nullptr;
+    }
+    try {
+        return context->get_shader(shader_program_s::name_e::rgb_to_yuv_compute);
+    } catch (const std::exception& e) {
+        getlog("gpu")->warn("Packing v210 with the fragment shader, the compute program failed: {}", e.what());
+        return nullptr;
+    }
+}
+
+int plane_rows(readback_wire_format_e wire_format, int height)
+{
+    switch (wire_format) {
+        case readback_wire_format_e::nv12:
+            return height + (height / 2);
+        case readback_wire_format_e::p216:
+            return height * 2;
+        default:
+            return height;
+    }
+}
+} // namespace
+
+texture_transfer_layout_s
+make_wire_transfer_layout(readback_wire_format_e wire_format, vec2i_t dimensions, size_t host_row_stride_bytes)
+{
+    const auto info = wire_format_info(wire_format);
+    if (dimensions.x <= 0 || dimensions.y <= 0 || dimensions.x % info.horizontal_alignment != 0 ||
+        dimensions.y % info.vertical_alignment != 0) {
+        throw std::invalid_argument("image dimensions are incompatible with the readback wire format");
+    }
+
+    const auto minimum_stride = minimum_row_stride(wire_format, dimensions);
+    if (host_row_stride_bytes == 0) {
+        host_row_stride_bytes = minimum_stride;
+    }
+    const auto bytes_per_texel = texture_s::pixel_format_info(info.pixel_format).host_bytes_per_texel;
+    if (host_row_stride_bytes < minimum_stride || host_row_stride_bytes % bytes_per_texel != 0 ||
+        host_row_stride_bytes / bytes_per_texel > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::invalid_argument("row stride is invalid for the readback wire format");
+    }
+
+    // v210 renders its padding words too, so the texture spans the whole row;
+    // the other formats leave any caller-requested padding untouched.
+    const auto texel_width = wire_format == readback_wire_format_e::v210
+                                 ? static_cast<int>(host_row_stride_bytes / bytes_per_texel)
+                                 : static_cast<int>(minimum_stride / bytes_per_texel);
+    const auto rows        = plane_rows(wire_format, dimensions.y);
+    return {
+        .dimensions             = {texel_width, rows},
+        .pixel_format           = info.pixel_format,
+        .host_row_stride_bytes  = host_row_stride_bytes,
+        .host_buffer_size_bytes = host_row_stride_bytes * static_cast<size_t>(rows),
+        .host_memory_access     = host_memory_access_e::read_only,
+    };
+}
+
+readback_wire_encoder_s::readback_wire_encoder_s(context_s*                       context,
+                                                 readback_wire_format_e           wire_format,
+                                                 const texture_transfer_layout_s& transfer_layout,
+                                                 color_conversion_s               yuv_conversion,
+                                                 mat3                             gamut_conversion)
+    : wire_format_(wire_format)
+    , yuv_conversion_(yuv_conversion)
+    , gamut_conversion_(gamut_conversion)
+    , target_width_(transfer_layout.dimensions.x)
+    , compute_shader_(compute_shader_for(context, wire_format))
+    , quad_(compute_shader_ == nullptr
+                ? std::make_unique<textured_quad_s>(context->get_shader(wire_format_info(wire_format).shader))
+                : nullptr)
+    , uniforms_(compute_shader_ != nullptr ? *compute_shader_ : *quad_->shader())
+{
+    if (transfer_layout.pixel_format != wire_format_info(wire_format).pixel_format) {
+        throw std::invalid_argument("transfer layout does not match the readback wire format");
+    }
+    if (quad_) {
+        // Packed samples occupy every channel, including alpha.
+        quad_->set_blending_enabled(false);
+    }
+}
+
+readback_wire_encoder_s::~readback_wire_encoder_s() = default;
+
+void readback_wire_encoder_s::encode(texture_s* source, texture_readback_target_s& target)
+{
+    // Encoders on one context share the shader, so set the conversion per draw
+    if (compute_shader_ != nullptr) {
+        uniforms_.set(*compute_shader_, target_width_, yuv_conversion_, gamut_conversion_);
+
+        auto* texture = target.framebuffer()->texture();
+        source->bind(0);
+        texture->bind_image(0, GL_WRITE_ONLY);
+        // One invocation per v210 group, the four texels holding six pixels
+        const auto dimensions = texture->texture_dimensions();
+        compute_shader_->dispatch({(dimensions.x + 3) / 4, dimensions.y});
+        return;
+    }
+
+    uniforms_.set(*quad_->shader(), target_width_, yuv_conversion_, gamut_conversion_);
+    target.framebuffer()->begin_render(framebuffer_s::load_op_e::clear);
+    quad_->draw(source);
+    framebuffer_s::end_render();
+}
+
+} // namespace miximus::gpu::transfer
@@ -0,0 +1,72 @@
+#pragma once
+#include "gpu/color_conversion_uniforms.hpp"
+#include "gpu/color_transfer.hpp"
+#include "gpu/transfer/texture_readback_fwd.hpp"
+#include "gpu/transfer/texture_transfer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace miximus::gpu {
+class context_s;
+class shader_program_s;
+class textured_quad_s;
+} // namespace miximus::gpu
+
+namespace miximus::gpu::transfer {
+
+// The byte layout a readback stream delivers to its consumer. Every format
+// except `texture` is produced by a render pass into a packed readback
+// texture, so the host buffer already holds the bytes the sink transmits.
+enum class readback_wire_format_e : std::uint8_t
+{
+    texture, // The readback texture's own external format.
+    uyvy_u8, // 8-bit 4:2:2, U Y V Y per pixel pair.
+    v210,    // 10-bit 4:2:2, six pixels per 16 bytes.
+    nv12,    // 8-bit 4:2:0, luma plane followed by interleaved U V rows.
+    p216,    // 16-bit 4:2:2, luma plane followed by interleaved U V rows.
+};
+
+// Builds the transfer layout for `dimensions` display pixels. A zero row
+// stride selects the smallest stride the format allows; devices with their
+// own row alignment pass theirs. Rows of every plane share one stride.
+texture_transfer_layout_s make_wire_transfer_layout(readback_wire_format_e wire_format,
+                                                    vec2i_t                dimensions,
+                                                    size_t                 host_row_stride_bytes = 0);
+
+// Encodes a linear-light RGB texture into a readback target using the shader
+// for the stream's wire format. The source must have the display dimensions
+// the stream was laid out for; scaling belongs to the caller. v210 is packed
+// by a compute program, with the fragment shader as fallback when the compute
+// program fails to build.
+class readback_wire_encoder_s
+{
+    readback_wire_format_e           wire_format_;
+    color_conversion_s               yuv_conversion_;
+    mat3                             gamut_conversion_;
+    int                              target_width_;
+    shader_program_s*                compute_shader_;
+    std::unique_ptr<textured_quad_s> quad_;
+    color_conversion_uniforms_s      uniforms_;
+
+  public:
+    readback_wire_encoder_s(context_s*                       context,
+                            readback_wire_format_e           wire_format,
+                            const texture_transfer_layout_s& transfer_layout,
+                            color_conversion_s               yuv_conversion,
+                            mat3                             gamut_conversion = mat3{1.0F});
+    ~readback_wire_encoder_s();
+
+    readback_wire_encoder_s(const readback_wire_encoder_s&)            = delete;
+    readback_wire_encoder_s& operator=(const readback_wire_encoder_s&) = delete;
+    readback_wire_encoder_s(readback_wire_encoder_s&&)                 = delete;
+    readback_wire_encoder_s& operator=(readback_wire_encoder_s&&)      = delete;
+
+    readback_wire_format_e wire_format() const noexcept { return wire_format_; }
+
+    // Writes every texel of the readback target.
+    void encode(texture_s* source, texture_readback_target_s& target);
+};
+
+} // namespace miximus::gpu::transfer
@@ -1,6 +1,7 @@
 #include "texture_readback.hpp"
 
 #include "gpu/context.hpp"
+#include "gpu/memory_registry.hpp"
 #include "gpu/framebuffer.hpp"
 #include "gpu/texture_frame.hpp"
 #include "gpu/transfer/detail/texture_transfer_backend_factory.hpp"
@@ -109,6 +110,12 @@ struct texture_readback_service_state_s : transfer_worker_s<texture_readback_ser
         size_t reserved{};
         bool   reserved_memory{};
         try {
+            const memory_owner_scope_s memory_owner(stream->config.memory_owner);
+            if (!memory_registry_s::global().has_room_for(texture_s::estimate_storage_byte_size(
+                    stream->config.transfer_layout.dimensions, stream->config.transfer_layout.pixel_format))) {
+                throw std::bad_alloc();
+            }
+
             reserved = estimate_slot_memory_usage(stream->config.transfer_layout);
             if (!reserve_memory(reserved)) {
                 throw std::bad_alloc();
@@ -554,6 +561,9 @@ std::shared_ptr<texture_readback_stream_s> texture_readback_service_s::create_st
         throw std::invalid_argument("invalid texture readback stream configuration");
     }
     detail::normalize_transfer_layout(config.transfer_layout);
+    if (config.memory_owner.empty()) {
+        config.memory_owner = memory_owner_scope_s::current();
+    }
     auto stream                 = std::make_shared<detail::texture_readback_stream_state_s>();
     stream->service             = state_;
     stream->config              = config;
@@ -12,6 +12,7 @@
 #include <memory>
 #include <optional>
 #include <span>
+#include <string>
 
 namespace miximus::gpu {
 class context_s;
@@ -29,6 +30,9 @@ struct texture_readback_config_s
     texture_transfer_layout_s transfer_layout{.host_memory_access = host_memory_access_e::read_only};
     size_t                    max_slots{4};
     size_t                    initial_slots{};
+    // Node the slot textures are accounted to, the creating thread's
+    // memory_owner_scope_s when empty
+    std::string memory_owner;
 };
 
 struct texture_readback_stream_metrics_s
@@ -1,6 +1,7 @@
 #include "texture_upload.hpp"
 
 #include "gpu/context.hpp"
+#include "gpu/memory_registry.hpp"
 #include "gpu/transfer/detail/texture_transfer_backend_factory.hpp"
 #include "gpu/transfer/detail/transfer_layout.hpp"
 #include "gpu/transfer/detail/transfer_worker.hpp"
@@ -104,6 +105,12 @@ struct texture_upload_service_state_s : transfer_worker_s<texture_upload_service
         size_t reserved_bytes  = 0;
         bool   memory_reserved = false;
         try {
+            const memory_owner_scope_s memory_owner(stream->config.memory_owner);
+            if (!memory_registry_s::global().has_room_for(texture_s::estimate_storage_byte_size(
+                    stream->config.transfer_layout.dimensions, stream->config.transfer_layout.pixel_format))) {
+                throw std::bad_alloc();
+            }
+
             reserved_bytes = estimate_slot_memory_usage(stream->config.transfer_layout);
             if (!reserve_memory(reserved_bytes)) {
                 throw std::bad_alloc();
@@ -174,11 +181,9 @@ struct texture_upload_service_state_s : transfer_worker_s<texture_upload_service
         success                     = slot->transfer_backend->wait_for_transfer_completion() && success;
         slot->gl_has_texture_access = success;
 
-        if (success && stream->config.generate_mip_maps) {
-            slot->frame->texture()->generate_mip_maps();
-        }
-
         if (success) {
+            // Consumers that minify the frame generate its mip levels on first use
+            slot->frame->texture()->invalidate_mip_maps();
             slot->frame->publish_upload_ready_fence();
         }
 
@@ -657,6 +662,9 @@ std::shared_ptr<texture_upload_stream_s> texture_upload_service_s::create_stream
         throw std::invalid_argument("invalid texture upload stream configuration");
     }
     detail::normalize_transfer_layout(config.transfer_layout);
+    if (config.memory_owner.empty()) {
+        config.memory_owner = memory_owner_scope_s::current();
+    }
     auto stream                 = std::make_shared<detail::texture_upload_stream_state_s>();
     stream->service             = state_;
     stream->config              = config;
@@ -10,6 +10,7 @@
 #include <memory>
 #include <optional>
 #include <span>
+#include <string>
 
 namespace miximus::gpu {
 class context_s;
@@ -27,7 +28,9 @@ struct texture_upload_config_s
     texture_transfer_layout_s transfer_layout;
     size_t                    max_slots{3};
     size_t                    initial_slots{};
-    bool                      generate_mip_maps{true};
+    // Node the slot textures are accounted to, the creating thread's
+    // memory_owner_scope_s when empty
+    std::string memory_owner;
 };
 
 struct texture_upload_id_s
@@ -0,0 +1,86 @@
+#include "uniform_ring.hpp"
+
+#include "context.hpp"
+#include "logger/logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace miximus::gpu {
+
+namespace {
+constexpr auto SEGMENT_WAIT_TIMEOUT = std::chrono::seconds(1);
+
+size_t align_up(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+} // namespace
+
+uniform_ring_s::uniform_ring_s(size_t segment_size)
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment_    = static_cast<size_t>(std::max(alignment, 1));
+    segment_size_ = align_up(segment_size, alignment_);
+
+    const auto       size  = static_cast<GLsizeiptr>(segment_size_ * SEGMENT_COUNT);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &buffer_);
+    glNamedBufferStorage(buffer_, size, nullptr, flags);
+    mapped_ = static_cast<std::byte*>(glMapNamedBufferRange(buffer_, 0, size, flags));
+    if (mapped_ == nullptr) {
+        glDeleteBuffers(1, &buffer_);
+        throw std::runtime_error("failed to map uniform ring buffer");
+    }
+}
+
+uniform_ring_s::~uniform_ring_s()
+{
+    if (!context_s::require_current()) {
+        return;
+    }
+    glUnmapNamedBuffer(buffer_);
+    glDeleteBuffers(1, &buffer_);
+}
+
+void uniform_ring_s::advance_segment()
+{
+    // Every draw reading the segment being left has been issued
+    fences_.at(segment_).emplace();
+
+    segment_        = (segment_ + 1) % SEGMENT_COUNT;
+    segment_offset_ = 0;
+
+    auto& fence = fences_.at(segment_);
+    if (fence.has_value()) {
+        if (!fence->cpu_wait(SEGMENT_WAIT_TIMEOUT)) {
+            getlog("gpu")->warn("Timed out waiting for the GPU to release a uniform ring segment");
+        }
+        fence.reset();
+    }
+}
+
+void uniform_ring_s::bind(GLuint binding, std::span<const std::byte> block)
+{
+    const auto size = align_up(block.size(), alignment_);
+    if (size > segment_size_) {
+        throw std::logic_error("uniform block is larger than a uniform ring segment");
+    }
+
+    if (segment_offset_ + size > segment_size_) {
+        advance_segment();
+    }
+
+    const auto offset = segment_ * segment_size_ + segment_offset_;
+    std::memcpy(mapped_ + offset, block.data(), block.size());
+    segment_offset_ += size;
+
+    glBindBufferRange(GL_UNIFORM_BUFFER,
+                      binding,
+                      buffer_,
+                      static_cast<GLintptr>(offset),
+                      static_cast<GLsizeiptr>(block.size()));
+}
+
+} // namespace miximus::gpu
@@ -0,0 +1,57 @@
+#pragma once
+#include "fence.hpp"
+#include "glad.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+
+namespace miximus::gpu {
+
+/**
+ * A persistently mapped uniform buffer that per-draw uniform blocks are
+ * written into, so a draw costs a memcpy and a glBindBufferRange instead of
+ * a uniform call per value.
+ *
+ * The buffer is split into segments. Leaving a segment fences it, and a
+ * segment is only written again once the GPU has passed that fence. Owned
+ * per context, see context_s::uniform_ring().
+ */
+class uniform_ring_s
+{
+  public:
+    static constexpr size_t SEGMENT_COUNT        = 4;
+    static constexpr size_t DEFAULT_SEGMENT_SIZE = 64 * 1024;
+
+  private:
+    GLuint                                            buffer_{};
+    std::byte*                                        mapped_{};
+    size_t                                            segment_size_{};
+    size_t                                            alignment_{};
+    size_t                                            segment_{};
+    size_t                                            segment_offset_{};
+    std::array<std::optional<fence_s>, SEGMENT_COUNT> fences_;
+
+    void advance_segment();
+
+  public:
+    explicit uniform_ring_s(size_t segment_size = DEFAULT_SEGMENT_SIZE);
+    ~uniform_ring_s();
+
+    uniform_ring_s(const uniform_ring_s&)            = delete;
+    uniform_ring_s(uniform_ring_s&&)                 = delete;
+    uniform_ring_s& operator=(const uniform_ring_s&) = delete;
+    uniform_ring_s& operator=(uniform_ring_s&&)      = delete;
+
+    // Copy `block` into the ring and bind it to the uniform buffer binding point
+    void bind(GLuint binding, std::span<const std::byte> block);
+
+    template <typename T>
+    void bind(GLuint binding, const T& block)
+    {
+        bind(binding, std::as_bytes(std::span{&block, 1}));
+    }
+};
+
+} // namespace miximus::gpu
@@ -4,7 +4,7 @@
 
 namespace miximus::gpu {
 
-vertex_array_s::vertex_array_s() { glGenVertexArrays(1, &id_); }
+vertex_array_s::vertex_array_s() { glCreateVertexArrays(1, &id_); }
 
 vertex_array_s::~vertex_array_s()
 {
@@ -12,10 +12,11 @@ vertex_array_s::~vertex_array_s()
         return;
     }
     glDeleteVertexArrays(1, &id_);
+    gl_state_cache_s::object_deleted();
 }
 
-void vertex_array_s::bind() const { glBindVertexArray(id_); }
+void vertex_array_s::bind() const { context_s::current_state_cache().bind_vertex_array(id_); }
 
-void vertex_array_s::unbind() { glBindVertexArray(0); }
+void vertex_array_s::unbind() { context_s::current_state_cache().bind_vertex_array(0); }
 
 } // namespace miximus::gpu
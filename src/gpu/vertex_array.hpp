@@ -14,6 +14,7 @@ class vertex_array_s
     vertex_array_s();
     ~vertex_array_s();
 
+    GLuint      id() const noexcept { return id_; }
     void        bind() const;
     static void unbind();
 };
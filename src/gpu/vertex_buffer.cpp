@@ -5,7 +5,7 @@
 
 namespace miximus::gpu {
 
-vertex_buffer_s::vertex_buffer_s() { glGenBuffers(1, &id_); }
+vertex_buffer_s::vertex_buffer_s() { glCreateBuffers(1, &id_); }
 
 vertex_buffer_s::~vertex_buffer_s()
 {
@@ -15,8 +15,6 @@ vertex_buffer_s::~vertex_buffer_s()
     glDeleteBuffers(1, &id_);
 }
 
-void vertex_buffer_s::bind() const { glBindBuffer(GL_ARRAY_BUFFER, id_); }
-
 void vertex_buffer_s::set_data_bytes(std::span<const std::byte> data, size_t element_count)
 {
     vertex_count_ = element_count;
@@ -24,8 +24,8 @@ class vertex_buffer_s
         set_data_bytes(std::as_bytes(data), data.size());
     }
 
-    void bind() const;
-    void draw() const;
+    GLuint id() const noexcept { return id_; }
+    void   draw() const;
 };
 
 } // namespace miximus::gpu
@@ -0,0 +1,60 @@
+#pragma once
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace miximus::gpu {
+
+/**
+ * Results a background warm-up hands to the thread using them, one per key.
+ * take() returns as soon as the requested result is published, without
+ * waiting for the rest of the warm-up.
+ */
+template <typename Key, typename Value>
+class warm_up_results_s
+{
+    std::mutex              mutex_;
+    std::condition_variable ready_changed_;
+    std::map<Key, Value>    ready_;
+    bool                    finished_{};
+
+  public:
+    warm_up_results_s() = default;
+
+    warm_up_results_s(const warm_up_results_s&)            = delete;
+    warm_up_results_s(warm_up_results_s&&)                 = delete;
+    warm_up_results_s& operator=(const warm_up_results_s&) = delete;
+    warm_up_results_s& operator=(warm_up_results_s&&)      = delete;
+
+    void publish(const Key& key, Value value)
+    {
+        {
+            const std::scoped_lock lock(mutex_);
+            ready_.insert_or_assign(key, std::move(value));
+        }
+        ready_changed_.notify_all();
+    }
+
+    // No more results follow, take() stops waiting for keys not published
+    void finish()
+    {
+        {
+            const std::scoped_lock lock(mutex_);
+            finished_ = true;
+        }
+        ready_changed_.notify_all();
+    }
+
+    // Waits until `key` is published or the warm-up has finished, empty when it never was
+    Value take(const Key& key)
+    {
+        std::unique_lock lock(mutex_);
+        ready_changed_.wait(lock, [this, &key] { return finished_ || ready_.contains(key); });
+
+        auto node = ready_.extract(key);
+        return node ? std::move(node.mapped()) : Value{};
+    }
+};
+
+} // namespace miximus::gpu
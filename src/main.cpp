@@ -1,3 +1,4 @@
+#include "core/adapters/adapter_autosave.hpp"
 #include "core/adapters/adapter_websocket.hpp"
 #include "core/app_state.hpp"
 #include "core/clock_source.hpp"
@@ -10,6 +11,7 @@
 #include "gpu/context.hpp"
 #include "logger/logger.hpp"
 #include "nodes/system/register.hpp"
+#include "static_files/files.hpp"
 #include "types/node_status_json.hpp"
 #include "utils/filesystem.hpp"
 #include "utils/process_id.hpp"
@@ -101,12 +103,16 @@ int miximus_main(core::command_line_options_s command_line_options, std::string_
 
     try {
         {
+            // Shaders and images are decoded in the background while the app
+            // starts, instead of on the config and render threads
+            const auto resource_warm_up = static_files::get_resource_files().warm_up();
+
             core::app_state_s app(std::move(command_line_options));
             // web_server declared AFTER app so it is destroyed BEFORE app — the
-            // websocketpp endpoint holds a raw pointer to cfg_executor_ and must
-            // not outlive it.
+            // server posts client commands to cfg_executor_ and must not
+            // outlive it.
             auto web_server = web_server::create_web_server();
-            web_server->start(HTTP_PORT, app.cfg_executor());
+            web_server->start(HTTP_PORT, app.cfg_executor(), app.command_line_options().http_threads);
 
             core::node_manager_s  node_manager;
             core::configuration_s configuration(node_manager);
@@ -123,6 +129,13 @@ int miximus_main(core::command_line_options_s command_line_options, std::string_
             // Add adapters _after_ config is loaded to prevent spam to the adapters during load
             node_manager.add_adapter(
                 core::create_websocket_adapter(node_manager, configuration, *web_server, *app.font_registry()));
+            if (const auto interval = app.command_line_options().autosave_interval; interval.count() > 0.0) {
+                node_manager.add_adapter(core::create_autosave_adapter(
+                    configuration,
+                    app.command_line_options().settings_path,
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval),
+                    app.status_registry()));
+            }
 
             core::steady_clock_source_s                            frame_clock;
             core::frame_scheduler_s                                frame_scheduler(frame_clock);
@@ -164,6 +177,8 @@ int miximus_main(core::command_line_options_s command_line_options, std::string_
             web_server->stop();
             node_manager.clear_adapters();
             try {
+                getlog("app")->info("Writing settings to {}",
+                                    utils::path_to_utf8(app.command_line_options().settings_path));
                 configuration.save_file(app.command_line_options().settings_path);
             } catch (const std::exception& error) {
                 getlog("app")->error("Failed to save configuration: {}", error.what());
@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace miximus::media {
+
+// Fixed-capacity, lock-free handoff from one producer thread to one consumer
+// thread. Slots are preallocated and sequenced per cell, so neither side
+// allocates or blocks. The producer may also pop the oldest element to make
+// room for a newer one; pops therefore claim their cell with a CAS on the head
+// while pushes stay wait-free.
+template <typename T>
+class frame_handoff_ring_s
+{
+    struct cell_s
+    {
+        std::atomic_size_t sequence;
+        std::optional<T>   value;
+    };
+
+    // Keep the producer and consumer indices on separate cache lines so the
+    // capture callback and the render thread do not invalidate each other.
+    static constexpr size_t CACHE_LINE_BYTES = 64;
+
+    std::unique_ptr<cell_s[]> cells_;
+    size_t                    mask_;
+    alignas(CACHE_LINE_BYTES) std::atomic_size_t head_{};
+    alignas(CACHE_LINE_BYTES) std::atomic_size_t tail_{};
+
+  public:
+    explicit frame_handoff_ring_s(size_t capacity)
+        : cells_(std::make_unique<cell_s[]>(std::bit_ceil(capacity)))
+        , mask_(std::bit_ceil(capacity) - 1)
+    {
+        if (capacity == 0) {
+            throw std::invalid_argument("frame handoff ring capacity must be positive");
+        }
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    frame_handoff_ring_s(const frame_handoff_ring_s&)            = delete;
+    frame_handoff_ring_s(frame_handoff_ring_s&&)                 = delete;
+    frame_handoff_ring_s& operator=(const frame_handoff_ring_s&) = delete;
+    frame_handoff_ring_s& operator=(frame_handoff_ring_s&&)      = delete;
+
+    size_t capacity() const noexcept { return mask_ + 1; }
+
+    // Producer only. Returns false without consuming `value` when every cell
+    // is occupied or still being released by a concurrent pop.
+    bool try_push(T& value) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        const auto position = tail_.load(std::memory_order_relaxed);
+        auto&      cell     = cells_[position & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != position) {
+            return false;
+        }
+        cell.value.emplace(std::move(value));
+        tail_.store(position + 1, std::memory_order_relaxed);
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer, or the producer evicting the oldest element.
+    std::optional<T> try_pop() noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        auto position = head_.load(std::memory_order_relaxed);
+        while (true) {
+            auto&      cell     = cells_[position & mask_];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto distance = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+            if (distance < 0) {
+                return std::nullopt;
+            }
+            if (distance > 0) {
+                position = head_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                std::optional<T> value(std::move(cell.value));
+                cell.value.reset();
+                cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                return value;
+            }
+        }
+    }
+};
+
+} // namespace miximus::media
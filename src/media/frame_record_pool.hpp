@@ -0,0 +1,232 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace miximus::media {
+
+template <typename Frame>
+class frame_record_pool_s;
+
+// Intrusively counted reference to a frame record. Copies only touch the
+// record's own counter; dropping the last reference destroys the frame on the
+// releasing thread and returns its storage to the pool.
+template <typename Frame>
+class frame_record_ptr_s
+{
+    using pool_t   = frame_record_pool_s<Frame>;
+    using record_t = typename pool_t::record_s;
+
+    friend class frame_record_pool_s<Frame>;
+
+    record_t* record_{};
+
+    explicit frame_record_ptr_s(record_t* record) noexcept
+        : record_(record)
+    {
+    }
+
+    void release() noexcept
+    {
+        if (record_ != nullptr && record_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            pool_t::recycle(record_);
+        }
+        record_ = nullptr;
+    }
+
+  public:
+    frame_record_ptr_s() = default;
+    frame_record_ptr_s(std::nullptr_t) noexcept {}
+
+    frame_record_ptr_s(const frame_record_ptr_s& other) noexcept
+        : record_(other.record_)
+    {
+        if (record_ != nullptr) {
+            record_->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    frame_record_ptr_s(frame_record_ptr_s&& other) noexcept
+        : record_(std::exchange(other.record_, nullptr))
+    {
+    }
+
+    frame_record_ptr_s& operator=(const frame_record_ptr_s& other) noexcept
+    {
+        if (this != &other) {
+            frame_record_ptr_s copy(other);
+            std::swap(record_, copy.record_);
+        }
+        return *this;
+    }
+
+    frame_record_ptr_s& operator=(frame_record_ptr_s&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            record_ = std::exchange(other.record_, nullptr);
+        }
+        return *this;
+    }
+
+    ~frame_record_ptr_s() { release(); }
+
+    void     reset() noexcept { release(); }
+    Frame*   get() const noexcept { return record_ != nullptr ? &*record_->frame : nullptr; }
+    Frame&   operator*() const noexcept { return *record_->frame; }
+    Frame*   operator->() const noexcept { return &*record_->frame; }
+    explicit operator bool() const noexcept { return record_ != nullptr; }
+
+    friend bool operator==(const frame_record_ptr_s& lhs, const frame_record_ptr_s& rhs) noexcept
+    {
+        return lhs.record_ == rhs.record_;
+    }
+    friend bool operator==(const frame_record_ptr_s& lhs, std::nullptr_t) noexcept { return lhs.record_ == nullptr; }
+};
+
+struct frame_record_pool_metrics_s
+{
+    size_t   records{};
+    uint64_t reused{};
+    uint64_t allocations{};
+};
+
+// Fixed set of preallocated frame records with a lock-free free list. Records
+// may be released from any thread. When every record is in use the pool falls
+// back to a heap allocation, which is counted so the sizing can be checked in
+// node status. Outstanding records keep the pool alive.
+template <typename Frame>
+class frame_record_pool_s : public std::enable_shared_from_this<frame_record_pool_s<Frame>>
+{
+    friend class frame_record_ptr_s<Frame>;
+
+    struct record_s
+    {
+        std::optional<Frame>                 frame;
+        std::atomic_uint32_t                 references;
+        std::atomic_uint32_t                 next_free;
+        std::shared_ptr<frame_record_pool_s> owner;
+        bool                                 pooled{};
+        // Set on first use, so only later uses of the record count as reuse
+        bool                                 used{};
+    };
+
+    // The free list head packs a generation tag above a one-based record
+    // index so a record recycled between a load and a CAS cannot be mistaken
+    // for the one that was read.
+    static constexpr uint64_t INDEX_MASK = 0xffff'ffff;
+
+    std::unique_ptr<record_s[]> records_;
+    size_t                      record_count_;
+    std::atomic_uint64_t        free_head_{};
+    std::atomic_uint64_t        reused_{};
+    std::atomic_uint64_t        allocations_{};
+
+    struct private_tag_s
+    {
+    };
+
+    void push_free(record_s* record) noexcept
+    {
+        const auto index = static_cast<uint64_t>(record - records_.get()) + 1;
+        auto       head  = free_head_.load(std::memory_order_relaxed);
+        do {
+            record->next_free.store(static_cast<uint32_t>(head & INDEX_MASK), std::memory_order_relaxed);
+        } while (!free_head_.compare_exchange_weak(
+            head, ((head & ~INDEX_MASK) + (INDEX_MASK + 1)) | index, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    record_s* pop_free() noexcept
+    {
+        auto head = free_head_.load(std::memory_order_acquire);
+        while ((head & INDEX_MASK) != 0) {
+            auto*      record = &records_[(head & INDEX_MASK) - 1];
+            const auto next   = static_cast<uint64_t>(record->next_free.load(std::memory_order_relaxed));
+            if (free_head_.compare_exchange_weak(head,
+                                                 ((head & ~INDEX_MASK) + (INDEX_MASK + 1)) | next,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_acquire)) {
+                return record;
+            }
+        }
+        return nullptr;
+    }
+
+    static void recycle(record_s* record) noexcept
+    {
+        record->frame.reset();
+        // The pool may only go away once the record is back on its free list.
+        auto owner = std::move(record->owner);
+        if (record->pooled) {
+            owner->push_free(record);
+        } else {
+            delete record;
+        }
+    }
+
+  public:
+    frame_record_pool_s(private_tag_s /*tag*/, size_t record_count)
+        : records_(std::make_unique<record_s[]>(record_count))
+        , record_count_(record_count)
+    {
+        if (record_count > INDEX_MASK - 1) {
+            throw std::invalid_argument("frame record pool is too large");
+        }
+        for (size_t i = 0; i < record_count; ++i) {
+            records_[i].pooled = true;
+            push_free(&records_[i]);
+        }
+    }
+
+    static std::shared_ptr<frame_record_pool_s> create(size_t record_count)
+    {
+        return std::make_shared<frame_record_pool_s>(private_tag_s{}, record_count);
+    }
+
+    frame_record_pool_s(const frame_record_pool_s&)            = delete;
+    frame_record_pool_s(frame_record_pool_s&&)                 = delete;
+    frame_record_pool_s& operator=(const frame_record_pool_s&) = delete;
+    frame_record_pool_s& operator=(frame_record_pool_s&&)      = delete;
+
+    template <typename... Args>
+    frame_record_ptr_s<Frame> acquire(Args&&... args)
+    {
+        auto* record = pop_free();
+        if (record == nullptr) {
+            record = new record_s;
+            allocations_.fetch_add(1, std::memory_order_relaxed);
+        } else if (record->used) {
+            reused_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        try {
+            record->frame.emplace(std::forward<Args>(args)...);
+        } catch (...) {
+            if (record->pooled) {
+                push_free(record);
+            } else {
+                delete record;
+            }
+            throw;
+        }
+        record->used  = true;
+        record->owner = this->shared_from_this();
+        record->references.store(1, std::memory_order_relaxed);
+        return frame_record_ptr_s<Frame>(record);
+    }
+
+    frame_record_pool_metrics_s metrics() const noexcept
+    {
+        return {
+            .records     = record_count_,
+            .reused      = reused_.load(std::memory_order_relaxed),
+            .allocations = allocations_.load(std::memory_order_relaxed),
+        };
+    }
+};
+
+} // namespace miximus::media
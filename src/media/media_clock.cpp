@@ -7,6 +7,30 @@
 #include <stdexcept>
 
 namespace miximus::media {
+namespace {
+using rep_t = utils::flicks::rep;
+
+// 2^63, the magnitude bound of a signed 64-bit flick count, exactly.
+constexpr double REP_RANGE = 9'223'372'036'854'775'808.0;
+
+std::optional<rep_t> checked_sum(rep_t lhs, rep_t rhs) noexcept
+{
+    if ((rhs > 0 && lhs > std::numeric_limits<rep_t>::max() - rhs) ||
+        (rhs < 0 && lhs < std::numeric_limits<rep_t>::min() - rhs)) {
+        return std::nullopt;
+    }
+    return lhs + rhs;
+}
+
+std::optional<rep_t> checked_difference(rep_t lhs, rep_t rhs) noexcept
+{
+    if ((rhs < 0 && lhs > std::numeric_limits<rep_t>::max() + rhs) ||
+        (rhs > 0 && lhs < std::numeric_limits<rep_t>::min() + rhs)) {
+        return std::nullopt;
+    }
+    return lhs - rhs;
+}
+} // namespace
 
 media_to_program_clock_s::media_to_program_clock_s(media_clock_mapping_config_s config)
     : config_(config)
@@ -34,12 +58,8 @@ media_clock_observation_e media_to_program_clock_s::observe(const media_clock_sa
         rate_reference_frame_sequence_ = sample.frame_sequence;
         rate_media_reference_          = sample.media_pts;
         rate_program_reference_        = program_time_observation;
-        rate_media_sum_                = 0.0L;
-        rate_program_sum_              = 0.0L;
-        rate_media_squared_sum_        = 0.0L;
-        rate_media_program_sum_        = 0.0L;
-        rate_sample_count_             = 0;
         rate_                          = 1.0;
+        rate_regression_.reset();
         observed_rate_.reset();
         phase_error_.reset();
         phase_adjustment_.reset();
@@ -69,24 +89,15 @@ media_clock_observation_e media_to_program_clock_s::observe(const media_clock_sa
     const auto rate_media_delta   = sample.media_pts - rate_media_reference_;
     const auto rate_program_delta = program_time_observation - rate_program_reference_;
     if (rate_media_delta > utils::flicks::zero() && rate_program_delta > utils::flicks::zero()) {
-        const auto media   = static_cast<long double>(rate_media_delta.count());
-        const auto program = static_cast<long double>(rate_program_delta.count());
-        rate_media_sum_ += media;
-        rate_program_sum_ += program;
-        rate_media_squared_sum_ += media * media;
-        rate_media_program_sum_ += media * program;
-        ++rate_sample_count_;
+        rate_regression_.add(static_cast<double>(rate_media_delta.count()),
+                             static_cast<double>(rate_program_delta.count()));
     }
 
     if (sample.frame_sequence - rate_reference_frame_sequence_ >= config_.rate_observation_frames) {
-        const auto sample_count = static_cast<long double>(rate_sample_count_);
-        const auto denominator  = (sample_count * rate_media_squared_sum_) - (rate_media_sum_ * rate_media_sum_);
-        if (denominator > 0.0L) {
-            const auto numerator     = (sample_count * rate_media_program_sum_) - (rate_media_sum_ * rate_program_sum_);
-            const auto observed_rate = static_cast<double>(numerator / denominator);
-            observed_rate_           = observed_rate;
+        if (const auto observed_rate = rate_regression_.slope()) {
+            observed_rate_               = *observed_rate;
             const auto maximum_deviation = config_.maximum_rate_deviation_ppm / 1'000'000.0;
-            const auto bounded_rate      = std::clamp(observed_rate, 1.0 - maximum_deviation, 1.0 + maximum_deviation);
+            const auto bounded_rate      = std::clamp(*observed_rate, 1.0 - maximum_deviation, 1.0 + maximum_deviation);
             media_anchor_                = sample.media_pts;
             program_anchor_              = *predicted;
             rate_ += (bounded_rate - rate_) / static_cast<double>(config_.rate_filter_divisor);
@@ -94,11 +105,7 @@ media_clock_observation_e media_to_program_clock_s::observe(const media_clock_sa
         rate_reference_frame_sequence_ = sample.frame_sequence;
         rate_media_reference_          = sample.media_pts;
         rate_program_reference_        = program_time_observation;
-        rate_media_sum_                = 0.0L;
-        rate_program_sum_              = 0.0L;
-        rate_media_squared_sum_        = 0.0L;
-        rate_media_program_sum_        = 0.0L;
-        rate_sample_count_             = 0;
+        rate_regression_.reset();
     }
 
     const auto error   = program_time_observation - *predicted;
@@ -121,15 +128,21 @@ media_to_program_clock_s::map_media_pts_to_program_time(utils::flicks media_pts)
     if (!stream_epoch_.has_value()) {
         return std::nullopt;
     }
-    const auto media_delta =
-        static_cast<long double>(media_pts.count()) - static_cast<long double>(media_anchor_.count());
-    const auto mapped_count =
-        static_cast<long double>(program_anchor_.count()) + std::round(media_delta * static_cast<long double>(rate_));
-    if (mapped_count < static_cast<long double>(std::numeric_limits<utils::flicks::rep>::min()) ||
-        mapped_count > static_cast<long double>(std::numeric_limits<utils::flicks::rep>::max())) {
+    // Offsets and anchors stay in exact integer arithmetic; only the rate
+    // scaling of the offset from the anchor goes through a double.
+    const auto media_delta = checked_difference(media_pts.count(), media_anchor_.count());
+    if (!media_delta.has_value()) {
+        return std::nullopt;
+    }
+    const auto scaled_delta = std::round(static_cast<double>(*media_delta) * rate_);
+    if (!(scaled_delta >= -REP_RANGE && scaled_delta < REP_RANGE)) {
+        return std::nullopt;
+    }
+    const auto mapped_count = checked_sum(program_anchor_.count(), static_cast<utils::flicks::rep>(scaled_delta));
+    if (!mapped_count.has_value()) {
         return std::nullopt;
     }
-    return utils::flicks{static_cast<utils::flicks::rep>(mapped_count)};
+    return utils::flicks{*mapped_count};
 }
 
 std::optional<double> media_to_program_clock_s::recovered_rate() const noexcept
@@ -160,12 +173,8 @@ void media_to_program_clock_s::reset() noexcept
     rate_reference_frame_sequence_ = 0;
     rate_media_reference_          = {};
     rate_program_reference_        = {};
-    rate_media_sum_                = 0.0L;
-    rate_program_sum_              = 0.0L;
-    rate_media_squared_sum_        = 0.0L;
-    rate_media_program_sum_        = 0.0L;
-    rate_sample_count_             = 0;
     rate_                          = 1.0;
+    rate_regression_.reset();
     observed_rate_.reset();
     phase_error_.reset();
     phase_adjustment_.reset();
@@ -1,5 +1,6 @@
 #pragma once
 #include "media/media_clock_sample.hpp"
+#include "media/rate_regression.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -36,11 +37,7 @@ class media_to_program_clock_s
     uint64_t                     rate_reference_frame_sequence_{};
     utils::flicks                rate_media_reference_{};
     utils::flicks                rate_program_reference_{};
-    long double                  rate_media_sum_{};
-    long double                  rate_program_sum_{};
-    long double                  rate_media_squared_sum_{};
-    long double                  rate_media_program_sum_{};
-    size_t                       rate_sample_count_{};
+    rate_regression_s            rate_regression_;
     double                       rate_{1.0};
     std::optional<double>        observed_rate_;
     std::optional<utils::flicks> phase_error_;
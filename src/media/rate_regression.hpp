@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+
+namespace miximus::media {
+
+// Least-squares fit of a clock rate near 1 from (media, program) offsets.
+// The fit regresses the residual program - media against the media offset,
+// which removes the unit slope before any product is formed. The products
+// then stay small enough for plain double sums to match an extended-precision
+// accumulator, so the estimator needs neither long double (slow x87 code on
+// x86, plain double on MSVC, software emulation on some ARM targets) nor
+// compensated summation. Offsets are taken relative to the first observation
+// after a reset. Observations can be removed again, so callers may re-fit
+// over a sliding window as well as over fixed blocks.
+class rate_regression_s
+{
+    double media_origin_{};
+    double program_origin_{};
+    double x_sum_{};
+    double residual_sum_{};
+    double x_squared_sum_{};
+    double x_residual_sum_{};
+    size_t count_{};
+
+  public:
+    void add(double media, double program) noexcept
+    {
+        if (count_ == 0) {
+            media_origin_   = media;
+            program_origin_ = program;
+        }
+        const auto x        = media - media_origin_;
+        const auto residual = (program - program_origin_) - x;
+        x_sum_ += x;
+        residual_sum_ += residual;
+        x_squared_sum_ += x * x;
+        x_residual_sum_ += x * residual;
+        ++count_;
+    }
+
+    // Removes an observation that was previously added with the same values.
+    void remove(double media, double program) noexcept
+    {
+        if (count_ <= 1) {
+            reset();
+            return;
+        }
+        const auto x        = media - media_origin_;
+        const auto residual = (program - program_origin_) - x;
+        x_sum_ -= x;
+        residual_sum_ -= residual;
+        x_squared_sum_ -= x * x;
+        x_residual_sum_ -= x * residual;
+        --count_;
+    }
+
+    void reset() noexcept { *this = {}; }
+
+    size_t size() const noexcept { return count_; }
+
+    std::optional<double> slope() const noexcept
+    {
+        const auto count       = static_cast<double>(count_);
+        const auto denominator = (count * x_squared_sum_) - (x_sum_ * x_sum_);
+        if (count_ < 2 || !(denominator > 0.0)) {
+            return std::nullopt;
+        }
+        return 1.0 + (((count * x_residual_sum_) - (x_sum_ * residual_sum_)) / denominator);
+    }
+};
+
+} // namespace miximus::media
@@ -0,0 +1,92 @@
+#include "source_sync_group.hpp"
+
+#include <algorithm>
+
+namespace miximus::media {
+
+auto source_sync_registry_s::begin_program_frame(std::string_view group, utils::flicks program_pts) -> group_s&
+{
+    auto it = groups_.find(group);
+    if (it == groups_.end()) {
+        it = groups_.emplace(std::string(group), group_s{}).first;
+    }
+
+    auto& state = it->second;
+    if (state.program_pts == program_pts) {
+        return state;
+    }
+
+    if (state.program_pts.has_value()) {
+        state.metrics.members = state.members;
+        state.metrics.skew.reset();
+        if (state.earliest_selected.has_value() && state.latest_selected.has_value()) {
+            state.metrics.skew     = *state.latest_selected - *state.earliest_selected;
+            state.metrics.skew_max = std::max(state.metrics.skew_max.value_or(utils::flicks{}), *state.metrics.skew);
+        }
+        state.metrics.hold_back.reset();
+        if (state.earliest_offer.has_value()) {
+            state.metrics.hold_back = std::max(*state.program_pts - *state.earliest_offer, utils::flicks{});
+        }
+    }
+
+    state.program_pts = program_pts;
+    state.members     = 0;
+    state.earliest_offer.reset();
+    state.earliest_selected.reset();
+    state.latest_selected.reset();
+    return state;
+}
+
+auto source_sync_registry_s::find_current(std::string_view group, utils::flicks program_pts) const -> const group_s*
+{
+    const auto it = groups_.find(group);
+    if (it == groups_.end() || it->second.program_pts != program_pts) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void source_sync_registry_s::offer(std::string_view             group,
+                                   utils::flicks                program_pts,
+                                   utils::flicks                frame_duration,
+                                   std::optional<utils::flicks> presentable_pts)
+{
+    auto& state = begin_program_frame(group, program_pts);
+    ++state.members;
+    // Waiting on a stalled member would freeze the whole group behind a source
+    // that has gone away.
+    if (!presentable_pts.has_value() || *presentable_pts + frame_duration + (frame_duration / 2) < program_pts) {
+        return;
+    }
+    state.earliest_offer = std::min(state.earliest_offer.value_or(*presentable_pts), *presentable_pts);
+}
+
+utils::flicks source_sync_registry_s::selection_pts(std::string_view group, utils::flicks program_pts) const
+{
+    const auto* state = find_current(group, program_pts);
+    if (state == nullptr || !state->earliest_offer.has_value()) {
+        return program_pts;
+    }
+    return std::min(program_pts, *state->earliest_offer);
+}
+
+void source_sync_registry_s::report_selection(std::string_view group,
+                                              utils::flicks    program_pts,
+                                              utils::flicks    selected_program_pts)
+{
+    auto& state = begin_program_frame(group, program_pts);
+    state.earliest_selected =
+        std::min(state.earliest_selected.value_or(selected_program_pts), selected_program_pts);
+    state.latest_selected = std::max(state.latest_selected.value_or(selected_program_pts), selected_program_pts);
+}
+
+source_sync_group_metrics_s source_sync_registry_s::metrics(std::string_view group) const
+{
+    const auto it = groups_.find(group);
+    if (it == groups_.end()) {
+        return {};
+    }
+    return it->second.metrics;
+}
+
+} // namespace miximus::media
@@ -0,0 +1,60 @@
+#pragma once
+#include "utils/flicks.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace miximus::media {
+
+struct source_sync_group_metrics_s
+{
+    size_t                       members{};
+    std::optional<utils::flicks> skew;
+    std::optional<utils::flicks> skew_max;
+    std::optional<utils::flicks> hold_back;
+};
+
+// Coordinates frame selection between timed sources that are locked upstream.
+// Each member offers the aligned program time of the frame it would present
+// for the current program frame. Members then select at the earliest offer,
+// so all of them present frames captured at the same instant and the group
+// shares the playout delay of its slowest member. A member whose frame is
+// more than a frame and a half old is treated as stalled and no longer holds
+// the group back. Skew and hold-back are measured per program frame and
+// reported one frame later. Render thread only.
+class source_sync_registry_s
+{
+    struct group_s
+    {
+        std::optional<utils::flicks> program_pts;
+        size_t                       members{};
+        std::optional<utils::flicks> earliest_offer;
+        std::optional<utils::flicks> earliest_selected;
+        std::optional<utils::flicks> latest_selected;
+        source_sync_group_metrics_s  metrics;
+    };
+
+    std::map<std::string, group_s, std::less<>> groups_;
+
+    group_s&       begin_program_frame(std::string_view group, utils::flicks program_pts);
+    const group_s* find_current(std::string_view group, utils::flicks program_pts) const;
+
+  public:
+    void offer(std::string_view             group,
+               utils::flicks                program_pts,
+               utils::flicks                frame_duration,
+               std::optional<utils::flicks> presentable_pts);
+
+    // The program time a member should select at, never later than its own.
+    utils::flicks selection_pts(std::string_view group, utils::flicks program_pts) const;
+
+    void report_selection(std::string_view group, utils::flicks program_pts, utils::flicks selected_program_pts);
+
+    source_sync_group_metrics_s metrics(std::string_view group) const;
+};
+
+} // namespace miximus::media
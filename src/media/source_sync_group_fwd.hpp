@@ -0,0 +1,5 @@
+#pragma once
+
+namespace miximus::media {
+class source_sync_registry_s;
+} // namespace miximus::media
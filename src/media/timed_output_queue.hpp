@@ -1,15 +1,12 @@
 #pragma once
 #include "utils/flicks.hpp"
 
-#include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <deque>
-#include <iterator>
 #include <optional>
-#include <ranges>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace miximus::media {
 
@@ -54,16 +51,30 @@ class timed_output_queue_s
 {
     using frame_t = output_frame_s<T>;
 
-    timed_output_queue_config_s  config_;
-    std::deque<frame_t>          frames_;
-    std::optional<frame_t>       current_;
-    timed_output_queue_metrics_s metrics_;
+    // Frames live in a preallocated ring ordered by target time, so pushing
+    // and selecting move payloads between slots instead of allocating.
+    timed_output_queue_config_s         config_;
+    std::vector<std::optional<frame_t>> slots_;
+    size_t                              head_{};
+    size_t                              size_{};
+    std::optional<frame_t>              current_;
+    timed_output_queue_metrics_s        metrics_;
 
     static bool precedes(const frame_t& lhs, const frame_t& rhs) noexcept
     {
         return lhs.program_target_time < rhs.program_target_time;
     }
 
+    std::optional<frame_t>&       at(size_t index) noexcept { return slots_[(head_ + index) % slots_.size()]; }
+    const std::optional<frame_t>& at(size_t index) const noexcept { return slots_[(head_ + index) % slots_.size()]; }
+
+    void pop_front() noexcept
+    {
+        at(0).reset();
+        head_ = (head_ + 1) % slots_.size();
+        --size_;
+    }
+
   public:
     explicit timed_output_queue_s(timed_output_queue_config_s config = {})
         : config_(config)
@@ -71,6 +82,8 @@ class timed_output_queue_s
         if (config_.capacity == 0) {
             throw std::invalid_argument("timed output queue capacity must be positive");
         }
+        // One spare slot holds the incoming frame before overflow trimming.
+        slots_.resize(config_.capacity + 1);
     }
 
     timed_output_queue_s(const timed_output_queue_s&)            = delete;
@@ -85,12 +98,15 @@ class timed_output_queue_s
             return;
         }
 
-        const auto position = std::ranges::upper_bound(frames_, frame, precedes);
-        frames_.insert(position, std::move(frame));
+        at(size_).emplace(std::move(frame));
+        ++size_;
+        for (auto index = size_ - 1; index > 0 && precedes(*at(index), *at(index - 1)); --index) {
+            std::swap(at(index), at(index - 1));
+        }
         ++metrics_.pushed;
 
-        while (frames_.size() > config_.capacity) {
-            frames_.pop_front();
+        while (size_ > config_.capacity) {
+            pop_front();
             ++metrics_.overflow_drops;
         }
     }
@@ -98,15 +114,17 @@ class timed_output_queue_s
     output_frame_selection_s<T> select(utils::flicks program_target_time)
     {
         const auto limit    = program_target_time + config_.early_tolerance;
-        auto       selected = frames_.end();
-        for (auto it = frames_.begin(); it != frames_.end() && it->program_target_time <= limit; ++it) {
-            selected = it;
+        size_t     eligible = 0;
+        while (eligible < size_ && at(eligible)->program_target_time <= limit) {
+            ++eligible;
         }
 
-        if (selected != frames_.end()) {
-            metrics_.selection_drops += static_cast<uint64_t>(std::distance(frames_.begin(), selected));
-            current_ = std::move(*selected);
-            frames_.erase(frames_.begin(), std::next(selected));
+        if (eligible != 0) {
+            metrics_.selection_drops += static_cast<uint64_t>(eligible - 1);
+            current_ = std::move(at(eligible - 1));
+            for (size_t i = 0; i < eligible; ++i) {
+                pop_front();
+            }
             return {.selection = output_frame_selection_e::new_frame, .frame = &*current_};
         }
 
@@ -120,14 +138,14 @@ class timed_output_queue_s
     }
 
     const timed_output_queue_metrics_s& metrics() const noexcept { return metrics_; }
-    size_t                              queued() const noexcept { return frames_.size(); }
+    size_t                              queued() const noexcept { return size_; }
     size_t                              capacity() const noexcept { return config_.capacity; }
     std::optional<utils::flicks>        oldest_program_target_time() const noexcept
     {
-        if (frames_.empty()) {
+        if (size_ == 0) {
             return std::nullopt;
         }
-        return frames_.front().program_target_time;
+        return at(0)->program_target_time;
     }
 };
 
@@ -1,4 +1,6 @@
 #pragma once
+#include "media/frame_handoff_ring.hpp"
+#include "media/frame_record_pool.hpp"
 #include "media/media_clock.hpp"
 
 #include <algorithm>
@@ -8,10 +10,10 @@
 #include <deque>
 #include <iterator>
 #include <memory>
-#include <mutex>
 #include <ranges>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace miximus::media {
 
@@ -114,7 +116,7 @@ class prepared_frame_ticket_s
 {
   public:
     using frame_t     = source_frame_s<T>;
-    using frame_ptr_t = std::shared_ptr<frame_t>;
+    using frame_ptr_t = frame_record_ptr_s<frame_t>;
 
   private:
     friend class timed_source_queue_s<T>;
@@ -122,11 +124,16 @@ class prepared_frame_ticket_s
     frame_ptr_t                frame_;
     prepared_frame_selection_e selection_{prepared_frame_selection_e::missing};
     bool                       discontinuity_{};
+    utils::flicks              program_pts_{};
 
-    prepared_frame_ticket_s(frame_ptr_t frame, prepared_frame_selection_e selection, bool discontinuity) noexcept
+    prepared_frame_ticket_s(frame_ptr_t                frame,
+                            prepared_frame_selection_e selection,
+                            bool                       discontinuity,
+                            utils::flicks              program_pts = {}) noexcept
         : frame_(std::move(frame))
         , selection_(selection)
         , discontinuity_(discontinuity)
+        , program_pts_(program_pts)
     {
     }
 
@@ -136,6 +143,8 @@ class prepared_frame_ticket_s
     const frame_ptr_t&         frame() const noexcept { return frame_; }
     prepared_frame_selection_e selection() const noexcept { return selection_; }
     bool                       discontinuity() const noexcept { return discontinuity_; }
+    // The aligned program time of the selected or repeated frame.
+    utils::flicks program_pts() const noexcept { return program_pts_; }
     bool                       await() const noexcept { return frame_ != nullptr && frame_->await(); }
 };
 
@@ -161,6 +170,7 @@ struct timed_source_queue_metrics_s
     uint64_t                     discontinuities{};
     uint64_t                     transfer_failures{};
     uint64_t                     transfer_cancellations{};
+    frame_record_pool_metrics_s  frame_records;
     std::optional<double>        recovered_rate;
     std::optional<double>        observed_rate;
     std::optional<utils::flicks> phase_offset;
@@ -175,38 +185,44 @@ class timed_source_queue_s
 {
   public:
     using frame_t     = source_frame_s<T>;
-    using frame_ptr_t = std::shared_ptr<frame_t>;
+    using frame_ptr_t = frame_record_ptr_s<frame_t>;
     using ticket_t    = prepared_frame_ticket_s<T>;
 
   private:
+    // Records beyond the queue capacity cover the committed frame, the
+    // prepared ticket, the frame being pushed and one being evicted.
+    static constexpr size_t FRAME_RECORD_HEADROOM = 4;
+
     struct aligned_frame_s
     {
         frame_ptr_t   frame;
         utils::flicks program_pts;
     };
 
-    timed_source_queue_config_s  config_;
-    media_to_program_clock_s     clock_;
-    mutable std::mutex           pending_mutex_;
-    std::deque<frame_ptr_t>      pending_;
-    std::deque<aligned_frame_s>  frames_;
-    frame_ptr_t                  current_;
-    std::optional<utils::flicks> arrival_offset_origin_;
-    bool                         discontinuity_pending_{};
-    std::atomic_size_t           queued_frames_{};
-
-    std::atomic_uint64_t         pushed_{};
-    std::atomic_uint64_t         overflow_drops_{};
-    std::atomic_uint64_t         selection_drops_{};
-    std::atomic_uint64_t         repeated_{};
-    std::atomic_uint64_t         starvation_repeats_{};
-    std::atomic_uint64_t         timing_repeats_{};
-    std::atomic_uint64_t         missing_{};
-    std::atomic_uint64_t         discontinuities_{};
-    std::atomic_uint64_t         transfer_failures_{};
-    std::atomic_uint64_t         transfer_cancellations_{};
-    std::optional<utils::flicks> repeat_next_frame_lead_min_;
-    std::optional<utils::flicks> repeat_next_frame_lead_max_;
+    timed_source_queue_config_s                   config_;
+    media_to_program_clock_s                      clock_;
+    std::shared_ptr<frame_record_pool_s<frame_t>> frame_records_;
+    frame_handoff_ring_s<frame_ptr_t>             pending_;
+    std::vector<frame_ptr_t>                      drained_;
+    std::deque<aligned_frame_s>                   frames_;
+    frame_ptr_t                                   current_;
+    utils::flicks                                 current_program_pts_{};
+    std::optional<utils::flicks>                  arrival_offset_origin_;
+    bool                                          discontinuity_pending_{};
+    std::atomic_size_t                            queued_frames_{};
+
+    std::atomic_uint64_t                          pushed_{};
+    std::atomic_uint64_t                          overflow_drops_{};
+    std::atomic_uint64_t                          selection_drops_{};
+    std::atomic_uint64_t                          repeated_{};
+    std::atomic_uint64_t                          starvation_repeats_{};
+    std::atomic_uint64_t                          timing_repeats_{};
+    std::atomic_uint64_t                          missing_{};
+    std::atomic_uint64_t                          discontinuities_{};
+    std::atomic_uint64_t                          transfer_failures_{};
+    std::atomic_uint64_t                          transfer_cancellations_{};
+    std::optional<utils::flicks>                  repeat_next_frame_lead_min_;
+    std::optional<utils::flicks>                  repeat_next_frame_lead_max_;
 
     bool retire(const ticket_t& ticket)
     {
@@ -256,6 +272,30 @@ class timed_source_queue_s
         return utils::flicks{phase};
     }
 
+    auto find_selectable(utils::flicks limit) const
+    {
+        auto selected = frames_.end();
+        for (auto it = frames_.begin(); it != frames_.end() && it->program_pts <= limit; ++it) {
+            if (selected == frames_.end() ||
+                it->frame->media_clock_sample.stream_epoch > selected->frame->media_clock_sample.stream_epoch ||
+                (it->frame->media_clock_sample.stream_epoch == selected->frame->media_clock_sample.stream_epoch &&
+                 it->frame->media_clock_sample.frame_sequence > selected->frame->media_clock_sample.frame_sequence)) {
+                selected = it;
+            }
+        }
+        return selected;
+    }
+
+    size_t cancel_pending() noexcept
+    {
+        size_t cancelled{};
+        while (auto frame = pending_.try_pop()) {
+            cancel_frame(*frame);
+            ++cancelled;
+        }
+        return cancelled;
+    }
+
     void clear_for_discontinuity(bool reset_clock)
     {
         if (reset_clock) {
@@ -277,6 +317,8 @@ class timed_source_queue_s
     explicit timed_source_queue_s(timed_source_queue_config_s config = {})
         : config_(config)
         , clock_(config.clock)
+        , frame_records_(frame_record_pool_s<frame_t>::create(config.capacity + FRAME_RECORD_HEADROOM))
+        , pending_(std::max<size_t>(config.capacity, 1))
     {
         if (config_.capacity == 0) {
             throw std::invalid_argument("timed source queue capacity must be positive");
@@ -284,16 +326,12 @@ class timed_source_queue_s
         if (config_.playout_delay_frames >= config_.capacity) {
             throw std::invalid_argument("timed source queue capacity must exceed its playout delay in frames");
         }
+        drained_.reserve(pending_.capacity());
     }
 
     ~timed_source_queue_s()
     {
-        {
-            const std::scoped_lock lock(pending_mutex_);
-            for (const auto& frame : pending_) {
-                cancel_frame(frame);
-            }
-        }
+        (void)cancel_pending();
         for (const auto& frame : frames_) {
             cancel_frame(frame.frame);
         }
@@ -310,28 +348,30 @@ class timed_source_queue_s
                              T                        payload,
                              source_frame_readiness_e readiness = source_frame_readiness_e::reserved) const
     {
-        return std::make_shared<frame_t>(clock_sample, program_arrival_time, std::move(payload), readiness);
+        return frame_records_->acquire(clock_sample, program_arrival_time, std::move(payload), readiness);
     }
 
+    // Called from the capture thread. Never blocks: a full queue evicts its
+    // oldest undelivered frame, or drops this one when every queued frame has
+    // already been handed to the render thread.
     void push(frame_ptr_t frame)
     {
         if (frame == nullptr) {
             return;
         }
 
-        const std::scoped_lock lock(pending_mutex_);
         pushed_.fetch_add(1, std::memory_order_relaxed);
 
         auto queued = queued_frames_.load(std::memory_order_relaxed);
         while (true) {
             if (queued >= config_.capacity) {
-                if (pending_.empty()) {
+                auto evicted = pending_.try_pop();
+                if (!evicted.has_value()) {
                     cancel_frame(frame);
                     overflow_drops_.fetch_add(1, std::memory_order_relaxed);
                     return;
                 }
-                cancel_frame(pending_.front());
-                pending_.pop_front();
+                cancel_frame(*evicted);
                 overflow_drops_.fetch_add(1, std::memory_order_relaxed);
                 break;
             }
@@ -340,21 +380,27 @@ class timed_source_queue_s
                 break;
             }
         }
-        try {
-            pending_.push_back(std::move(frame));
-        } catch (...) {
+        if (!pending_.try_push(frame)) {
+            // The render thread is still releasing the cell this push needs.
+            cancel_frame(frame);
             release_queued_frames(1);
-            throw;
+            overflow_drops_.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
     void advance(utils::flicks program_pts, utils::flicks program_target_time, bool program_discontinuity = false)
     {
-        std::deque<frame_ptr_t> pending;
-        {
-            const std::scoped_lock lock(pending_mutex_);
-            pending.swap(pending_);
+        // Drain at most one ring's worth so a producer outpacing the render
+        // thread cannot hold it here.
+        drained_.clear();
+        while (drained_.size() < pending_.capacity()) {
+            auto frame = pending_.try_pop();
+            if (!frame.has_value()) {
+                break;
+            }
+            drained_.push_back(std::move(*frame));
         }
+        auto& pending = drained_;
 
         if (program_discontinuity) {
             clear_for_discontinuity(true);
@@ -399,20 +445,27 @@ class timed_source_queue_s
                 std::ranges::upper_bound(frames_, aligned.program_pts, {}, &aligned_frame_s::program_pts);
             frames_.insert(insertion, std::move(aligned));
         }
+        drained_.clear();
     }
 
-    ticket_t select(utils::flicks program_pts, utils::flicks early_tolerance = {})
+    // The aligned program time of the frame select() would present: the
+    // newest eligible frame, or the current frame when it would repeat.
+    std::optional<utils::flicks> presentable_program_pts(utils::flicks program_pts,
+                                                         utils::flicks early_tolerance = {}) const
     {
-        const auto limit    = program_pts + config_.early_tolerance + early_tolerance;
-        auto       selected = frames_.end();
-        for (auto it = frames_.begin(); it != frames_.end() && it->program_pts <= limit; ++it) {
-            if (selected == frames_.end() ||
-                it->frame->media_clock_sample.stream_epoch > selected->frame->media_clock_sample.stream_epoch ||
-                (it->frame->media_clock_sample.stream_epoch == selected->frame->media_clock_sample.stream_epoch &&
-                 it->frame->media_clock_sample.frame_sequence > selected->frame->media_clock_sample.frame_sequence)) {
-                selected = it;
-            }
+        const auto selected = find_selectable(program_pts + config_.early_tolerance + early_tolerance);
+        if (selected != frames_.end()) {
+            return selected->program_pts;
+        }
+        if (current_ != nullptr) {
+            return current_program_pts_;
         }
+        return std::nullopt;
+    }
+
+    ticket_t select(utils::flicks program_pts, utils::flicks early_tolerance = {})
+    {
+        const auto selected = find_selectable(program_pts + config_.early_tolerance + early_tolerance);
 
         const bool discontinuity = std::exchange(discontinuity_pending_, false);
         if (selected != frames_.end()) {
@@ -432,9 +485,10 @@ class timed_source_queue_s
                     cancel_frame(frame.frame);
                 }
             }
+            const auto selected_pts = selected->program_pts;
             std::erase_if(frames_, is_older_source_frame);
             release_queued_frames(static_cast<size_t>(dropped));
-            return ticket_t(selected_frame, prepared_frame_selection_e::new_frame, discontinuity);
+            return ticket_t(selected_frame, prepared_frame_selection_e::new_frame, discontinuity, selected_pts);
         }
 
         if (current_ != nullptr) {
@@ -451,7 +505,7 @@ class timed_source_queue_s
                     repeat_next_frame_lead_max_ = lead;
                 }
             }
-            return ticket_t(current_, prepared_frame_selection_e::repeat, discontinuity);
+            return ticket_t(current_, prepared_frame_selection_e::repeat, discontinuity, current_program_pts_);
         }
 
         missing_.fetch_add(1, std::memory_order_relaxed);
@@ -475,7 +529,8 @@ class timed_source_queue_s
         }
         frames_.erase(match);
         release_queued_frames(1);
-        current_ = ticket.frame_;
+        current_             = ticket.frame_;
+        current_program_pts_ = ticket.program_pts_;
         return true;
     }
 
@@ -495,14 +550,7 @@ class timed_source_queue_s
 
     void reset()
     {
-        {
-            const std::scoped_lock lock(pending_mutex_);
-            for (const auto& frame : pending_) {
-                cancel_frame(frame);
-            }
-            release_queued_frames(pending_.size());
-            pending_.clear();
-        }
+        release_queued_frames(cancel_pending());
         clear_for_discontinuity(true);
     }
 
@@ -520,6 +568,7 @@ class timed_source_queue_s
             .discontinuities            = discontinuities_.load(std::memory_order_relaxed),
             .transfer_failures          = transfer_failures_.load(std::memory_order_relaxed),
             .transfer_cancellations     = transfer_cancellations_.load(std::memory_order_relaxed),
+            .frame_records              = frame_records_->metrics(),
             .recovered_rate             = clock_.recovered_rate(),
             .observed_rate              = clock_.observed_rate(),
             .phase_offset               = clock_.phase_offset(),
@@ -30,6 +30,11 @@ class node_impl : public node_i
   public:
     explicit node_impl() = default;
 
+    void prepare(core::app_state_s* /*app*/, const node_state_s& /*state*/, prepare_result_s* result) final
+    {
+        result->content_version = 0;
+    }
+
     void execute(core::app_state_s* app, const node_map_t& nodes, const node_state_s& state) final
     {
         auto fb = iface_fb_in_.resolve_value(app, nodes, state);
@@ -59,6 +64,7 @@ class node_impl : public node_i
         const auto fill_mode    = state.get_enum_option_unchecked<gpu::fill_mode_e>("fill_mode");
         const auto texture_draw = gpu::calculate_texture_draw(
             draw_rect, texture->display_dimensions(), fb->texture()->display_dimensions(), fill_mode);
+        texture->update_mip_maps_for(texture_draw, fb->texture()->display_dimensions());
 
         fb->begin_render();
 
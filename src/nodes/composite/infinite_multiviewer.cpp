@@ -28,6 +28,11 @@ class node_impl : public node_i
   public:
     explicit node_impl() { iface_tex_.set_max_connection_count(INT_MAX); }
 
+    void prepare(core::app_state_s* /*app*/, const node_state_s& /*state*/, prepare_result_s* result) final
+    {
+        result->content_version = 0;
+    }
+
     void execute(core::app_state_s* app, const node_map_t& nodes, const node_state_s& state) final
     {
         auto fb = iface_fb_in_.resolve_value(app, nodes, state);
@@ -74,6 +79,7 @@ class node_impl : public node_i
                 };
                 const auto texture_draw =
                     gpu::calculate_texture_draw(cell, texture->display_dimensions(), target_dimensions, fill_mode);
+                texture->update_mip_maps_for(texture_draw, target_dimensions);
 
                 batch.draw(texture, texture_draw);
             }
@@ -0,0 +1,202 @@
+#include "core/app_state.hpp"
+#include "glm/common.hpp"
+#include "gpu/context.hpp"
+#include "gpu/framebuffer.hpp"
+#include "gpu/geometry.hpp"
+#include "gpu/layer_compositor.hpp"
+#include "gpu/texture.hpp"
+#include "gpu/types.hpp"
+#include "nodes/interface.hpp"
+#include "nodes/node.hpp"
+#include "nodes/node_map.hpp"
+#include "nodes/normalize_option.hpp"
+
+#include <boost/container/small_vector.hpp>
+
+#include <array>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+using namespace miximus;
+using namespace miximus::nodes;
+
+using blend_mode_e = gpu::layer_compositor_s::blend_mode_e;
+
+struct layer_names_s
+{
+    std::string_view tex;
+    std::string_view rect;
+    std::string_view crop;
+    std::string_view opacity;
+    std::string_view blend_mode;
+};
+
+// Layer a is drawn first, at the bottom
+constexpr std::array LAYER_NAMES{
+    layer_names_s{"a_tex", "a_rect", "a_crop", "a_opacity", "a_blend_mode"},
+    layer_names_s{"b_tex", "b_rect", "b_crop", "b_opacity", "b_blend_mode"},
+    layer_names_s{"c_tex", "c_rect", "c_crop", "c_opacity", "c_blend_mode"},
+    layer_names_s{"d_tex", "d_rect", "d_crop", "d_opacity", "d_blend_mode"},
+    layer_names_s{"e_tex", "e_rect", "e_crop", "e_opacity", "e_blend_mode"},
+    layer_names_s{"f_tex", "f_rect", "f_crop", "f_opacity", "f_blend_mode"},
+    layer_names_s{"g_tex", "g_rect", "g_crop", "g_opacity", "g_blend_mode"},
+    layer_names_s{"h_tex", "h_rect", "h_crop", "h_opacity", "h_blend_mode"},
+};
+
+struct layer_inputs_s
+{
+    layer_names_s                      names;
+    input_interface_s<gpu::texture_s*> tex;
+    input_interface_s<gpu::rect_s>     rect;
+    input_interface_s<gpu::rect_s>     crop;
+    input_interface_s<double>          opacity;
+};
+
+/**
+ * Draws up to LayerCount textures into a framebuffer in a single render pass,
+ * replacing a chain of draw_box nodes. `crop` selects the part of a texture to
+ * draw in normalized texture coordinates, before the fill mode is applied.
+ */
+template <size_t LayerCount>
+class node_impl : public node_i
+{
+    static_assert(LayerCount <= LAYER_NAMES.size());
+
+    template <size_t... Indices>
+    static auto make_layers(node_i& owner, std::index_sequence<Indices...> /*indices*/)
+    {
+        return std::array<layer_inputs_s, LayerCount>{
+            layer_inputs_s{
+                .names   = LAYER_NAMES.at(Indices),
+                .tex     = {owner, LAYER_NAMES.at(Indices).tex},
+                .rect    = {owner, LAYER_NAMES.at(Indices).rect},
+                .crop    = {owner, LAYER_NAMES.at(Indices).crop},
+                .opacity = {owner, LAYER_NAMES.at(Indices).opacity},
+            }
+            ...
+        };
+    }
+
+    input_interface_s<gpu::framebuffer_s*>        iface_fb_in_{*this, "fb_in"};
+    std::array<layer_inputs_s, LayerCount>        layers_{make_layers(*this, std::make_index_sequence<LayerCount>{})};
+    output_interface_s<gpu::framebuffer_s*>       iface_fb_out_{*this, "fb_out"};
+    std::string_view                              type_;
+    std::string_view                              name_;
+    std::unique_ptr<gpu::layer_compositor_s>      compositor_;
+    std::vector<gpu::layer_compositor_s::layer_s> draws_;
+
+  public:
+    node_impl(std::string_view type, std::string_view name)
+        : type_(type)
+        , name_(name)
+    {
+    }
+
+    void prepare(core::app_state_s* /*app*/, const node_state_s& /*state*/, prepare_result_s* result) final
+    {
+        result->content_version = 0;
+    }
+
+    void execute(core::app_state_s* app, const node_map_t& nodes, const node_state_s& state) final
+    {
+        auto* fb = iface_fb_in_.resolve_value(app, nodes, state);
+        iface_fb_out_.set_value(fb);
+
+        if (fb == nullptr) {
+            return;
+        }
+
+        const auto target_dimensions = fb->texture()->display_dimensions();
+        const auto fill_mode         = state.get_enum_option_unchecked<gpu::fill_mode_e>("fill_mode");
+
+        draws_.clear();
+        for (const auto& layer : layers_) {
+            auto* texture = layer.tex.resolve_value(app, nodes, state);
+            if (texture == nullptr) {
+                continue;
+            }
+
+            const auto opacity_opt = state.get_option<double>(layer.names.opacity, 1.0);
+            const auto opacity     = glm::clamp(layer.opacity.resolve_value(app, nodes, state, opacity_opt), 0.0, 1.0);
+            if (opacity <= 0.0) {
+                continue;
+            }
+
+            const auto rect = layer.rect.resolve_value(app, nodes, state, gpu::rect_s{});
+            const auto crop = layer.crop.resolve_value(app, nodes, state, gpu::rect_s{});
+
+            // Fit the cropped region, then map the fitted source back into the crop
+            const gpu::vec2i_t cropped_dimensions =
+                glm::round(gpu::vec2_t(texture->display_dimensions()) * glm::abs(crop.size));
+            auto draw = gpu::calculate_texture_draw(rect, cropped_dimensions, target_dimensions, fill_mode);
+            draw.source.pos  = crop.pos + draw.source.pos * crop.size;
+            draw.source.size = draw.source.size * crop.size;
+            texture->update_mip_maps_for(draw, target_dimensions);
+
+            draws_.push_back({
+                .texture    = texture,
+                .draw       = draw,
+                .opacity    = opacity,
+                .blend_mode = state.get_enum_option_unchecked<blend_mode_e>(layer.names.blend_mode),
+            });
+        }
+
+        if (draws_.empty()) {
+            return;
+        }
+
+        if (!compositor_) {
+            auto* shader = app->ctx()->get_shader(gpu::shader_program_s::name_e::layer_composite);
+            compositor_  = std::make_unique<gpu::layer_compositor_s>(shader);
+        }
+
+        fb->begin_render();
+        compositor_->draw(draws_);
+        gpu::framebuffer_s::end_render();
+    }
+
+    nlohmann::json get_default_options() const final
+    {
+        nlohmann::json options = {
+            {"name",      name_                                  },
+            {"fill_mode", enum_to_string(gpu::fill_mode_e::scale)},
+        };
+        for (const auto& layer : layers_) {
+            options[layer.names.opacity]    = 1;
+            options[layer.names.blend_mode] = enum_to_string(blend_mode_e::normal);
+        }
+        return options;
+    }
+
+    option_result_e normalize_option(std::string_view name, nlohmann::json* value) const final
+    {
+        if (name == "fill_mode") {
+            return normalize_enum_option_value<gpu::fill_mode_e>(value);
+        }
+        for (const auto& layer : layers_) {
+            if (name == layer.names.opacity) {
+                return normalize_option_value<double>(value, 0, 1.0);
+            }
+            if (name == layer.names.blend_mode) {
+                return normalize_enum_option_value<blend_mode_e>(value);
+            }
+        }
+
+        return option_result_e::invalid;
+    }
+
+    std::string_view type() const final { return type_; }
+};
+
+} // namespace
+
+namespace miximus::nodes::composite {
+
+std::shared_ptr<node_i> create_layers_4_node() { return std::make_shared<node_impl<4>>("layers_4", "Layers x4"); }
+
+std::shared_ptr<node_i> create_layers_8_node() { return std::make_shared<node_impl<8>>("layers_8", "Layers x8"); }
+
+} // namespace miximus::nodes::composite
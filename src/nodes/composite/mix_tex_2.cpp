@@ -34,6 +34,11 @@ class node_impl : public node_i
     std::unique_ptr<gpu::textured_quad_s> textured_quad_;
 
   public:
+    void prepare(core::app_state_s* /*app*/, const node_state_s& /*state*/, prepare_result_s* result) final
+    {
+        result->content_version = 0;
+    }
+
     void submit(core::app_state_s* app, const node_map_t& nodes, const node_state_s& state) final
     {
         interface_i::submit_dependencies(app, nodes, iface_fb_in_.connections(state));
@@ -91,6 +96,8 @@ class node_impl : public node_i
         const auto blend_mode = state.get_enum_option_unchecked<blend_mode_e>("blend_mode");
         const auto mix_space  = blend_mode == blend_mode_e::video ? gpu::textured_quad_s::mix_space_e::video
                                                                   : gpu::textured_quad_s::mix_space_e::linear;
+        a->update_mip_maps_for(a_draw, target_dimensions);
+        b->update_mip_maps_for(b_draw, target_dimensions);
 
         framebuffer->begin_render();
 
@@ -6,6 +6,8 @@ namespace miximus::nodes::composite {
 
 std::shared_ptr<node_i> create_draw_box_node();
 std::shared_ptr<node_i> create_infinite_multiviewer_node();
+std::shared_ptr<node_i> create_layers_4_node();
+std::shared_ptr<node_i> create_layers_8_node();
 std::shared_ptr<node_i> create_mix_tex_2_node();
 
 void register_nodes(node_definition_map_t* map)
@@ -13,6 +15,8 @@ void register_nodes(node_definition_map_t* map)
     // Composite nodes
     map->emplace("draw_box", create_draw_box_node);
     map->emplace("infinite_multiviewer", create_infinite_multiviewer_node);
+    map->emplace("layers_4", create_layers_4_node);
+    map->emplace("layers_8", create_layers_8_node);
     map->emplace("mix_tex_2", create_mix_tex_2_node);
 }
 
@@ -2,6 +2,7 @@
 
 #include "allocator.hpp"
 #include "colorspace.hpp"
+#include "gpu/memory_registry.hpp"
 #include "gpu/texture.hpp"
 #include "gpu/transfer/texture_upload.hpp"
 #include "logger/logger.hpp"
@@ -61,6 +62,7 @@ class callback_s
     decklink_ptr<IDeckLinkInput>                            device_;
     std::shared_ptr<device_reservation_s<IDeckLinkInput>>   reservation_;
     std::string                                             device_name_;
+    std::string                                             memory_owner_;
     decklink_ptr<input_video_buffer_allocator_s>            allocator_;
     mutable std::mutex                                      upload_mutex_;
     std::shared_ptr<gpu::transfer::texture_upload_stream_s> upload_stream_;
@@ -330,6 +332,7 @@ class callback_s
         , device_(std::move(device))
         , reservation_(std::move(reservation))
         , device_name_(std::move(device_name))
+        , memory_owner_(gpu::memory_owner_scope_s::current())
     {
     }
 
@@ -397,9 +400,9 @@ class callback_s
                 // DeckLink continues cycling its independent buffer objects.
                 // Additional slots cover the published texture and asynchronous
                 // upload/reclaim without making StartAccess wait on rendering.
-                .max_slots         = input_video_buffer_allocator_s::UPLOAD_SLOT_COUNT,
-                .initial_slots     = input_video_buffer_allocator_s::INITIAL_UPLOAD_SLOT_COUNT,
-                .generate_mip_maps = false,
+                .max_slots     = input_video_buffer_allocator_s::UPLOAD_SLOT_COUNT,
+                .initial_slots = input_video_buffer_allocator_s::INITIAL_UPLOAD_SLOT_COUNT,
+                .memory_owner  = memory_owner_,
             });
 
             auto allocator = make_decklink_ptr<input_video_buffer_allocator_s>(bufferSize, stream);
@@ -621,6 +624,11 @@ class callback_s
         frame_queue_.advance(program_pts, program_target_time, discontinuity);
     }
 
+    std::optional<utils::flicks> presentable_frame_pts(utils::flicks program_pts, utils::flicks early_tolerance) const
+    {
+        return frame_queue_.presentable_program_pts(program_pts, early_tolerance);
+    }
+
     frame_ticket_t select_frame(utils::flicks program_pts, utils::flicks early_tolerance)
     {
         return frame_queue_.select(program_pts, early_tolerance);
@@ -870,6 +878,23 @@ bool input_capture_s::submit_frame(utils::flicks program_pts, utils::flicks earl
     return true;
 }
 
+std::optional<utils::flicks> input_capture_s::presentable_frame_pts(utils::flicks program_pts,
+                                                                    utils::flicks early_tolerance) const
+{
+    if (!impl_->callback) {
+        return std::nullopt;
+    }
+    return impl_->callback->presentable_frame_pts(program_pts, early_tolerance);
+}
+
+std::optional<utils::flicks> input_capture_s::prepared_frame_program_pts() const
+{
+    if (!impl_->prepared_frame.has_value() || impl_->prepared_frame->frame() == nullptr) {
+        return std::nullopt;
+    }
+    return impl_->prepared_frame->program_pts();
+}
+
 std::optional<captured_input_frame_s> input_capture_s::resolve_frame()
 {
     auto* frame = impl_->callback && impl_->prepared_frame.has_value()
@@ -76,7 +76,9 @@ class input_capture_s
     void acknowledge_render_release();
 
     void advance_frames(utils::flicks program_pts, utils::flicks program_target_time, bool discontinuity);
+    std::optional<utils::flicks> presentable_frame_pts(utils::flicks program_pts, utils::flicks early_tolerance) const;
     bool submit_frame(utils::flicks program_pts, utils::flicks early_tolerance);
+    std::optional<utils::flicks>          prepared_frame_program_pts() const;
     std::optional<captured_input_frame_s> resolve_frame();
     void                                  release_prepared_frame();
     void                                  reset_frames();
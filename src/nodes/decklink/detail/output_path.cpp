@@ -4,6 +4,7 @@
 #include "gpu/framebuffer.hpp"
 #include "gpu/shader.hpp"
 #include "gpu/textured_quad.hpp"
+#include "gpu/transfer/readback_wire_format.hpp"
 #include "gpu/transfer/texture_readback.hpp"
 #include "logger/logger.hpp"
 #include "wrapper/decklink-sdk/platform_compat.hpp"
@@ -88,7 +89,9 @@ class scaled_output_frame_renderer_s : public output_frame_renderer_i
     }
 
     gpu::texture_s* scaled_texture() const noexcept { return scaled_framebuffer_->texture(); }
-    virtual void    render_output(gpu::transfer::texture_readback_target_s& target) = 0;
+    gpu::vec2i_t    readback_dimensions() const noexcept { return readback_dimensions_; }
+    // Converts the scaled texture into every texel of the readback target
+    virtual void render_output(gpu::transfer::texture_readback_target_s& target) = 0;
 
   public:
     void
@@ -97,35 +100,21 @@ class scaled_output_frame_renderer_s : public output_frame_renderer_i
         scaled_framebuffer_->begin_render(gpu::framebuffer_s::load_op_e::clear);
         const auto texture_draw = gpu::calculate_texture_draw(
             {}, source->display_dimensions(), scaled_framebuffer_->texture()->display_dimensions(), fill_mode);
+        source->update_mip_maps_for(texture_draw, scaled_framebuffer_->texture()->display_dimensions());
         scale_quad_->draw(source, texture_draw);
         gpu::framebuffer_s::end_render();
 
-        target.framebuffer()->begin_render(
-            {
-                .pos  = {0, 0},
-                .size = readback_dimensions_,
-        },
-            gpu::framebuffer_s::load_op_e::clear);
         render_output(target);
-        gpu::framebuffer_s::end_render();
     }
 };
 
 class v210_output_frame_renderer_s final : public scaled_output_frame_renderer_s
 {
-    gpu::color_conversion_s               yuv_conversion_;
-    gpu::mat3                             gamut_conversion_;
-    int                                   target_width_;
-    std::unique_ptr<gpu::textured_quad_s> output_quad_;
+    gpu::transfer::readback_wire_encoder_s encoder_;
 
-    void render_output(gpu::transfer::texture_readback_target_s& /*target*/) final
+    void render_output(gpu::transfer::texture_readback_target_s& target) final
     {
-        auto* shader = output_quad_->shader();
-        shader->set_uniform("target_width", target_width_);
-        shader->set_uniform("transfer", yuv_conversion_.matrix);
-        shader->set_uniform("transfer_offset", yuv_conversion_.offset);
-        shader->set_uniform("gamut_transfer", gamut_conversion_);
-        output_quad_->draw(scaled_texture());
+        encoder_.encode(scaled_texture(), target);
     }
 
   public:
@@ -136,11 +125,11 @@ class v210_output_frame_renderer_s final : public scaled_output_frame_renderer_s
                                          display_mode,
                                          transfer_layout.dimensions,
                                          gpu::texture_s::pixel_format_e::rgb_f16)
-        , yuv_conversion_(display_mode.yuv_conversion)
-        , gamut_conversion_(display_mode.gamut_conversion)
-        , target_width_(transfer_layout.dimensions.x)
-        , output_quad_(
-              std::make_unique<gpu::textured_quad_s>(context->get_shader(gpu::shader_program_s::name_e::rgb_to_yuv)))
+        , encoder_(context,
+                   gpu::transfer::readback_wire_format_e::v210,
+                   transfer_layout,
+                   display_mode.yuv_conversion,
+                   display_mode.gamut_conversion)
     {
     }
 };
@@ -148,12 +137,20 @@ class v210_output_frame_renderer_s final : public scaled_output_frame_renderer_s
 class premultiplied_bgra_output_frame_renderer_s final : public scaled_output_frame_renderer_s
 {
     std::unique_ptr<gpu::textured_quad_s> output_quad_;
+    gpu::uniform_location_s<int>          readback_mapping_location_;
 
     void render_output(gpu::transfer::texture_readback_target_s& target) final
     {
-        output_quad_->shader()->set_uniform("readback_component_mapping",
+        output_quad_->shader()->set_uniform(readback_mapping_location_,
                                             static_cast<int>(target.readback_component_mapping()));
+        target.framebuffer()->begin_render(
+            {
+                .pos  = {0, 0},
+                .size = readback_dimensions(),
+        },
+            gpu::framebuffer_s::load_op_e::clear);
         output_quad_->draw(scaled_texture());
+        gpu::framebuffer_s::end_render();
     }
 
   public:
@@ -166,6 +163,8 @@ class premultiplied_bgra_output_frame_renderer_s final : public scaled_output_fr
                                          gpu::texture_s::pixel_format_e::rgba_f16)
         , output_quad_(std::make_unique<gpu::textured_quad_s>(
               context->get_shader(gpu::shader_program_s::name_e::encode_rec709_premultiplied)))
+        , readback_mapping_location_(
+              output_quad_->shader()->get_uniform_location<int>("readback_component_mapping"))
     {
         output_quad_->set_blending_enabled(false);
     }
@@ -3,13 +3,16 @@
 #include "detail/colorspace.hpp"
 #include "detail/device_reservation.hpp"
 #include "detail/input_capture.hpp"
+#include "gpu/color_conversion_uniforms.hpp"
 #include "gpu/color_transfer.hpp"
 #include "gpu/context.hpp"
 #include "gpu/framebuffer.hpp"
+#include "gpu/shader.hpp"
 #include "gpu/texture.hpp"
 #include "gpu/textured_quad.hpp"
 #include "gpu/types.hpp"
 #include "logger/logger.hpp"
+#include "media/source_sync_group.hpp"
 #include "nodes/interface.hpp"
 #include "nodes/node.hpp"
 #include "nodes/node_map.hpp"
@@ -20,6 +23,7 @@
 #include "wrapper/decklink-sdk/decklink_inc.hpp"
 
 #include <chrono>
+#include <exception>
 #include <memory>
 #include <optional>
 #include <string>
@@ -34,6 +38,17 @@ using namespace miximus::nodes::decklink::detail;
 
 auto log() { return getlog("decklink"); }
 
+// v210 is unpacked by a compute program, or by the fragment shader when it fails to build
+gpu::shader_program_s* compute_decode_shader(gpu::context_s* context)
+{
+    try {
+        return context->get_shader(gpu::shader_program_s::name_e::yuv_to_rgb_compute);
+    } catch (const std::exception& e) {
+        log()->warn("Unpacking v210 with the fragment shader, the compute program failed: {}", e.what());
+        return nullptr;
+    }
+}
+
 status::decklink_input_device_status_s make_device_status(const device_status_s& status)
 {
     return {
@@ -58,7 +73,9 @@ class node_impl : public node_i
     std::unique_ptr<input_capture_s> capture_;
 
     std::unique_ptr<gpu::framebuffer_s>                       framebuffer_;
+    gpu::shader_program_s*                                    decode_shader_{};
     std::unique_ptr<gpu::textured_quad_s>                     textured_quad_;
+    std::optional<gpu::color_conversion_uniforms_s>           conversion_uniforms_;
     utils::observed_value_s<uint64_t>                         device_version_;
     utils::observed_value_s<std::pair<std::string, bool>>     capture_selection_;
     utils::observed_value_s<BMDColorspace>                    colorspace_;
@@ -67,6 +84,7 @@ class node_impl : public node_i
     gpu::color_conversion_s                                   yuv_conversion_{};
     gpu::mat3                                                 gamut_conversion_{1.0F};
     gpu::texture_frame_ptr                                    rendered_input_frame_;
+    std::string                                               sync_group_;
 
     output_interface_s<gpu::texture_s*> iface_tex_{*this, "tex"};
 
@@ -92,7 +110,7 @@ class node_impl : public node_i
         }
     }
 
-    void publish_metrics(core::node_status_registry_s* status_registry)
+    void publish_metrics(core::app_state_s* app, core::node_status_registry_s* status_registry)
     {
         const auto now = std::chrono::steady_clock::now();
         if (!capture_ || now < next_metrics_status_) {
@@ -129,6 +147,9 @@ class node_impl : public node_i
                 .source_queue_discontinuities         = metrics.source_queue.discontinuities,
                 .source_queue_transfer_failures       = metrics.source_queue.transfer_failures,
                 .source_queue_transfer_cancellations  = metrics.source_queue.transfer_cancellations,
+                .source_frame_records                 = metrics.source_queue.frame_records.records,
+                .source_frame_records_reused          = metrics.source_queue.frame_records.reused,
+                .source_frame_record_allocations      = metrics.source_queue.frame_records.allocations,
                 .source_recovered_rate                = metrics.source_queue.recovered_rate,
                 .source_observed_rate                 = metrics.source_queue.observed_rate,
                 .source_phase_offset_us               = metrics.source_queue.phase_offset,
@@ -137,6 +158,15 @@ class node_impl : public node_i
                 .source_repeat_next_frame_lead_min_us = metrics.source_queue.repeat_next_frame_lead_min,
                 .source_repeat_next_frame_lead_max_us = metrics.source_queue.repeat_next_frame_lead_max,
             });
+        const auto sync_metrics = sync_group_.empty() ? media::source_sync_group_metrics_s{}
+                                                      : app->source_sync_registry()->metrics(sync_group_);
+        status_registry->write(id_,
+                               status::source_sync_status_s{
+                                   .sync_group_members      = sync_metrics.members,
+                                   .sync_group_skew_us      = sync_metrics.skew,
+                                   .sync_group_skew_max_us  = sync_metrics.skew_max,
+                                   .sync_group_hold_back_us = sync_metrics.hold_back,
+                               });
         next_metrics_status_ = now + std::chrono::seconds(1);
     }
 
@@ -169,6 +199,13 @@ class node_impl : public node_i
         if (phase == input_capture_s::phase_e::running) {
             const auto& frame = app->frame_context();
             capture_->advance_frames(frame.program_pts, frame.program_target_time, frame.discontinuity);
+            if (!sync_group_.empty()) {
+                app->source_sync_registry()->offer(
+                    sync_group_,
+                    frame.program_pts,
+                    frame.frame_duration,
+                    capture_->presentable_frame_pts(frame.program_pts, frame.frame_duration / 2));
+            }
         }
     }
 
@@ -210,6 +247,7 @@ class node_impl : public node_i
                       status::device_names_status_s{.device_names = app->decklink_registry()->get_input_options()});
         }
 
+        sync_group_ = state.get_option<std::string>("sync_group");
         prepare_active_capture(app, sr);
 
         auto device_name = state.get_option<std::string>("device_name");
@@ -221,7 +259,7 @@ class node_impl : public node_i
         }
 
         publish_device_status(app, device_name);
-        publish_metrics(sr);
+        publish_metrics(app, sr);
 
         const auto selection = std::pair(device_name, enabled);
         if (capture_selection_.would_change(selection)) {
@@ -254,9 +292,23 @@ class node_impl : public node_i
 
     void submit(core::app_state_s* app, const node_map_t& /*nodes*/, const node_state_s& /*state*/) final
     {
-        if (capture_) {
-            const auto& frame = app->frame_context();
+        if (!capture_) {
+            return;
+        }
+
+        const auto& frame = app->frame_context();
+        if (sync_group_.empty()) {
             (void)capture_->submit_frame(frame.program_pts, frame.frame_duration / 2);
+            return;
+        }
+
+        // Grouped inputs select at the group's earliest offer so every member
+        // presents frames captured at the same instant.
+        auto* sync_registry = app->source_sync_registry();
+        (void)capture_->submit_frame(sync_registry->selection_pts(sync_group_, frame.program_pts),
+                                     frame.frame_duration / 2);
+        if (const auto selected = capture_->prepared_frame_program_pts()) {
+            sync_registry->report_selection(sync_group_, frame.program_pts, *selected);
         }
     }
 
@@ -271,37 +323,46 @@ class node_impl : public node_i
         rendered_input_frame_ = frame->frame;
         rendered_input_frame_->wait_for_upload_on_gpu();
 
-        if (!textured_quad_) {
-            auto shader    = app->ctx()->get_shader(gpu::shader_program_s::name_e::yuv_to_rgb);
-            textured_quad_ = std::make_unique<gpu::textured_quad_s>(shader);
+        if (decode_shader_ == nullptr) {
+            decode_shader_ = compute_decode_shader(app->ctx());
+            if (decode_shader_ == nullptr) {
+                decode_shader_ = app->ctx()->get_shader(gpu::shader_program_s::name_e::yuv_to_rgb);
+                textured_quad_ = std::make_unique<gpu::textured_quad_s>(decode_shader_);
+            }
+            conversion_uniforms_.emplace(*decode_shader_);
         }
 
         const auto src_dim = frame->dimensions;
 
+        // Image stores need four channels, the fragment shader renders to RGB
+        const auto pixel_format =
+            textured_quad_ ? gpu::texture_s::pixel_format_e::rgb_f16 : gpu::texture_s::pixel_format_e::rgba_f16;
         if (!framebuffer_ || framebuffer_->texture()->texture_dimensions() != src_dim) {
-            framebuffer_ = std::make_unique<gpu::framebuffer_s>(src_dim, gpu::texture_s::pixel_format_e::rgb_f16);
+            framebuffer_ = std::make_unique<gpu::framebuffer_s>(src_dim, pixel_format);
         }
 
-        auto shader = textured_quad_->shader();
-        shader->set_uniform("target_width", src_dim.x);
-
         if (colorspace_.observe(frame->colorspace)) {
             const auto transfer = get_color_transfer(colorspace_.value());
             yuv_conversion_     = gpu::get_color_transfer_from_yuv(transfer);
             gamut_conversion_   = gpu::get_gamut_transfer_to_rec709(transfer);
         }
 
-        shader->set_uniform("transfer", yuv_conversion_.matrix);
-        shader->set_uniform("transfer_offset", yuv_conversion_.offset);
-        shader->set_uniform("gamut_transfer", gamut_conversion_);
-
-        framebuffer_->begin_render(gpu::framebuffer_s::load_op_e::clear);
-        textured_quad_->draw(rendered_input_frame_->texture());
-        gpu::framebuffer_s::end_render();
+        conversion_uniforms_->set(*decode_shader_, src_dim.x, yuv_conversion_, gamut_conversion_);
+
+        if (textured_quad_) {
+            framebuffer_->begin_render(gpu::framebuffer_s::load_op_e::clear);
+            textured_quad_->draw(rendered_input_frame_->texture());
+            gpu::framebuffer_s::end_render();
+        } else {
+            auto* target = framebuffer_->texture();
+            rendered_input_frame_->texture()->bind(0);
+            target->bind_image(0, GL_WRITE_ONLY);
+            target->invalidate_mip_maps();
+            // One invocation per v210 group of six pixels
+            decode_shader_->dispatch({(src_dim.x + 5) / 6, src_dim.y});
+        }
 
-        auto fb_tex = framebuffer_->texture();
-        fb_tex->generate_mip_maps();
-        iface_tex_.set_value(fb_tex);
+        iface_tex_.set_value(framebuffer_->texture());
     }
 
     void complete(core::app_state_s* /*app*/) final
@@ -318,8 +379,9 @@ class node_impl : public node_i
     nlohmann::json get_default_options() const final
     {
         return {
-            {"name",    "DeckLink input"},
-            {"enabled", true            },
+            {"name",       "DeckLink input"},
+            {"enabled",    true            },
+            {"sync_group", ""              },
         };
     }
 
@@ -331,6 +393,9 @@ class node_impl : public node_i
         if (name == "enabled") {
             return normalize_option_value<bool>(value);
         }
+        if (name == "sync_group") {
+            return normalize_option_value<std::string_view>(value);
+        }
         return option_result_e::invalid;
     }
 
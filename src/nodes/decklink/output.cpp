@@ -5,6 +5,7 @@
 #include "detail/output_activation.hpp"
 #include "detail/output_path.hpp"
 #include "detail/output_video_buffer.hpp"
+#include "gpu/memory_registry.hpp"
 #include "gpu/texture.hpp"
 #include "gpu/transfer/texture_readback.hpp"
 #include "logger/logger.hpp"
@@ -157,6 +158,7 @@ class callback_s final : public IDeckLinkVideoOutputCallback
     decklink_ptr<IDeckLinkOutput>              device_;
     std::shared_ptr<reservation_s>             reservation_;
     std::string                                device_name_;
+    std::string                                memory_owner_;
     std::string                                requested_mode_name_;
     keyer_mode_e                               requested_keyer_mode_;
     output_activation_s                        output_activation_;
@@ -331,6 +333,7 @@ class callback_s final : public IDeckLinkVideoOutputCallback
                          .transfer_layout = active_output->path->transfer_layout(),
                          .max_slots       = readback_slot_count,
                          .initial_slots   = readback_slot_count,
+                         .memory_owner    = memory_owner_,
         });
         if (!stream->wait_for_initial_slots(5s)) {
             log()->error("Failed to initialize the DeckLink output transfer pool for {}", device_name_);
@@ -691,6 +694,7 @@ class callback_s final : public IDeckLinkVideoOutputCallback
         , device_(std::move(device))
         , reservation_(std::move(reservation))
         , device_name_(std::move(device_name))
+        , memory_owner_(gpu::memory_owner_scope_s::current())
         , requested_mode_name_(std::move(requested_mode_name))
         , requested_keyer_mode_(requested_keyer_mode)
         , output_activation_(device_, device_name_)
@@ -1,19 +1,81 @@
 #include "frame_execution.hpp"
 
 #include "core/app_state.hpp"
+#include "gpu/memory_registry.hpp"
 #include "nodes/interface.hpp"
 #include "nodes/node.hpp"
 #include "nodes/node_map.hpp"
 
+#include <vector>
+
 namespace miximus::nodes {
+namespace {
+
+bool is_framebuffer_interface(const node_map_t& nodes, std::string_view node_id, std::string_view name)
+{
+    const auto node = nodes.find(node_id);
+    if (node == nodes.end()) {
+        return false;
+    }
+    const auto* iface = node->second.node->find_interface(name);
+    return iface != nullptr && iface->type() == interface_type_e::framebuffer;
+}
+
+bool depends_on_reused_nodes(const node_map_t& nodes, const node_record_s& record, const reused_node_set_t& reused)
+{
+    for (const auto& [name, connections] : record.state.con_map) {
+        const auto* iface = record.node->find_interface(name);
+        if (iface == nullptr) {
+            continue;
+        }
+
+        for (const auto& con : connections) {
+            if (iface->direction() == interface_i::dir_e::input) {
+                if (!reused.contains(con.from_node)) {
+                    return false;
+                }
+                continue;
+            }
+
+            // The next node drawing into the same target has to be reused too
+            if (iface->type() == interface_type_e::framebuffer && !reused.contains(con.to_node) &&
+                is_framebuffer_interface(nodes, con.to_node, con.to_interface)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Remove nodes until every remaining node only depends on reused nodes
+void prune_reused_nodes(const node_map_t& nodes, reused_node_set_t* reused)
+{
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto it = reused->begin(); it != reused->end();) {
+            const auto node = nodes.find(*it);
+            if (node == nodes.end() || !depends_on_reused_nodes(nodes, node->second, *reused)) {
+                it      = reused->erase(it);
+                changed = true;
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+} // namespace
 
 std::vector<std::string_view> prepare_all_nodes(core::app_state_s* app, node_map_t& nodes)
 {
     std::vector<std::string_view> demanding_nodes;
     demanding_nodes.reserve(nodes.size());
     for (auto& [id, record] : nodes) {
-        node_i::prepare_result_s result;
+        const gpu::memory_owner_scope_s memory_owner(id);
+        node_i::prepare_result_s        result;
         record.node->prepare(app, record.state, &result);
+        record.content_version = result.content_version;
         if (result.demands_execution) {
             demanding_nodes.emplace_back(id);
         }
@@ -23,13 +85,57 @@ std::vector<std::string_view> prepare_all_nodes(core::app_state_s* app, node_map
 
 void complete_all_nodes(core::app_state_s* app, node_map_t& nodes)
 {
-    for (auto& [_, record] : nodes) {
-        record.node->complete(app);
+    const auto& frame_info = app->frame_info;
+    for (auto& [id, record] : nodes) {
+        {
+            const gpu::memory_owner_scope_s memory_owner(id);
+            record.node->complete(app);
+        }
+
+        // Outputs from before a missed frame may have been computed from
+        // inputs that have changed since, so the chain of versions must be
+        // unbroken for a node to be reused
+        if (!frame_info.reused_nodes.contains(id)) {
+            record.executed_version =
+                frame_info.finished_nodes.contains(id) ? record.content_version : std::optional<uint64_t>{};
+        }
+    }
+}
+
+void select_reused_nodes(core::app_state_s* app, node_map_t& nodes)
+{
+    auto& reused = app->frame_info.reused_nodes;
+    reused.clear();
+    for (const auto& [id, record] : nodes) {
+        if (record.content_version.has_value() && record.content_version == record.executed_version) {
+            reused.emplace(id);
+        }
+    }
+    prune_reused_nodes(nodes, &reused);
+
+    // Only nodes that would otherwise be reused are asked, and a refusal
+    // can in turn make nodes depending on them execute
+    std::vector<std::string_view> refused;
+    for (const auto id : reused) {
+        if (!nodes.find(id)->second.node->retain_outputs(app)) {
+            refused.emplace_back(id);
+        }
+    }
+    if (!refused.empty()) {
+        for (const auto id : refused) {
+            reused.erase(id);
+        }
+        prune_reused_nodes(nodes, &reused);
     }
 }
 
 bool submit_node_once(core::app_state_s* app, const node_map_t& nodes, std::string_view id)
 {
+    // Everything a reused node depends on is reused too, so the traversal stops here
+    if (app->frame_info.reused_nodes.contains(id)) {
+        return false;
+    }
+
     auto& submitted_nodes = app->frame_info.submitted_nodes;
     if (!submitted_nodes.emplace(id).second) {
         return false;
@@ -41,12 +147,17 @@ bool submit_node_once(core::app_state_s* app, const node_map_t& nodes, std::stri
         return false;
     }
 
+    const gpu::memory_owner_scope_s memory_owner(id);
     node->second.node->submit(app, nodes, node->second.state);
     return true;
 }
 
 bool execute_node_once(core::app_state_s* app, const node_map_t& nodes, std::string_view id)
 {
+    if (app->frame_info.reused_nodes.contains(id)) {
+        return false;
+    }
+
     auto& executed_nodes = app->frame_info.executed_nodes;
     if (!executed_nodes.emplace(id).second) {
         return false;
@@ -58,7 +169,11 @@ bool execute_node_once(core::app_state_s* app, const node_map_t& nodes, std::str
         return false;
     }
 
-    node->second.node->execute(app, nodes, node->second.state);
+    {
+        const gpu::memory_owner_scope_s memory_owner(id);
+        node->second.node->execute(app, nodes, node->second.state);
+    }
+    app->frame_info.finished_nodes.emplace(id);
     return true;
 }
 
@@ -12,6 +12,16 @@ namespace miximus::nodes {
 std::vector<std::string_view> prepare_all_nodes(core::app_state_s* app, node_map_t& nodes);
 void                          complete_all_nodes(core::app_state_s* app, node_map_t& nodes);
 
+/**
+ * Select the nodes that keep the outputs of their last execute() this frame
+ * into frame_info.reused_nodes. A node is reused when its content version is
+ * unchanged since it last executed, every node connected to its inputs is
+ * reused as well, and retain_outputs() agrees. Nodes drawing into the same
+ * framebuffer are reused together or not at all, since executing one part of
+ * the chain requires the target to be drawn from the start.
+ */
+void select_reused_nodes(core::app_state_s* app, node_map_t& nodes);
+
 bool submit_node_once(core::app_state_s* app, const node_map_t& nodes, std::string_view id);
 
 bool execute_node_once(core::app_state_s* app, const node_map_t& nodes, std::string_view id);
@@ -7,5 +7,7 @@ namespace miximus::nodes {
 
 using submitted_node_set_t = std::unordered_set<std::string_view>;
 using executed_node_set_t  = std::unordered_set<std::string_view>;
+using finished_node_set_t  = std::unordered_set<std::string_view>;
+using reused_node_set_t    = std::unordered_set<std::string_view>;
 
 } // namespace miximus::nodes
@@ -0,0 +1,194 @@
+#include "nodes/framebuffer_pool.hpp"
+
+#include "core/app_state.hpp"
+#include "gpu/memory_registry.hpp"
+#include "gpu/texture.hpp"
+#include "logger/logger.hpp"
+#include "nodes/interface.hpp"
+#include "nodes/node.hpp"
+#include "nodes/node_map.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace miximus::nodes {
+namespace {
+
+bool carries_target(const interface_i* iface, const gpu::framebuffer_s* framebuffer)
+{
+    switch (iface->type()) {
+        case interface_type_e::framebuffer: {
+            const auto* output = dynamic_cast<const output_interface_s<gpu::framebuffer_s*>*>(iface);
+            return output != nullptr && output->get_value() == framebuffer;
+        }
+        case interface_type_e::texture: {
+            const auto* output = dynamic_cast<const output_interface_s<gpu::texture_s*>*>(iface);
+            return output != nullptr && output->get_value() == framebuffer->texture();
+        }
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+framebuffer_pool_s::~framebuffer_pool_s() = default;
+
+bool framebuffer_pool_s::is_leased(const slot_s& slot, const core::app_state_s& app, const node_map_t& nodes) const
+{
+    if (slot.leased_frame != frame_) {
+        return false;
+    }
+    if (slot.retained) {
+        return true;
+    }
+
+    // Follow the target from its owner through every output still holding it.
+    // Outputs are only inspected on nodes that have finished this frame, so a
+    // value left over from an earlier frame is never followed.
+    const auto&                          finished_nodes = app.frame_info.finished_nodes;
+    std::vector<std::string_view>        pending{slot.owner};
+    std::unordered_set<std::string_view> visited{slot.owner};
+
+    while (!pending.empty()) {
+        const auto id = pending.back();
+        pending.pop_back();
+
+        if (!finished_nodes.contains(id)) {
+            return true;
+        }
+
+        const auto node = nodes.find(id);
+        if (node == nodes.end()) {
+            continue;
+        }
+
+        for (const auto& [name, iface] : node->second.node->get_interfaces()) {
+            if (iface->direction() != interface_i::dir_e::output || !carries_target(iface, slot.framebuffer.get())) {
+                continue;
+            }
+
+            const auto connections = node->second.state.con_map.find(name);
+            if (connections == node->second.state.con_map.end()) {
+                continue;
+            }
+
+            for (const auto& con : connections->second) {
+                if (visited.emplace(con.to_node).second) {
+                    pending.emplace_back(con.to_node);
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+gpu::framebuffer_s* framebuffer_pool_s::acquire(const core::app_state_s& app,
+                                                const node_map_t&        nodes,
+                                                std::string_view         owner,
+                                                const target_class_s&    target_class)
+{
+    slot_s* selected = nullptr;
+
+    for (const auto& slot : slots_) {
+        if (slot->target_class != target_class) {
+            continue;
+        }
+        if (slot->retained && slot->leased_frame == frame_ && slot->owner == owner) {
+            selected = slot.get();
+            break;
+        }
+        if (is_leased(*slot, app, nodes)) {
+            continue;
+        }
+
+        // Keep handing owners the same target between frames when possible
+        if (slot->owner == owner) {
+            selected = slot.get();
+            break;
+        }
+        if (selected == nullptr) {
+            selected = slot.get();
+        }
+    }
+
+    if (selected == nullptr) {
+        const auto bytes =
+            gpu::texture_s::estimate_storage_byte_size(target_class.dimensions, target_class.pixel_format);
+        if (!gpu::memory_registry_s::global().has_room_for(bytes)) {
+            release_idle_targets();
+        }
+
+        auto slot          = std::make_unique<slot_s>();
+        slot->target_class = target_class;
+        slot->framebuffer  = std::make_unique<gpu::framebuffer_s>(
+            target_class.dimensions, target_class.pixel_format, target_class.depth_stencil);
+        selected = slots_.emplace_back(std::move(slot)).get();
+
+        getlog("gpu")->debug("Allocated {}x{} transient framebuffer, {} in pool",
+                             target_class.dimensions.x,
+                             target_class.dimensions.y,
+                             slots_.size());
+    }
+
+    if (selected->owner != owner) {
+        selected->framebuffer->set_memory_owner(owner);
+    }
+    selected->owner        = owner;
+    selected->leased_frame = frame_;
+    selected->retained     = std::ranges::find(retaining_owners_, owner) != retaining_owners_.end();
+    return selected->framebuffer.get();
+}
+
+bool framebuffer_pool_s::retain(std::string_view owner, const gpu::framebuffer_s* framebuffer)
+{
+    if (std::ranges::find(retaining_owners_, owner) == retaining_owners_.end()) {
+        retaining_owners_.emplace_back(owner);
+    }
+
+    // A slot keeps the name of the last node it was leased to, so a matching
+    // owner means nobody has drawn into it since. Older slots of an owner that
+    // changed size can still carry its name, only the published one counts.
+    const auto published = std::ranges::find_if(
+        slots_, [framebuffer](const std::unique_ptr<slot_s>& slot) { return slot->framebuffer.get() == framebuffer; });
+    if (framebuffer == nullptr || published == slots_.end() || (*published)->owner != owner) {
+        return false;
+    }
+
+    (*published)->leased_frame = frame_;
+    (*published)->retained     = true;
+    return true;
+}
+
+void framebuffer_pool_s::release_idle_targets()
+{
+    const auto removed =
+        std::erase_if(slots_, [this](const std::unique_ptr<slot_s>& slot) { return slot->leased_frame != frame_; });
+    if (removed > 0) {
+        getlog("gpu")->info(
+            "Released {} unused transient framebuffers over the GPU memory budget, {} in pool", removed, slots_.size());
+    }
+}
+
+void framebuffer_pool_s::end_frame()
+{
+    const auto removed = std::erase_if(
+        slots_, [this](const std::unique_ptr<slot_s>& slot) { return frame_ - slot->leased_frame > IDLE_FRAME_LIMIT; });
+    if (removed > 0) {
+        getlog("gpu")->debug("Released {} idle transient framebuffers, {} in pool", removed, slots_.size());
+    }
+    if (gpu::memory_registry_s::global().over_budget()) {
+        release_idle_targets();
+    }
+
+    for (const auto& slot : slots_) {
+        slot->retained = false;
+    }
+    retaining_owners_.clear();
+    ++frame_;
+}
+
+} // namespace miximus::nodes
@@ -0,0 +1,100 @@
+#pragma once
+#include "core/app_state_fwd.hpp"
+#include "gpu/framebuffer.hpp"
+#include "gpu/types.hpp"
+#include "nodes/node_map_fwd.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miximus::nodes {
+
+/**
+ * Render targets for framebuffer nodes, leased for one frame at a time.
+ *
+ * A lease ends once every node its target flows to from the owning node has
+ * finished executing. From then on the target can be handed to the next
+ * framebuffer node asking for the same size and format in the same frame, so
+ * chains that render one after another share memory instead of each keeping a
+ * target of its own. Owners get their previous target back when it is free,
+ * and targets left unused for a while are destroyed.
+ *
+ * Owners whose outputs are reused from the previous frame retain their target
+ * instead, which keeps it and its contents away from other nodes.
+ *
+ * Targets are accounted to the node holding the lease. While the GPU memory
+ * budget is exceeded, targets not leased this frame are destroyed right away
+ * instead of after IDLE_FRAME_LIMIT frames.
+ *
+ * Must only be used on the render thread with the GL context current.
+ */
+class framebuffer_pool_s
+{
+  public:
+    struct target_class_s
+    {
+        gpu::vec2i_t                        dimensions;
+        gpu::texture_s::pixel_format_e      pixel_format{gpu::texture_s::pixel_format_e::rgba_f16};
+        gpu::framebuffer_s::depth_stencil_e depth_stencil{gpu::framebuffer_s::depth_stencil_e::none};
+
+        bool operator==(const target_class_s&) const = default;
+    };
+
+    // Frames a target may stay unused before it is destroyed
+    static constexpr uint64_t IDLE_FRAME_LIMIT = 120;
+
+  private:
+    struct slot_s
+    {
+        target_class_s                      target_class;
+        std::unique_ptr<gpu::framebuffer_s> framebuffer;
+        std::string                         owner;
+        uint64_t                            leased_frame{};
+        bool                                retained{};
+    };
+
+    std::vector<std::unique_ptr<slot_s>> slots_;
+    std::vector<std::string>             retaining_owners_;
+    uint64_t                             frame_{1};
+
+    bool is_leased(const slot_s& slot, const core::app_state_s& app, const node_map_t& nodes) const;
+    void release_idle_targets();
+
+  public:
+    framebuffer_pool_s() = default;
+    ~framebuffer_pool_s();
+
+    framebuffer_pool_s(const framebuffer_pool_s&)            = delete;
+    framebuffer_pool_s(framebuffer_pool_s&&)                 = delete;
+    framebuffer_pool_s& operator=(const framebuffer_pool_s&) = delete;
+    framebuffer_pool_s& operator=(framebuffer_pool_s&&)      = delete;
+
+    /**
+     * Lease a target for the node `owner` for the rest of the current frame.
+     * The contents are undefined, callers clear or fully overwrite it.
+     */
+    gpu::framebuffer_s* acquire(const core::app_state_s& app,
+                                const node_map_t&        nodes,
+                                std::string_view         owner,
+                                const target_class_s&    target_class);
+
+    /**
+     * Lease `framebuffer`, the target `owner` last published, for the whole
+     * frame without sharing it, must be called before any node executes.
+     * Returns false when the target has been handed to another node since or
+     * destroyed, the contents are then lost. Either way the target acquire()
+     * gives `owner` this frame is not shared, so its contents are kept for
+     * the next frame.
+     */
+    bool retain(std::string_view owner, const gpu::framebuffer_s* framebuffer);
+
+    // Release every lease and destroy targets that have been idle too long
+    void end_frame();
+
+    size_t target_count() const noexcept { return slots_.size(); }
+};
+
+} // namespace miximus::nodes
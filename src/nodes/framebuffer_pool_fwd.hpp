@@ -0,0 +1,5 @@
+#pragma once
+
+namespace miximus::nodes {
+class framebuffer_pool_s;
+} // namespace miximus::nodes
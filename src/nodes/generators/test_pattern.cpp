@@ -193,6 +193,13 @@ class node_impl : public node_i
         }
     }
 
+    void prepare(core::app_state_s* /*app*/, const node_state_s& /*state*/, prepare_result_s* result) final
+    {
+        if (!generation_.has_value()) {
+            result->content_version = 0;
+        }
+    }
+
     void execute(core::app_state_s* app, const node_map_t& /*nodes*/, const node_state_s& state) final
     {
         rendered_frame_.reset();
@@ -229,8 +236,12 @@ class node_impl : public node_i
         iface_texture_.set_value(rendered_frame_ ? rendered_frame_->texture() : nullptr);
     }
 
-    void complete(core::app_state_s* /*app*/) final
+    void complete(core::app_state_s* app) final
     {
+        // Nodes downstream keep sampling the texture while this node is reused
+        if (!rendered_frame_ && app->frame_info.reused_nodes.contains(id_)) {
+            rendered_frame_ = published_frame_;
+        }
         if (rendered_frame_) {
             rendered_frame_->publish_render_release_fence();
             rendered_frame_.reset();
@@ -143,11 +143,7 @@ gpu::texture_s* input_interface_s<gpu::texture_s*>::cast_iface_to_value(const in
             }
             auto* framebuffer = cast->get_value();
             auto* texture     = framebuffer != nullptr ? framebuffer->texture() : nullptr;
-            if (texture != nullptr) {
-                texture->generate_mip_maps();
-                return texture;
-            }
-            return fallback;
+            return texture != nullptr ? texture : fallback;
         }
         default:
             return fallback;
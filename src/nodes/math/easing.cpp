@@ -128,6 +128,11 @@ class node_impl : public node_i
     output_interface_s<double> iface_res_{*this, "res"};
 
   public:
+    void prepare(core::app_state_s* /*app*/, const node_state_s& /*state*/, prepare_result_s* result) final
+    {
+        result->content_version = 0;
+    }
+
     void execute(core::app_state_s* app, const node_map_t& nodes, const node_state_s& state) final
     {
         const auto option = state.get_option<double>("t");
@@ -1,5 +1,6 @@
 #include "input_capture.hpp"
 
+#include "gpu/memory_registry.hpp"
 #include "gpu/transfer/texture_upload.hpp"
 #include "logger/logger.hpp"
 #include "types/frame_rate.hpp"
@@ -45,29 +46,80 @@ struct captured_frame_data_s
     gpu::transfer::texture_upload_id_s                      upload_id{};
     gpu::texture_frame_ptr                                  frame;
     gpu::vec2i_t                                            dimensions{};
+    input_video_format_e                                    video_format{input_video_format_e::uyvy};
     int64_t                                                 ndi_timecode{};
     int64_t                                                 ndi_timestamp{NDIlib_recv_timestamp_undefined};
 };
 
-bool copy_frame(const NDIlib_video_frame_v2_t& video_frame, std::span<std::byte> destination, size_t row_size)
+// Upload layout of a frame in the packing the receiver delivered. Texture
+// rows map one to one onto the planes' rows, as in the matching encoders.
+struct video_layout_s
 {
-    const auto host_buffer_size_bytes = row_size * static_cast<size_t>(video_frame.yres);
-    const auto source_stride =
-        video_frame.line_stride_in_bytes == 0 ? row_size : static_cast<size_t>(video_frame.line_stride_in_bytes);
+    input_video_format_e           video_format;
+    gpu::texture_s::pixel_format_e pixel_format;
+    gpu::vec2i_t                   texel_dimensions;
+    size_t                         row_size;   // Sample bytes per row
+    size_t                         row_stride; // Uploaded bytes per row, padded to whole texels
+
+    size_t host_buffer_size_bytes() const { return row_stride * static_cast<size_t>(texel_dimensions.y); }
+};
+
+// UYVA and PA16 carry their alpha plane after the YUV planes. It is not
+// uploaded since the input renders into an opaque framebuffer.
+std::optional<video_layout_s> get_video_layout(const NDIlib_video_frame_v2_t& video_frame)
+{
+    const auto row_size = static_cast<size_t>(video_frame.xres) * 2;
+    switch (video_frame.FourCC) {
+        case NDIlib_FourCC_video_type_UYVY:
+        case NDIlib_FourCC_video_type_UYVA: {
+            const auto width = (video_frame.xres + 1) / 2;
+            return video_layout_s{
+                .video_format     = input_video_format_e::uyvy,
+                .pixel_format     = gpu::texture_s::pixel_format_e::packed_u8,
+                .texel_dimensions = {width, video_frame.yres},
+                .row_size         = row_size,
+                .row_stride       = static_cast<size_t>(width) * 4,
+            };
+        }
+        case NDIlib_FourCC_video_type_P216:
+        case NDIlib_FourCC_video_type_PA16: {
+            const auto width = (video_frame.xres + 3) / 4;
+            return video_layout_s{
+                .video_format     = input_video_format_e::p216,
+                .pixel_format     = gpu::texture_s::pixel_format_e::packed_u16,
+                .texel_dimensions = {width, video_frame.yres * 2},
+                .row_size         = row_size,
+                .row_stride       = static_cast<size_t>(width) * 8,
+            };
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+bool copy_frame(const NDIlib_video_frame_v2_t& video_frame,
+                std::span<std::byte>           destination,
+                const video_layout_s&          layout)
+{
+    const auto host_buffer_size_bytes = layout.host_buffer_size_bytes();
+    const auto source_stride          = video_frame.line_stride_in_bytes == 0
+                                            ? layout.row_size
+                                            : static_cast<size_t>(video_frame.line_stride_in_bytes);
     if (destination.size() < host_buffer_size_bytes || video_frame.line_stride_in_bytes < 0 ||
-        source_stride < row_size) {
+        source_stride < layout.row_size) {
         return false;
     }
 
+    // The planes of P216 frames share one stride, so both are copied as rows
     auto* source = video_frame.p_data;
-    if (source_stride == row_size) {
+    if (source_stride == layout.row_stride) {
         std::memcpy(destination.data(), source, host_buffer_size_bytes);
         return true;
     }
 
-    for (int y = 0; y < video_frame.yres; ++y) {
-        const auto offset = static_cast<size_t>(y) * row_size;
-        std::memcpy(destination.data() + offset, source, row_size);
+    for (int y = 0; y < layout.texel_dimensions.y; ++y) {
+        const auto offset = static_cast<size_t>(y) * layout.row_stride;
+        std::memcpy(destination.data() + offset, source, layout.row_size);
         source += source_stride;
     }
     return true;
@@ -83,6 +135,7 @@ class input_capture_s::impl_s
     utils::serial_executor_s*                control_executor_;
     std::string                              source_name_;
     std::string                              receiver_name_;
+    std::string                              memory_owner_;
 
     NDIlib_recv_instance_t receiver_{nullptr};
 
@@ -93,6 +146,7 @@ class input_capture_s::impl_s
 
     std::shared_ptr<gpu::transfer::texture_upload_stream_s> upload_stream_;
     gpu::vec2i_t                                            upload_dimensions_{};
+    gpu::texture_s::pixel_format_e                          upload_pixel_format_{};
 
     frame_queue_t frame_queue_{
         {.capacity = SOURCE_QUEUE_CAPACITY, .playout_delay_frames = 1}
@@ -126,26 +180,27 @@ class input_capture_s::impl_s
         }
     }
 
-    std::shared_ptr<gpu::transfer::texture_upload_stream_s>
-    get_upload_stream(gpu::vec2i_t dimensions, size_t host_row_stride_bytes, size_t host_buffer_size_bytes)
+    std::shared_ptr<gpu::transfer::texture_upload_stream_s> get_upload_stream(const video_layout_s& layout)
     {
-        if (upload_stream_ && upload_dimensions_ == dimensions) {
+        if (upload_stream_ && upload_dimensions_ == layout.texel_dimensions &&
+            upload_pixel_format_ == layout.pixel_format) {
             return upload_stream_;
         }
 
         const gpu::transfer::texture_transfer_layout_s transfer_layout{
-            .dimensions             = dimensions,
-            .pixel_format           = gpu::texture_s::pixel_format_e::bgra_u8,
-            .host_row_stride_bytes  = host_row_stride_bytes,
-            .host_buffer_size_bytes = host_buffer_size_bytes,
+            .dimensions             = layout.texel_dimensions,
+            .pixel_format           = layout.pixel_format,
+            .host_row_stride_bytes  = layout.row_stride,
+            .host_buffer_size_bytes = layout.host_buffer_size_bytes(),
             .host_memory_access     = gpu::transfer::host_memory_access_e::overwrite,
         };
-        upload_stream_     = upload_service_->create_stream({
-                .transfer_layout   = transfer_layout,
-                .max_slots         = UPLOAD_SLOT_COUNT,
-                .generate_mip_maps = false,
+        upload_stream_       = upload_service_->create_stream({
+                  .transfer_layout = transfer_layout,
+                  .max_slots       = UPLOAD_SLOT_COUNT,
+                  .memory_owner    = memory_owner_,
         });
-        upload_dimensions_ = dimensions;
+        upload_dimensions_   = layout.texel_dimensions;
+        upload_pixel_format_ = layout.pixel_format;
         return upload_stream_;
     }
 
@@ -211,9 +266,11 @@ class input_capture_s::impl_s
     bool process_video_frame(const NDIlib_video_frame_v2_t& video_frame, utils::flicks arrival_time)
     {
         if (video_frame.p_data == nullptr || video_frame.xres <= 0 || video_frame.yres <= 0 ||
-            video_frame.frame_rate_N <= 0 || video_frame.frame_rate_D <= 0 ||
-            (video_frame.FourCC != NDIlib_FourCC_video_type_BGRA &&
-             video_frame.FourCC != NDIlib_FourCC_video_type_BGRX)) {
+            video_frame.frame_rate_N <= 0 || video_frame.frame_rate_D <= 0) {
+            return false;
+        }
+        const auto layout = get_video_layout(video_frame);
+        if (!layout.has_value()) {
             return false;
         }
 
@@ -227,16 +284,14 @@ class input_capture_s::impl_s
         }
 
         const gpu::vec2i_t dimensions{video_frame.xres, video_frame.yres};
-        const auto         row_size               = static_cast<size_t>(video_frame.xres) * 4;
-        const auto         host_buffer_size_bytes = row_size * static_cast<size_t>(video_frame.yres);
-        auto               stream                 = get_upload_stream(dimensions, row_size, host_buffer_size_bytes);
-        auto               upload                 = stream->try_acquire_upload_buffer();
+        auto               stream = get_upload_stream(*layout);
+        auto               upload = stream->try_acquire_upload_buffer();
         if (!upload.has_value()) {
             ++upload_slot_drops_;
             return true;
         }
 
-        if (!copy_frame(video_frame, upload->writable_host_bytes(), row_size)) {
+        if (!copy_frame(video_frame, upload->writable_host_bytes(), *layout)) {
             return false;
         }
 
@@ -255,6 +310,7 @@ class input_capture_s::impl_s
                                                         .upload_id     = upload_id,
                                                         .frame         = nullptr,
                                                         .dimensions    = dimensions,
+                                                        .video_format  = layout->video_format,
                                                         .ndi_timecode  = video_frame.timecode,
                                                         .ndi_timestamp = video_frame.timestamp,
                                                     }));
@@ -334,6 +390,7 @@ class input_capture_s::impl_s
         , control_executor_(control_executor)
         , source_name_(std::move(source_name))
         , receiver_name_(std::move(receiver_name))
+        , memory_owner_(gpu::memory_owner_scope_s::current())
     {
     }
 
@@ -352,7 +409,9 @@ class input_capture_s::impl_s
         }
 
         NDIlib_recv_create_v3_t create{};
-        create.color_format       = NDIlib_recv_color_format_BGRX_BGRA;
+        // Frames arrive as UYVY, or P216 from high bit depth senders, and are
+        // converted to RGB on the GPU
+        create.color_format       = NDIlib_recv_color_format_best;
         create.bandwidth          = NDIlib_recv_bandwidth_highest;
         create.allow_video_fields = false;
         create.p_ndi_recv_name    = receiver_name_.c_str();
@@ -417,6 +476,11 @@ class input_capture_s::impl_s
         frame_queue_.advance(program_pts, program_target_time, discontinuity);
     }
 
+    std::optional<utils::flicks> presentable_frame_pts(utils::flicks program_pts, utils::flicks early_tolerance) const
+    {
+        return frame_queue_.presentable_program_pts(program_pts, early_tolerance);
+    }
+
     bool submit_frame(utils::flicks program_pts, utils::flicks early_tolerance)
     {
         prepared_frame_.reset();
@@ -498,11 +562,20 @@ class input_capture_s::impl_s
             return std::nullopt;
         }
         return resolved_input_frame_s{
-            .frame      = info.frame,
-            .dimensions = info.dimensions,
+            .frame        = info.frame,
+            .dimensions   = info.dimensions,
+            .video_format = info.video_format,
         };
     }
 
+    std::optional<utils::flicks> prepared_frame_program_pts() const
+    {
+        if (!prepared_frame_.has_value() || prepared_frame_->frame() == nullptr) {
+            return std::nullopt;
+        }
+        return prepared_frame_->program_pts();
+    }
+
     void release_prepared_frame()
     {
         if (prepared_frame_.has_value() &&
@@ -564,11 +637,22 @@ void input_capture_s::advance_frames(utils::flicks program_pts, utils::flicks pr
     impl_->advance_frames(program_pts, program_target_time, discontinuity);
 }
 
+std::optional<utils::flicks> input_capture_s::presentable_frame_pts(utils::flicks program_pts,
+                                                                    utils::flicks early_tolerance) const
+{
+    return impl_->presentable_frame_pts(program_pts, early_tolerance);
+}
+
 bool input_capture_s::submit_frame(utils::flicks program_pts, utils::flicks early_tolerance)
 {
     return impl_->submit_frame(program_pts, early_tolerance);
 }
 
+std::optional<utils::flicks> input_capture_s::prepared_frame_program_pts() const
+{
+    return impl_->prepared_frame_program_pts();
+}
+
 std::optional<resolved_input_frame_s> input_capture_s::resolve_frame() { return impl_->resolve_frame(); }
 
 void input_capture_s::release_prepared_frame() { impl_->release_prepared_frame(); }
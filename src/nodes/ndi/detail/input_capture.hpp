@@ -13,10 +13,18 @@
 
 namespace miximus::nodes::ndi::detail {
 
+// Packing of the YUV samples in an uploaded frame, selecting the decode shader
+enum class input_video_format_e : uint8_t
+{
+    uyvy,
+    p216,
+};
+
 struct resolved_input_frame_s
 {
     gpu::texture_frame_ptr frame;
     gpu::vec2i_t           dimensions{};
+    input_video_format_e   video_format{input_video_format_e::uyvy};
 };
 
 class input_capture_s : public std::enable_shared_from_this<input_capture_s>
@@ -70,7 +78,9 @@ class input_capture_s : public std::enable_shared_from_this<input_capture_s>
     metrics_s metrics() const;
 
     void advance_frames(utils::flicks program_pts, utils::flicks program_target_time, bool discontinuity);
+    std::optional<utils::flicks> presentable_frame_pts(utils::flicks program_pts, utils::flicks early_tolerance) const;
     bool submit_frame(utils::flicks program_pts, utils::flicks early_tolerance);
+    std::optional<utils::flicks>          prepared_frame_program_pts() const;
     std::optional<resolved_input_frame_s> resolve_frame();
     void                                  release_prepared_frame();
     void                                  reset_frames();
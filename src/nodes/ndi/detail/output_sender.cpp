@@ -26,6 +26,21 @@ auto log() { return getlog("ndi"); }
 
 constexpr auto COLOR_METADATA = R"(<ndi_color_info primaries="bt_709" transfer="bt_709" matrix="bt_709"/>)";
 
+NDIlib_FourCC_video_type_e to_ndi_fourcc(pixel_format_e pixel_format)
+{
+    switch (pixel_format) {
+        case pixel_format_e::uyvy:
+            return NDIlib_FourCC_video_type_UYVY;
+        case pixel_format_e::nv12:
+            return NDIlib_FourCC_video_type_NV12;
+        case pixel_format_e::p216:
+            return NDIlib_FourCC_video_type_P216;
+        case pixel_format_e::rgba:
+            return NDIlib_FourCC_video_type_RGBA;
+    }
+    throw std::invalid_argument("Unknown NDI output pixel format");
+}
+
 struct sender_frame_s
 {
     std::shared_ptr<gpu::transfer::texture_readback_frame_s> readback;
@@ -39,6 +54,9 @@ class output_sender_s::impl_s
     {
         std::shared_ptr<gpu::transfer::texture_readback_stream_s> stream;
         gpu::vec2i_t                                              dimensions{};
+        NDIlib_FourCC_video_type_e                                fourcc{NDIlib_FourCC_video_type_RGBA};
+        size_t                                                    line_stride_bytes{};
+        size_t                                                    frame_size_bytes{};
         frame_rate_s                                              frame_rate;
         utils::flicks                                             frame_duration{};
         utils::flicks                                             program_time_origin{};
@@ -108,8 +126,8 @@ class output_sender_s::impl_s
         NDIlib_video_frame_v2_t ndi_frame{};
         ndi_frame.xres                 = frame.dimensions.x;
         ndi_frame.yres                 = frame.dimensions.y;
-        ndi_frame.FourCC               = NDIlib_FourCC_video_type_RGBA;
-        ndi_frame.line_stride_in_bytes = frame.dimensions.x * 4;
+        ndi_frame.FourCC               = state.fourcc;
+        ndi_frame.line_stride_in_bytes = static_cast<int>(state.line_stride_bytes);
         ndi_frame.p_data               = ndi_sdk::send_buffer(bytes);
         ndi_frame.frame_rate_N         = static_cast<int>(state.frame_rate.numerator);
         ndi_frame.frame_rate_D         = static_cast<int>(state.frame_rate.denominator);
@@ -140,9 +158,7 @@ class output_sender_s::impl_s
             if (!readback.has_value()) {
                 break;
             }
-            const auto expected_size =
-                static_cast<size_t>(state.dimensions.x) * static_cast<size_t>(state.dimensions.y) * 4;
-            if (readback->readable_host_bytes().size() != expected_size) {
+            if (readback->readable_host_bytes().size() != state.frame_size_bytes) {
                 continue;
             }
             queue.push({
@@ -353,6 +369,8 @@ class output_sender_s::impl_s
 
     void set_stream(std::shared_ptr<gpu::transfer::texture_readback_stream_s> stream,
                     gpu::vec2i_t                                              dimensions,
+                    pixel_format_e                                            pixel_format,
+                    const gpu::transfer::texture_transfer_layout_s&           transfer_layout,
                     frame_rate_s                                              frame_rate,
                     utils::flicks                                             frame_duration,
                     utils::flicks                                             program_time_origin,
@@ -364,6 +382,9 @@ class output_sender_s::impl_s
             stream_state_ = stream_state_s{
                 .stream                   = std::move(stream),
                 .dimensions               = dimensions,
+                .fourcc                   = to_ndi_fourcc(pixel_format),
+                .line_stride_bytes        = transfer_layout.host_row_stride_bytes,
+                .frame_size_bytes         = transfer_layout.host_buffer_size_bytes,
                 .frame_rate               = frame_rate,
                 .frame_duration           = frame_duration,
                 .program_time_origin      = program_time_origin,
@@ -436,12 +457,21 @@ output_sender_s::metrics_s output_sender_s::metrics() const { return impl_->metr
 
 void output_sender_s::set_stream(std::shared_ptr<gpu::transfer::texture_readback_stream_s> stream,
                                  gpu::vec2i_t                                              dimensions,
+                                 pixel_format_e                                            pixel_format,
+                                 const gpu::transfer::texture_transfer_layout_s&           transfer_layout,
                                  frame_rate_s                                              frame_rate,
                                  utils::flicks                                             frame_duration,
                                  utils::flicks                                             program_time_origin,
                                  size_t                                                    buffer_frames)
 {
-    impl_->set_stream(std::move(stream), dimensions, frame_rate, frame_duration, program_time_origin, buffer_frames);
+    impl_->set_stream(std::move(stream),
+                      dimensions,
+                      pixel_format,
+                      transfer_layout,
+                      frame_rate,
+                      frame_duration,
+                      program_time_origin,
+                      buffer_frames);
 }
 
 void output_sender_s::clear_stream() { impl_->clear_stream(); }
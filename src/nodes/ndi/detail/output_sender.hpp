@@ -1,5 +1,6 @@
 #pragma once
 #include "gpu/transfer/texture_readback_fwd.hpp"
+#include "gpu/transfer/texture_transfer.hpp"
 #include "gpu/types.hpp"
 #include "types/frame_rate.hpp"
 #include "utils/flicks.hpp"
@@ -12,6 +13,16 @@
 
 namespace miximus::nodes::ndi::detail {
 
+// The video FourCC sent to receivers. The YUV formats are packed on the GPU and
+// drop alpha; rgba keeps the image's alpha channel.
+enum class pixel_format_e : uint8_t
+{
+    uyvy,
+    nv12,
+    p216,
+    rgba,
+};
+
 class output_sender_s : public std::enable_shared_from_this<output_sender_s>
 {
   public:
@@ -70,6 +81,8 @@ class output_sender_s : public std::enable_shared_from_this<output_sender_s>
 
     void set_stream(std::shared_ptr<gpu::transfer::texture_readback_stream_s> stream,
                     gpu::vec2i_t                                              dimensions,
+                    pixel_format_e                                            pixel_format,
+                    const gpu::transfer::texture_transfer_layout_s&           transfer_layout,
                     frame_rate_s                                              frame_rate,
                     utils::flicks                                             frame_duration,
                     utils::flicks                                             program_time_origin,
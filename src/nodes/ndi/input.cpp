@@ -1,6 +1,8 @@
 #include "core/app_state.hpp"
 #include "core/node_status_registry.hpp"
 #include "detail/input_capture.hpp"
+#include "gpu/color_conversion_uniforms.hpp"
+#include "gpu/color_transfer.hpp"
 #include "gpu/context.hpp"
 #include "gpu/framebuffer.hpp"
 #include "gpu/shader.hpp"
@@ -8,6 +10,7 @@
 #include "gpu/textured_quad.hpp"
 #include "logger/logger.hpp"
 #include "media/media_clock_sample.hpp"
+#include "media/source_sync_group.hpp"
 #include "nodes/interface.hpp"
 #include "nodes/node.hpp"
 #include "nodes/node_map.hpp"
@@ -35,13 +38,16 @@ class node_impl : public node_i
 {
     std::shared_ptr<input_capture_s> capture_;
 
-    std::unique_ptr<gpu::framebuffer_s>   framebuffer_;
-    std::unique_ptr<gpu::textured_quad_s> textured_quad_;
+    std::unique_ptr<gpu::framebuffer_s>             framebuffer_;
+    std::unique_ptr<gpu::textured_quad_s>           textured_quad_;
+    std::optional<gpu::color_conversion_uniforms_s> conversion_uniforms_;
+    std::optional<input_video_format_e>             quad_video_format_;
 
     utils::observed_value_s<uint64_t>                     source_version_;
     utils::observed_value_s<std::pair<std::string, bool>> capture_selection_;
     std::chrono::steady_clock::time_point                 next_metrics_status_;
     gpu::texture_frame_ptr                                rendered_input_frame_;
+    std::string                                           sync_group_;
 
     output_interface_s<gpu::texture_s*> iface_tex_{*this, "tex"};
 
@@ -55,7 +61,7 @@ class node_impl : public node_i
         }
     }
 
-    void publish_metrics(core::node_status_registry_s* status_registry)
+    void publish_metrics(core::app_state_s* app, core::node_status_registry_s* status_registry)
     {
         const auto now = std::chrono::steady_clock::now();
         if (!capture_ || now < next_metrics_status_) {
@@ -85,6 +91,9 @@ class node_impl : public node_i
                 .source_queue_discontinuities         = metrics.source_queue.discontinuities,
                 .source_queue_transfer_failures       = metrics.source_queue.transfer_failures,
                 .source_queue_transfer_cancellations  = metrics.source_queue.transfer_cancellations,
+                .source_frame_records                 = metrics.source_queue.frame_records.records,
+                .source_frame_records_reused          = metrics.source_queue.frame_records.reused,
+                .source_frame_record_allocations      = metrics.source_queue.frame_records.allocations,
                 .source_recovered_rate                = metrics.source_queue.recovered_rate,
                 .source_observed_rate                 = metrics.source_queue.observed_rate,
                 .source_phase_offset_us               = metrics.source_queue.phase_offset,
@@ -93,6 +102,15 @@ class node_impl : public node_i
                 .source_repeat_next_frame_lead_min_us = metrics.source_queue.repeat_next_frame_lead_min,
                 .source_repeat_next_frame_lead_max_us = metrics.source_queue.repeat_next_frame_lead_max,
             });
+        const auto sync_metrics = sync_group_.empty() ? media::source_sync_group_metrics_s{}
+                                                      : app->source_sync_registry()->metrics(sync_group_);
+        status_registry->write(id_,
+                               status::source_sync_status_s{
+                                   .sync_group_members      = sync_metrics.members,
+                                   .sync_group_skew_us      = sync_metrics.skew,
+                                   .sync_group_skew_max_us  = sync_metrics.skew_max,
+                                   .sync_group_hold_back_us = sync_metrics.hold_back,
+                               });
         next_metrics_status_ = now + 1s;
     }
 
@@ -151,12 +169,20 @@ class node_impl : public node_i
 
         const auto selection =
             std::pair(state.get_option<std::string>("source_name"), state.get_option<bool>("enabled"));
+        sync_group_ = state.get_option<std::string>("sync_group");
         update_capture_lifecycle(app, status_registry, selection);
-        publish_metrics(status_registry);
+        publish_metrics(app, status_registry);
 
         if (capture_ && capture_->phase() == input_capture_s::phase_e::running) {
             const auto& frame = app->frame_context();
             capture_->advance_frames(frame.program_pts, frame.program_target_time, frame.discontinuity);
+            if (!sync_group_.empty()) {
+                app->source_sync_registry()->offer(
+                    sync_group_,
+                    frame.program_pts,
+                    frame.frame_duration,
+                    capture_->presentable_frame_pts(frame.program_pts, frame.frame_duration / 2));
+            }
         }
 
         status_registry->write(id_,
@@ -167,9 +193,23 @@ class node_impl : public node_i
 
     void submit(core::app_state_s* app, const node_map_t& /*nodes*/, const node_state_s& /*state*/) final
     {
-        if (capture_) {
-            const auto& frame = app->frame_context();
+        if (!capture_) {
+            return;
+        }
+
+        const auto& frame = app->frame_context();
+        if (sync_group_.empty()) {
             (void)capture_->submit_frame(frame.program_pts, frame.frame_duration / 2);
+            return;
+        }
+
+        // Grouped inputs select at the group's earliest offer so every member
+        // presents frames captured at the same instant.
+        auto* sync_registry = app->source_sync_registry();
+        (void)capture_->submit_frame(sync_registry->selection_pts(sync_group_, frame.program_pts),
+                                     frame.frame_duration / 2);
+        if (const auto selected = capture_->prepared_frame_program_pts()) {
+            sync_registry->report_selection(sync_group_, frame.program_pts, *selected);
         }
     }
 
@@ -190,19 +230,28 @@ class node_impl : public node_i
         }
 
         // The shared timed-source queue has already selected and aligned this
-        // raw NDI frame. This conversion only linearizes its Rec.709 image.
-        if (!textured_quad_) {
-            auto shader    = app->ctx()->get_shader(gpu::shader_program_s::name_e::strip_gamma);
-            textured_quad_ = std::make_unique<gpu::textured_quad_s>(shader);
+        // raw NDI frame. This conversion decodes its Rec.709 YUV samples into
+        // linear RGB.
+        if (quad_video_format_ != frame->video_format) {
+            const auto name = frame->video_format == input_video_format_e::p216
+                                  ? gpu::shader_program_s::name_e::p216_to_rgb
+                                  : gpu::shader_program_s::name_e::uyvy_to_rgb;
+            auto shader     = app->ctx()->get_shader(name);
+            textured_quad_  = std::make_unique<gpu::textured_quad_s>(shader);
+            conversion_uniforms_.emplace(*shader);
+            quad_video_format_ = frame->video_format;
         }
 
+        conversion_uniforms_->set(*textured_quad_->shader(),
+                                  frame->dimensions.x,
+                                  gpu::get_color_transfer_from_yuv(gpu::color_transfer_e::Rec709),
+                                  gpu::get_gamut_transfer_to_rec709(gpu::color_transfer_e::Rec709));
+
         framebuffer_->begin_render(gpu::framebuffer_s::load_op_e::clear);
         textured_quad_->draw(rendered_input_frame_->texture());
         gpu::framebuffer_s::end_render();
 
-        auto* output = framebuffer_->texture();
-        output->generate_mip_maps();
-        iface_tex_.set_value(output);
+        iface_tex_.set_value(framebuffer_->texture());
     }
 
     void complete(core::app_state_s* /*app*/) final
@@ -222,6 +271,7 @@ class node_impl : public node_i
             {"name",        "NDI Input"},
             {"enabled",     true       },
             {"source_name", ""         },
+            {"sync_group",  ""         },
         };
     }
 
@@ -233,6 +283,9 @@ class node_impl : public node_i
         if (name == "enabled") {
             return normalize_option_value<bool>(value);
         }
+        if (name == "sync_group") {
+            return normalize_option_value<std::string_view>(value);
+        }
         return option_result_e::invalid;
     }
 
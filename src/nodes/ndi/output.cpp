@@ -1,11 +1,13 @@
 #include "core/app_state.hpp"
 #include "core/node_status_registry.hpp"
 #include "detail/output_sender.hpp"
+#include "gpu/color_transfer.hpp"
 #include "gpu/context.hpp"
 #include "gpu/framebuffer.hpp"
 #include "gpu/shader.hpp"
 #include "gpu/texture.hpp"
 #include "gpu/textured_quad.hpp"
+#include "gpu/transfer/readback_wire_format.hpp"
 #include "gpu/transfer/texture_readback.hpp"
 #include "logger/logger.hpp"
 #include "nodes/interface.hpp"
@@ -14,11 +16,13 @@
 #include "nodes/normalize_option.hpp"
 #include "registry.hpp"
 #include "types/node_status_json.hpp"
+#include "utils/lookup.hpp"
 #include "utils/observed_value.hpp"
 
 #include <chrono>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -32,17 +36,46 @@ using namespace miximus::nodes::ndi::detail;
 
 auto log() { return getlog("ndi"); }
 
+std::optional<gpu::transfer::readback_wire_format_e> to_wire_format(pixel_format_e pixel_format)
+{
+    switch (pixel_format) {
+        case pixel_format_e::uyvy:
+            return gpu::transfer::readback_wire_format_e::uyvy_u8;
+        case pixel_format_e::nv12:
+            return gpu::transfer::readback_wire_format_e::nv12;
+        case pixel_format_e::p216:
+            return gpu::transfer::readback_wire_format_e::p216;
+        case pixel_format_e::rgba:
+            return std::nullopt;
+    }
+    return std::nullopt;
+}
+
+gpu::transfer::texture_transfer_layout_s make_rgba_transfer_layout(gpu::vec2i_t dimensions)
+{
+    return {
+        .dimensions             = dimensions,
+        .pixel_format           = gpu::texture_s::pixel_format_e::rgba_u8,
+        .host_row_stride_bytes  = static_cast<size_t>(dimensions.x) * 4,
+        .host_buffer_size_bytes = static_cast<size_t>(dimensions.x) * static_cast<size_t>(dimensions.y) * 4,
+        .host_memory_access     = gpu::transfer::host_memory_access_e::read_only,
+    };
+}
+
 class node_impl : public node_i
 {
     using timing_selection_t = std::tuple<frame_rate_s, uint64_t, int>;
+    using stream_selection_t = std::pair<gpu::vec2i_t, pixel_format_e>;
 
     std::shared_ptr<output_sender_s>                          sender_;
     std::shared_ptr<gpu::transfer::texture_readback_stream_s> readback_stream_;
     std::unique_ptr<gpu::textured_quad_s>                     textured_quad_;
+    gpu::uniform_location_s<int>                              readback_mapping_location_;
+    std::unique_ptr<gpu::transfer::readback_wire_encoder_s>   wire_encoder_;
 
     utils::observed_value_s<std::pair<std::string, bool>>   sender_selection_;
     utils::observed_value_s<timing_selection_t>             timing_selection_;
-    utils::observed_value_s<gpu::vec2i_t>                   stream_dimensions_;
+    utils::observed_value_s<stream_selection_t>             stream_selection_;
     std::chrono::steady_clock::time_point                   next_metrics_status_;
     uint64_t                                                render_target_drops_{};
     std::optional<gpu::transfer::texture_readback_target_s> render_target_;
@@ -56,8 +89,9 @@ class node_impl : public node_i
             sender_->clear_stream();
         }
         readback_stream_.reset();
-        stream_dimensions_.reset();
+        stream_selection_.reset();
         textured_quad_.reset();
+        wire_encoder_.reset();
     }
 
     void stop_sender()
@@ -150,21 +184,30 @@ class node_impl : public node_i
         sender_->start_async();
     }
 
-    void ensure_readback_stream(core::app_state_s* app, gpu::vec2i_t dimensions)
+    void ensure_readback_stream(core::app_state_s* app, gpu::vec2i_t dimensions, pixel_format_e pixel_format)
     {
-        const auto& settings = app->frame_settings();
-        if (readback_stream_ && !stream_dimensions_.would_change(dimensions)) {
+        const auto& settings  = app->frame_settings();
+        const auto  selection = stream_selection_t{dimensions, pixel_format};
+        if (readback_stream_ && !stream_selection_.would_change(selection)) {
             return;
         }
 
         clear_render_state();
-        const gpu::transfer::texture_transfer_layout_s transfer_layout{
-            .dimensions             = dimensions,
-            .pixel_format           = gpu::texture_s::pixel_format_e::rgba_u8,
-            .host_row_stride_bytes  = static_cast<size_t>(dimensions.x) * 4,
-            .host_buffer_size_bytes = static_cast<size_t>(dimensions.x) * static_cast<size_t>(dimensions.y) * 4,
-            .host_memory_access     = gpu::transfer::host_memory_access_e::read_only,
-        };
+        auto wire_format     = to_wire_format(pixel_format);
+        auto transfer_layout = make_rgba_transfer_layout(dimensions);
+        if (wire_format.has_value()) {
+            try {
+                transfer_layout = gpu::transfer::make_wire_transfer_layout(*wire_format, dimensions);
+            } catch (const std::invalid_argument& e) {
+                log()->warn("NDI output {} falls back to RGBA for {}x{}: {}",
+                            enum_to_string(pixel_format),
+                            dimensions.x,
+                            dimensions.y,
+                            e.what());
+                wire_format.reset();
+                pixel_format = pixel_format_e::rgba;
+            }
+        }
         const auto readback_slot_count =
             output_sender_s::get_readback_slot_count(static_cast<size_t>(settings.ndi_output.buffer_frames));
         readback_stream_ = app->texture_readback_service()->create_stream({
@@ -172,9 +215,18 @@ class node_impl : public node_i
             .max_slots       = readback_slot_count,
             .initial_slots   = readback_slot_count,
         });
-        stream_dimensions_.commit(dimensions);
+        if (wire_format.has_value()) {
+            wire_encoder_ = std::make_unique<gpu::transfer::readback_wire_encoder_s>(
+                app->ctx(),
+                *wire_format,
+                transfer_layout,
+                gpu::get_color_transfer_to_yuv(gpu::color_transfer_e::Rec709));
+        }
+        stream_selection_.commit(selection);
         sender_->set_stream(readback_stream_,
                             dimensions,
+                            pixel_format,
+                            transfer_layout,
                             settings.frame_rate,
                             app->frame_context().frame_duration,
                             app->frame_context().program_target_time - app->frame_context().program_pts,
@@ -235,7 +287,8 @@ class node_impl : public node_i
             return;
         }
 
-        ensure_readback_stream(app, texture->display_dimensions());
+        ensure_readback_stream(
+            app, texture->display_dimensions(), state.get_enum_option_unchecked<pixel_format_e>("pixel_format"));
         if (readback_stream_->initial_slots_pending()) {
             return;
         }
@@ -245,16 +298,27 @@ class node_impl : public node_i
             return;
         }
 
+        // YUV formats are packed on the GPU so the readback already holds the
+        // bytes NDI transmits, sparing the SDK its own RGBA conversion.
+        if (wire_encoder_) {
+            wire_encoder_->encode(texture, *target);
+            target->set_program_target_time(app->frame_context().program_target_time);
+            render_target_ = std::move(target);
+            return;
+        }
+
         // Convert the internal linear image to the Rec.709 RGBA representation
         // advertised in the NDI metadata, with top-to-bottom row order.
         if (!textured_quad_) {
             auto shader    = app->ctx()->get_shader(gpu::shader_program_s::name_e::apply_gamma);
             textured_quad_ = std::make_unique<gpu::textured_quad_s>(shader);
             textured_quad_->set_blending_enabled(false);
+            readback_mapping_location_ = shader->get_uniform_location<int>("readback_component_mapping");
         }
 
-        textured_quad_->shader()->set_uniform("readback_component_mapping",
+        textured_quad_->shader()->set_uniform(readback_mapping_location_,
                                               static_cast<int>(target->readback_component_mapping()));
+        texture->update_mip_maps_for({}, target->framebuffer()->texture()->display_dimensions());
         target->framebuffer()->begin_render(gpu::framebuffer_s::load_op_e::clear);
         textured_quad_->draw(texture);
         gpu::framebuffer_s::end_render();
@@ -277,9 +341,10 @@ class node_impl : public node_i
     nlohmann::json get_default_options() const final
     {
         return {
-            {"name",        "NDI Output"},
-            {"enabled",     true        },
-            {"source_name", id_         },
+            {"name",         "NDI Output"                        },
+            {"enabled",      true                                },
+            {"source_name",  id_                                 },
+            {"pixel_format", enum_to_string(pixel_format_e::uyvy)},
         };
     }
 
@@ -291,6 +356,9 @@ class node_impl : public node_i
         if (name == "enabled") {
             return normalize_option_value<bool>(value);
         }
+        if (name == "pixel_format") {
+            return normalize_enum_option_value<pixel_format_e>(value);
+        }
         return option_result_e::invalid;
     }
 
@@ -0,0 +1,21 @@
+#include "output_migrations.hpp"
+
+#include <nlohmann/json.hpp>
+
+namespace {
+
+// Outputs saved before the pixel format option sent RGBA, alpha included.
+void migrate_v1_to_v2(nlohmann::json& options) { options["pixel_format"] = "rgba"; }
+
+} // namespace
+
+namespace miximus::nodes::ndi {
+
+std::vector<node_migration_s> output_migrations()
+{
+    std::vector<node_migration_s> migrations(1);
+    migrations[0].migrate_options = migrate_v1_to_v2;
+    return migrations;
+}
+
+} // namespace miximus::nodes::ndi
@@ -0,0 +1,10 @@
+#pragma once
+#include "nodes/node_definition.hpp"
+
+#include <vector>
+
+namespace miximus::nodes::ndi {
+
+std::vector<node_migration_s> output_migrations();
+
+} // namespace miximus::nodes::ndi
@@ -1,5 +1,7 @@
 #include "register.hpp"
 
+#include "output_migrations.hpp"
+
 #include <memory>
 
 namespace miximus::nodes::ndi {
@@ -10,7 +12,7 @@ std::shared_ptr<node_i> create_output_node();
 void register_nodes(node_definition_map_t* map)
 {
     map->emplace("ndi_input", ndi::create_input_node);
-    map->emplace("ndi_output", ndi::create_output_node);
+    map->emplace("ndi_output", node_definition_s{ndi::create_output_node, output_migrations()});
 }
 
 } // namespace miximus::nodes::ndi
@@ -6,6 +6,8 @@
 
 #include <nlohmann/json_fwd.hpp>
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -28,14 +30,23 @@ class node_i
     struct prepare_result_s
     {
         bool demands_execution{};
+        /**
+         * Set by nodes whose outputs only depend on their options, their inputs
+         * and this version, 0 when nothing else affects them. The executor skips
+         * execute() and keeps the previous outputs while the version, the node
+         * state and everything upstream are unchanged since the last execute().
+         * Leave unset when the outputs change on their own, e.g. with time.
+         */
+        std::optional<uint64_t> content_version;
     };
 
     virtual std::string_view type() const = 0;
 
     /**
-     * Called once on the config thread immediately after the node is constructed,
-     * while the config lock is held. No GL context is available. Use only for
-     * lightweight one-time setup that does not require the render thread.
+     * Called once immediately after the node is constructed, before it is added
+     * to the graph. No GL context is available. Show files are loaded on several
+     * threads at once, so use only for lightweight one-time setup that touches
+     * no state shared with other nodes.
      */
     virtual void init(std::string_view id);
 
@@ -48,6 +59,14 @@ class node_i
      */
     virtual void prepare(core::app_state_s*, const node_state_s&, prepare_result_s*) {};
 
+    /**
+     * Called after all nodes have prepared for a node that will not execute this
+     * frame because it and everything it depends on are unchanged. Return false
+     * if the outputs of the last execute() can no longer be used, the node then
+     * executes as usual.
+     */
+    virtual bool retain_outputs(core::app_state_s*) { return true; }
+
     /**
      * Called once for every node in the demanded upstream closure after all
      * nodes have prepared and before any demanded node executes. Use this to
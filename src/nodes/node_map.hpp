@@ -6,8 +6,10 @@
 #include <nlohmann/json.hpp>
 
 #include <cassert>
+#include <cstdint>
 #include <format>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
 
@@ -71,6 +73,12 @@ struct node_record_s
 {
     std::shared_ptr<node_i> node;
     node_state_s            state;
+
+    // Content version reported by prepare() this frame
+    std::optional<uint64_t> content_version;
+    // Content version the current outputs were executed with, cleared when the
+    // record is replaced or the node misses a frame
+    std::optional<uint64_t> executed_version;
 };
 
 } // namespace miximus::nodes
@@ -20,6 +20,7 @@ using namespace miximus::nodes;
 using nlohmann::json;
 
 using framebuffer_settings_s = core::app_state_s::frame_settings_s::framebuffer_settings_s;
+using gpu_memory_settings_s  = core::app_state_s::frame_settings_s::gpu_memory_settings_s;
 
 std::optional<uint32_t> read_positive_uint32(const json& value)
 {
@@ -102,6 +103,7 @@ class node_impl final : public node_i
             {"decklink_output_buffer_frames", decklink_output_buffer_limits_s::DEFAULT_FRAME_COUNT     },
             {"ndi_output_buffer_frames",      ndi_output_buffer_limits_s::DEFAULT_FRAME_COUNT          },
             {"screen_output_buffer_frames",   screen_output_buffer_limits_s::DEFAULT_FRAME_COUNT       },
+            {"gpu_memory_budget_mb",          gpu_memory_settings_s{}.budget_mb                        },
         };
     }
 
@@ -128,6 +130,9 @@ class node_impl final : public node_i
                                                screen_output_buffer_limits_s::MINIMUM_FRAME_COUNT,
                                                screen_output_buffer_limits_s::MAXIMUM_FRAME_COUNT);
         }
+        if (name == "gpu_memory_budget_mb") {
+            return normalize_option_value<int>(value, 0, gpu_memory_settings_s::MAX_BUDGET_MB);
+        }
         return option_result_e::invalid;
     }
 };
@@ -79,6 +79,8 @@ class node_impl : public node_i
     utils::observed_value_s<uint64_t>     loaded_font_version_;
     utils::observed_value_s<uint64_t>     reported_font_version_;
     int                                   line_height_extra_{70};
+    // Every visible line was drawn by the last execute and no work is pending
+    bool                                  settled_{};
 
   public:
     explicit node_impl() = default;
@@ -100,7 +102,7 @@ class node_impl : public node_i
         }
     }
 
-    void prepare(core::app_state_s* app, const node_state_s& state, prepare_result_s* /*result*/) final
+    void prepare(core::app_state_s* app, const node_state_s& state, prepare_result_s* result) final
     {
         const auto font_version      = app->font_registry()->get_font_list_version();
         const bool font_list_changed = reported_font_version_.observe(font_version);
@@ -123,12 +125,18 @@ class node_impl : public node_i
             auto shader    = app->ctx()->get_shader(gpu::shader_program_s::name_e::basic);
             textured_quad_ = std::make_unique<gpu::textured_quad_s>(shader);
         }
+
+        if (settled_) {
+            result->content_version = font_version;
+        }
     }
 
     // NOLINTNEXTLINE(readability-function-cognitive-complexity)
     void execute(core::app_state_s* app, const node_map_t& nodes, const node_state_s& state) final
     {
         rendered_line_frames_.clear();
+        settled_ = false;
+
         auto       file_path    = state.get_option<std::string_view>("file_path");
         auto       font_name    = state.get_option<std::string_view>("font_name");
         auto       font_variant = state.get_option<std::string_view>("font_variant");
@@ -226,6 +234,7 @@ class node_impl : public node_i
         }
 
         if (text_.lines.empty()) {
+            settled_ = true;
             return;
         }
 
@@ -255,6 +264,7 @@ class node_impl : public node_i
         fb->begin_render(viewport);
         auto       batch = textured_quad_->begin_batch();
         const auto scale = gpu::pixels_to_normalized(gpu::vec2_t(tx_dim), viewport.size);
+        bool       all_lines_drawn = true;
 
         /**
          * Iterate over render lines, starting 2 lines over visible area, ending 2 lines below
@@ -288,6 +298,7 @@ class node_impl : public node_i
 
                 auto upload = rl->upload_stream->try_acquire_upload_buffer();
                 if (!upload) {
+                    all_lines_drawn = false;
                     continue;
                 }
 
@@ -304,6 +315,7 @@ class node_impl : public node_i
                 if (future) {
                     rl->ready = std::move(*future);
                 }
+                all_lines_drawn = false;
                 continue;
             }
 
@@ -316,9 +328,11 @@ class node_impl : public node_i
                     if (rl->line_no == txt_line_index) {
                         // The upload service publishes the new texture when ready.
                     } else {
+                        all_lines_drawn = false;
                         continue;
                     }
                 } else {
+                    all_lines_drawn = false;
                     continue;
                 }
             }
@@ -326,6 +340,7 @@ class node_impl : public node_i
             const std::unique_lock lock(rl->mtx);
             auto frame = rl->upload_stream ? rl->upload_stream->select_latest_completed_upload() : nullptr;
             if (!frame || rl->upload_stream->retained_upload_id() != rl->upload_id) {
+                all_lines_drawn = false;
                 continue;
             }
             frame->wait_for_upload_on_gpu();
@@ -338,6 +353,7 @@ class node_impl : public node_i
             rendered_line_frames_.emplace_back(std::move(frame));
         }
         gpu::framebuffer_s::end_render();
+        settled_ = all_lines_drawn;
     }
 
     void complete(core::app_state_s* /*app*/) final
@@ -38,6 +38,7 @@ class node_impl : public node_i
     struct text_render_info_s
     {
         std::shared_ptr<gpu::transfer::texture_upload_stream_s> upload_stream;
+        gpu::transfer::texture_upload_id_s                      upload_id{};
         gpu::vec2i_t                                            surface_size{};
         bool                                                    needs_update{true};
         utils::observed_value_s<std::string>                    text;
@@ -58,9 +59,10 @@ class node_impl : public node_i
     utils::observed_value_s<uint64_t>        font_version_;
     utils::observed_value_s<std::string>     status_font_name_;
     gpu::texture_frame_ptr                   rendered_text_frame_;
+    gpu::transfer::texture_upload_id_s       drawn_upload_id_{};
 
   public:
-    void prepare(core::app_state_s* app, const node_state_s& state, prepare_result_s* /*result*/) final
+    void prepare(core::app_state_s* app, const node_state_s& state, prepare_result_s* result) final
     {
         const auto font_version      = app->font_registry()->get_font_list_version();
         const bool font_list_changed = font_version_.observe(font_version);
@@ -107,6 +109,12 @@ class node_impl : public node_i
         if (text_info_->needs_update && !text_info_->text.value().empty()) {
             render_text(app, state);
         }
+
+        // Reusable once the latest rendering of the text has been drawn
+        if (text_info_->text.value().empty() ||
+            (!text_info_->needs_update && drawn_upload_id_ == text_info_->upload_id)) {
+            result->content_version = 0;
+        }
     }
 
     void render_text(core::app_state_s* app, [[maybe_unused]] const node_state_s& state)
@@ -184,6 +192,7 @@ class node_impl : public node_i
                 .transfer_layout = transfer_layout,
                 .max_slots       = 3,
             });
+            drawn_upload_id_ = {};
         }
 
         auto upload = text_info_->upload_stream->try_acquire_upload_buffer();
@@ -199,6 +208,7 @@ class node_impl : public node_i
 
         // Render text in white
         font_instance_->render_string(utf32_text, &surface, text_position);
+        text_info_->upload_id = upload->upload_id();
         upload->submit();
 
         text_info_->needs_update = false;
@@ -249,6 +259,7 @@ class node_impl : public node_i
 
         textured_quad_->draw(rendered_text_frame_->texture(), {.pos = position, .size = scale});
         gpu::framebuffer_s::end_render();
+        drawn_upload_id_ = text_info_->upload_stream->retained_upload_id();
     }
 
     void complete(core::app_state_s* /*app*/) final
@@ -1,6 +1,7 @@
+#include "core/app_state.hpp"
 #include "gpu/framebuffer.hpp"
-
 #include "gpu/types.hpp"
+#include "nodes/framebuffer_pool.hpp"
 #include "nodes/interface.hpp"
 #include "nodes/node.hpp"
 #include "nodes/node_map.hpp"
@@ -18,11 +19,19 @@ class node_impl : public node_i
     input_interface_s<gpu::vec2_t>          iface_size_{*this, "size"};
     output_interface_s<gpu::framebuffer_s*> iface_fb_{*this, "fb"};
 
-    std::unique_ptr<gpu::framebuffer_s> framebuffer_;
-
   public:
     explicit node_impl() = default;
 
+    void prepare(core::app_state_s* /*app*/, const node_state_s& /*state*/, prepare_result_s* result) final
+    {
+        result->content_version = 0;
+    }
+
+    bool retain_outputs(core::app_state_s* app) final
+    {
+        return app->framebuffer_pool()->retain(id_, iface_fb_.get_value());
+    }
+
     void execute(core::app_state_s* app, const node_map_t& nodes, const node_state_s& state) final
     {
         auto         size_opt   = state.get_option<gpu::vec2_t>("size");
@@ -31,14 +40,14 @@ class node_impl : public node_i
 
         size = glm::max(size, gpu::vec2i_t{128, 128});
 
-        if (!framebuffer_ || framebuffer_->texture()->texture_dimensions() != size) {
-            framebuffer_ = std::make_unique<gpu::framebuffer_s>(size, gpu::texture_s::pixel_format_e::rgba_f16);
-        }
+        // The target is shared with other framebuffer nodes once everything
+        // drawing into or reading from it this frame has finished
+        auto* framebuffer = app->framebuffer_pool()->acquire(*app, nodes, id_, {.dimensions = size});
 
-        framebuffer_->begin_render(gpu::framebuffer_s::load_op_e::clear);
+        framebuffer->begin_render(gpu::framebuffer_s::load_op_e::clear);
         gpu::framebuffer_s::end_render();
 
-        iface_fb_.set_value(framebuffer_.get());
+        iface_fb_.set_value(framebuffer);
     }
 
     nlohmann::json get_default_options() const final
@@ -19,22 +19,15 @@ class node_impl : public node_i
   public:
     explicit node_impl() = default;
 
-    void prepare(core::app_state_s* /*app*/, const node_state_s& /*nodes*/, prepare_result_s* /*result*/) final {}
+    void prepare(core::app_state_s* /*app*/, const node_state_s& /*state*/, prepare_result_s* result) final
+    {
+        result->content_version = 0;
+    }
 
     void execute(core::app_state_s* app, const node_map_t& nodes, const node_state_s& state) final
     {
-        gpu::texture_s* texture = nullptr; // NOLINT(misc-const-correctness)
-
-        auto fb = iface_fb_.resolve_value(app, nodes, state);
-        if (fb != nullptr) {
-            texture = fb->texture();
-        }
-
-        if (texture != nullptr) {
-            texture->generate_mip_maps();
-        }
-
-        iface_tex_.set_value(texture);
+        auto* fb = iface_fb_.resolve_value(app, nodes, state);
+        iface_tex_.set_value(fb != nullptr ? fb->texture() : nullptr);
     }
 
     nlohmann::json get_default_options() const final
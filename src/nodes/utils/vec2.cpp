@@ -19,6 +19,11 @@ class node_impl : public node_i
   public:
     explicit node_impl() = default;
 
+    void prepare(core::app_state_s* /*app*/, const node_state_s& /*state*/, prepare_result_s* result) final
+    {
+        result->content_version = 0;
+    }
+
     void execute(core::app_state_s* app, const node_map_t& nodes, const node_state_s& state) final
     {
         auto x = state.get_option<double>("x", 0);
@@ -29,7 +29,7 @@ uint8_t rec709_to_linear(uint8_t value)
 
 std::shared_ptr<const image_asset_s> create_image_asset(std::string_view resource_path)
 {
-    const auto encoded      = static_files::get_resource_files().get_file_or_throw(resource_path).unzip();
+    const auto encoded      = static_files::get_resource_files().get_file_or_throw(resource_path).contents();
     const auto image        = stb::decode_image(std::as_bytes(std::span{encoded}), stb::image_channels_e::rgba);
     const auto image_pixels = image.pixels();
     const auto dimensions   = gpu::vec2i_t{image.width(), image.height()};
@@ -0,0 +1,18 @@
+#pragma once
+#include "utils/lookup.hpp"
+
+namespace miximus {
+
+// Wire format of the messages a server sends on one websocket connection
+enum class message_encoding_e
+{
+    json,
+    msgpack,
+};
+
+constexpr std::optional<message_encoding_e> message_encoding_from_string(std::string_view value)
+{
+    return enum_from_string<message_encoding_e>(value);
+}
+
+} // namespace miximus
@@ -65,6 +65,7 @@ struct application_lifecycle_status_s
     size_t  demanding_node_count{};
     size_t  submitted_node_count{};
     size_t  executed_node_count{};
+    size_t  reused_node_count{};
 };
 
 struct application_scheduler_status_s
@@ -87,6 +88,31 @@ struct application_scheduler_status_s
     bool        sustained_overload{};
 };
 
+struct application_autosave_status_s
+{
+    uint64_t                   autosave_count{};
+    uint64_t                   autosave_failures{};
+    int64_t                    autosave_duration_us{};
+    int64_t                    autosave_duration_max_us{};
+    uint64_t                   autosave_bytes{};
+    uint64_t                   autosave_bytes_total{};
+    std::optional<std::string> autosave_error;
+};
+
+struct application_gpu_memory_status_s
+{
+    uint64_t gpu_memory_total_bytes{};
+    uint64_t gpu_memory_shared_bytes{};
+    uint64_t gpu_memory_budget_bytes{};
+    bool     gpu_memory_over_budget{};
+};
+
+struct gpu_memory_status_s
+{
+    uint64_t gpu_memory_bytes{};
+    uint64_t gpu_memory_allocations{};
+};
+
 struct render_delay_test_status_s
 {
     int64_t  test_render_delay_ms{};
@@ -107,6 +133,9 @@ struct source_timing_status_s
     uint64_t                     source_queue_discontinuities{};
     uint64_t                     source_queue_transfer_failures{};
     uint64_t                     source_queue_transfer_cancellations{};
+    size_t                       source_frame_records{};
+    uint64_t                     source_frame_records_reused{};
+    uint64_t                     source_frame_record_allocations{};
     std::optional<double>        source_recovered_rate;
     std::optional<double>        source_observed_rate;
     std::optional<utils::flicks> source_phase_offset_us;
@@ -116,6 +145,14 @@ struct source_timing_status_s
     std::optional<utils::flicks> source_repeat_next_frame_lead_max_us;
 };
 
+struct source_sync_status_s
+{
+    size_t                       sync_group_members{};
+    std::optional<utils::flicks> sync_group_skew_us;
+    std::optional<utils::flicks> sync_group_skew_max_us;
+    std::optional<utils::flicks> sync_group_hold_back_us;
+};
+
 struct decklink_input_device_status_s
 {
     std::optional<bool>        signal_locked;
@@ -282,7 +319,8 @@ BOOST_DESCRIBE_STRUCT(application_lifecycle_status_s,
                        complete_duration_us,
                        demanding_node_count,
                        submitted_node_count,
-                       executed_node_count))
+                       executed_node_count,
+                       reused_node_count))
 BOOST_DESCRIBE_STRUCT(application_scheduler_status_s,
                       (),
                       (clock_source,
@@ -301,6 +339,22 @@ BOOST_DESCRIBE_STRUCT(application_scheduler_status_s,
                        skipped_frames_last,
                        skipped_frames_total,
                        sustained_overload))
+BOOST_DESCRIBE_STRUCT(application_autosave_status_s,
+                      (),
+                      (autosave_count,
+                       autosave_failures,
+                       autosave_duration_us,
+                       autosave_duration_max_us,
+                       autosave_bytes,
+                       autosave_bytes_total,
+                       autosave_error))
+BOOST_DESCRIBE_STRUCT(application_gpu_memory_status_s,
+                      (),
+                      (gpu_memory_total_bytes,
+                       gpu_memory_shared_bytes,
+                       gpu_memory_budget_bytes,
+                       gpu_memory_over_budget))
+BOOST_DESCRIBE_STRUCT(gpu_memory_status_s, (), (gpu_memory_bytes, gpu_memory_allocations))
 BOOST_DESCRIBE_STRUCT(render_delay_test_status_s,
                       (),
                       (test_render_delay_ms, test_render_delay_every, test_render_delay_injections))
@@ -317,6 +371,9 @@ BOOST_DESCRIBE_STRUCT(source_timing_status_s,
                        source_queue_discontinuities,
                        source_queue_transfer_failures,
                        source_queue_transfer_cancellations,
+                       source_frame_records,
+                       source_frame_records_reused,
+                       source_frame_record_allocations,
                        source_recovered_rate,
                        source_observed_rate,
                        source_phase_offset_us,
@@ -324,6 +381,9 @@ BOOST_DESCRIBE_STRUCT(source_timing_status_s,
                        source_phase_adjustment_us,
                        source_repeat_next_frame_lead_min_us,
                        source_repeat_next_frame_lead_max_us))
+BOOST_DESCRIBE_STRUCT(source_sync_status_s,
+                      (),
+                      (sync_group_members, sync_group_skew_us, sync_group_skew_max_us, sync_group_hold_back_us))
 BOOST_DESCRIBE_STRUCT(decklink_input_device_status_s,
                       (),
                       (signal_locked,
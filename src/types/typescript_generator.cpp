@@ -82,6 +82,8 @@ std::string typescript_type()
         return "error_e";
     } else if constexpr (std::same_as<T, font_registry_command_e>) {
         return "font_registry_command_e";
+    } else if constexpr (std::same_as<T, message_encoding_e>) {
+        return "message_encoding_e";
     } else if constexpr (miximus::detail::optional_traits<T>::value) {
         return typescript_type<typename miximus::detail::optional_traits<T>::value_type>() + " | null";
     } else if constexpr (vector_traits<T>::value) {
@@ -98,6 +100,8 @@ std::string typescript_type()
         return "node_s";
     } else if constexpr (std::same_as<T, web_message::config_s>) {
         return "config_s";
+    } else if constexpr (std::same_as<T, web_message::config_changes_s>) {
+        return "config_changes_s";
     } else if constexpr (unordered_map_traits<T>::value) {
         static_assert(std::same_as<typename unordered_map_traits<T>::key_type, std::string>);
         static_assert(std::same_as<typename unordered_map_traits<T>::value_type, nlohmann::json>);
@@ -116,12 +120,17 @@ std::string typescript_member_type()
                       std::same_as<Object, web_message::update_node_command_s> ||
                       std::same_as<Object, web_message::update_node_request_s>) {
             return "options_s";
-        } else if constexpr (std::same_as<Object, web_message::node_status_result_s> ||
-                             std::same_as<Object, web_message::node_status_command_s>) {
+        } else if constexpr (std::same_as<Object, web_message::node_status_result_s>) {
             return "node_status_s";
+        } else if constexpr (std::same_as<Object, web_message::node_status_command_s>) {
+            return "Readonly<Record<string, node_status_s>>";
         } else {
             static_assert(always_false<Object>, "Opaque JSON contract member needs a TypeScript type");
         }
+    } else if constexpr (std::same_as<Member, std::vector<nlohmann::json>>) {
+        static_assert(std::same_as<Object, web_message::config_changes_s>,
+                      "Opaque JSON contract member needs a TypeScript type");
+        return "readonly config_change_t[]";
     } else {
         return typescript_type<Member>();
     }
@@ -195,6 +204,7 @@ std::string generate_typescript()
     emit_enum<topic_e>(output, "topic_e");
     emit_enum<error_e>(output, "error_e");
     emit_enum<font_registry_command_e>(output, "font_registry_command_e");
+    emit_enum<message_encoding_e>(output, "message_encoding_e");
     EMIT_TYPE(settings_option_s);
     EMIT_TYPE(frame_rate_s);
     output << "export type vec2_t = [number, number];\n\n"
@@ -230,6 +240,13 @@ std::string generate_typescript()
     EMIT_NAMESPACED_TYPE(web_message, add_connection_command_s);
     EMIT_NAMESPACED_TYPE(web_message, remove_connection_command_s);
     EMIT_NAMESPACED_TYPE(web_message, node_status_command_s);
+    output << "export type config_change_t =\n"
+              "  | add_node_command_s\n"
+              "  | remove_node_command_s\n"
+              "  | update_node_command_s\n"
+              "  | add_connection_command_s\n"
+              "  | remove_connection_command_s;\n\n";
+    EMIT_NAMESPACED_TYPE(web_message, config_changes_s);
     EMIT_NAMESPACED_TYPE(gpu, rect_s);
 
 #define STATUS_CONTRACT(type) status_contract_s<status::type>{#type}
@@ -244,8 +261,12 @@ std::string generate_typescript()
                           STATUS_CONTRACT(application_frame_status_s),
                           STATUS_CONTRACT(application_lifecycle_status_s),
                           STATUS_CONTRACT(application_scheduler_status_s),
+                          STATUS_CONTRACT(application_autosave_status_s),
+                          STATUS_CONTRACT(application_gpu_memory_status_s),
+                          STATUS_CONTRACT(gpu_memory_status_s),
                           STATUS_CONTRACT(render_delay_test_status_s),
                           STATUS_CONTRACT(source_timing_status_s),
+                          STATUS_CONTRACT(source_sync_status_s),
                           STATUS_CONTRACT(decklink_input_device_status_s),
                           STATUS_CONTRACT(decklink_output_device_status_s),
                           STATUS_CONTRACT(decklink_output_keyer_status_s),
@@ -2,6 +2,7 @@
 #include "action.hpp"
 #include "connection.hpp"
 #include "error.hpp"
+#include "message_encoding.hpp"
 #include "topic.hpp"
 
 #include <boost/describe.hpp>
@@ -41,6 +42,7 @@ BOOST_DESCRIBE_ENUM(error_e,
                     not_found,
                     circular_connection)
 BOOST_DESCRIBE_ENUM(font_registry_command_e, refresh)
+BOOST_DESCRIBE_ENUM(message_encoding_e, json, msgpack)
 
 } // namespace miximus
 
@@ -79,6 +81,14 @@ struct config_s
     std::optional<node_status_map_t> status{};
 };
 
+// What a reconnecting client missed: the logged commands, in order, followed
+// by the current status of every node whose status changed.
+struct config_changes_s
+{
+    std::vector<nlohmann::json> commands;
+    node_status_map_t           status;
+};
+
 struct ping_response_s
 {
     static constexpr action_e action = action_e::ping;
@@ -90,8 +100,9 @@ struct socket_info_s
 {
     static constexpr action_e action = action_e::socket_info;
 
-    int64_t     id{};
-    std::string bundle_hash;
+    int64_t            id{};
+    std::string        bundle_hash;
+    message_encoding_e encoding{};
 };
 
 struct result_s
@@ -106,7 +117,13 @@ struct config_result_s
     static constexpr action_e action = action_e::result;
 
     std::string token;
-    config_s    config;
+    std::string log_id;
+    uint64_t    version{};
+
+    // Exactly one is set: the changes since the versions in the request, or a
+    // full snapshot when the change log no longer covers them.
+    std::optional<config_s>         config{};
+    std::optional<config_changes_s> changes{};
 };
 
 struct node_status_result_s
@@ -134,6 +151,7 @@ struct add_node_command_s
 
     std::optional<int64_t>     origin_id{};
     std::optional<std::string> origin_token{};
+    uint64_t                   version{};
     node_s                     node;
 };
 
@@ -144,6 +162,7 @@ struct remove_node_command_s
 
     std::optional<int64_t>     origin_id{};
     std::optional<std::string> origin_token{};
+    uint64_t                   version{};
     std::string                id;
 };
 
@@ -154,6 +173,7 @@ struct update_node_command_s
 
     std::optional<int64_t>     origin_id{};
     std::optional<std::string> origin_token{};
+    uint64_t                   version{};
     std::string                id;
     nlohmann::json             options;
     bool                       has_corrected_values{};
@@ -166,6 +186,7 @@ struct add_connection_command_s
 
     std::optional<int64_t>     origin_id{};
     std::optional<std::string> origin_token{};
+    uint64_t                   version{};
     connection_s               connection;
 };
 
@@ -176,33 +197,36 @@ struct remove_connection_command_s
 
     std::optional<int64_t>     origin_id{};
     std::optional<std::string> origin_token{};
+    uint64_t                   version{};
     connection_s               connection;
 };
 
+// Status deltas of every node that changed during one tick, keyed by node id.
 struct node_status_command_s
 {
     static constexpr action_e action = action_e::command;
     static constexpr topic_e  topic  = topic_e::node_status;
 
-    std::string    id;
-    nlohmann::json status;
+    uint64_t       version{};
+    nlohmann::json statuses;
 };
 
 BOOST_DESCRIBE_STRUCT(message_s, (), (action, token))
 BOOST_DESCRIBE_STRUCT(command_s, (), (action, token, topic, origin_id, origin_token))
 BOOST_DESCRIBE_STRUCT(node_s, (), (type, id, schema_version, options))
 BOOST_DESCRIBE_STRUCT(config_s, (), (schema_version, nodes, connections, status))
+BOOST_DESCRIBE_STRUCT(config_changes_s, (), (commands, status))
 BOOST_DESCRIBE_STRUCT(ping_response_s, (), (response))
-BOOST_DESCRIBE_STRUCT(socket_info_s, (), (id, bundle_hash))
+BOOST_DESCRIBE_STRUCT(socket_info_s, (), (id, bundle_hash, encoding))
 BOOST_DESCRIBE_STRUCT(result_s, (), (token))
-BOOST_DESCRIBE_STRUCT(config_result_s, (), (token, config))
+BOOST_DESCRIBE_STRUCT(config_result_s, (), (token, log_id, version, config, changes))
 BOOST_DESCRIBE_STRUCT(node_status_result_s, (), (token, id, status))
 BOOST_DESCRIBE_STRUCT(error_s, (), (token, error, message))
-BOOST_DESCRIBE_STRUCT(add_node_command_s, (), (origin_id, origin_token, node))
-BOOST_DESCRIBE_STRUCT(remove_node_command_s, (), (origin_id, origin_token, id))
-BOOST_DESCRIBE_STRUCT(update_node_command_s, (), (origin_id, origin_token, id, options, has_corrected_values))
-BOOST_DESCRIBE_STRUCT(add_connection_command_s, (), (origin_id, origin_token, connection))
-BOOST_DESCRIBE_STRUCT(remove_connection_command_s, (), (origin_id, origin_token, connection))
-BOOST_DESCRIBE_STRUCT(node_status_command_s, (), (id, status))
+BOOST_DESCRIBE_STRUCT(add_node_command_s, (), (origin_id, origin_token, version, node))
+BOOST_DESCRIBE_STRUCT(remove_node_command_s, (), (origin_id, origin_token, version, id))
+BOOST_DESCRIBE_STRUCT(update_node_command_s, (), (origin_id, origin_token, version, id, options, has_corrected_values))
+BOOST_DESCRIBE_STRUCT(add_connection_command_s, (), (origin_id, origin_token, version, connection))
+BOOST_DESCRIBE_STRUCT(remove_connection_command_s, (), (origin_id, origin_token, version, connection))
+BOOST_DESCRIBE_STRUCT(node_status_command_s, (), (version, statuses))
 
 } // namespace miximus::web_message
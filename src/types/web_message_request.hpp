@@ -1,8 +1,10 @@
 #pragma once
 #include "web_message.hpp"
 
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace miximus::web_message {
 
@@ -10,8 +12,16 @@ struct subscribe_request_s
 {
     static constexpr action_e action = action_e::subscribe;
 
-    std::optional<std::string> token;
-    topic_e                    topic{};
+    std::optional<std::string>              token;
+    topic_e                                 topic{};
+    // Node status only: minimum time between frames sent to this connection.
+    // Deltas arriving in between are coalesced into the next frame.
+    std::optional<uint32_t>                 min_interval_ms{};
+    // Node status only: restrict frames to these node ids or node types, and
+    // to these status fields. Omitted or empty lists do not filter.
+    std::optional<std::vector<std::string>> node_ids{};
+    std::optional<std::vector<std::string>> node_types{};
+    std::optional<std::vector<std::string>> fields{};
 };
 
 struct unsubscribe_request_s
@@ -84,6 +94,12 @@ struct config_request_s
     static constexpr topic_e  topic  = topic_e::config;
 
     std::optional<std::string> token;
+
+    // Last versions seen from the change log `log_id`, for a reconnecting
+    // client to receive only what it missed
+    std::optional<std::string> log_id;
+    std::optional<uint64_t>    since_version;
+    std::optional<uint64_t>    since_status_version;
 };
 
 struct node_status_request_s
@@ -95,7 +111,7 @@ struct node_status_request_s
     std::string                id;
 };
 
-BOOST_DESCRIBE_STRUCT(subscribe_request_s, (), (token, topic))
+BOOST_DESCRIBE_STRUCT(subscribe_request_s, (), (token, topic, min_interval_ms, node_ids, node_types, fields))
 BOOST_DESCRIBE_STRUCT(unsubscribe_request_s, (), (token, topic))
 BOOST_DESCRIBE_STRUCT(add_node_request_s, (), (token, type, options))
 BOOST_DESCRIBE_STRUCT(remove_node_request_s, (), (token, id))
@@ -103,7 +119,7 @@ BOOST_DESCRIBE_STRUCT(update_node_request_s, (), (token, id, options))
 BOOST_DESCRIBE_STRUCT(add_connection_request_s, (), (token, connection))
 BOOST_DESCRIBE_STRUCT(remove_connection_request_s, (), (token, connection))
 BOOST_DESCRIBE_STRUCT(font_registry_request_s, (), (token, command))
-BOOST_DESCRIBE_STRUCT(config_request_s, (), (token))
+BOOST_DESCRIBE_STRUCT(config_request_s, (), (token, log_id, since_version, since_status_version))
 BOOST_DESCRIBE_STRUCT(node_status_request_s, (), (token, id))
 
 } // namespace miximus::web_message
@@ -30,4 +30,11 @@ inline std::string path_to_generic_utf8(const std::filesystem::path& value)
     return result;
 }
 
+/**
+ * Flush the contents of the file at `path` from the OS cache to the storage
+ * device, false when that fails. On POSIX systems `path` may also be a
+ * directory, which makes renames inside it durable.
+ */
+bool sync_to_disk(const std::filesystem::path& path);
+
 } // namespace miximus::utils
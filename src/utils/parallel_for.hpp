@@ -0,0 +1,73 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miximus::utils {
+
+/**
+ * Call fn(i) for every i in [0, count), spread over up to one thread per core
+ * including the calling thread. Meant for one-off bulk work like loading a
+ * show file, not for the frame loop.
+ *
+ * Indices are claimed in increasing order and no new ones are started after a
+ * failure, so the exception rethrown is the one from the lowest failing index,
+ * the same error a sequential loop would have stopped at.
+ */
+template <typename Fn>
+void parallel_for(size_t count, Fn&& fn)
+{
+    const size_t thread_count = std::min<size_t>(count, std::max(std::thread::hardware_concurrency(), 1U));
+    if (thread_count <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic_size_t next{0};
+    std::atomic_bool   failed{false};
+    std::mutex         error_mutex;
+    std::exception_ptr error;
+    size_t             error_index = std::numeric_limits<size_t>::max();
+
+    auto worker = [&] {
+        while (!failed.load(std::memory_order_relaxed)) {
+            const auto i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count) {
+                return;
+            }
+
+            try {
+                fn(i);
+            } catch (...) {
+                std::scoped_lock lock(error_mutex);
+                if (i < error_index) {
+                    error_index = i;
+                    error       = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(thread_count - 1);
+        for (size_t i = 1; i < thread_count; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace miximus::utils
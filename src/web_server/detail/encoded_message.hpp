@@ -0,0 +1,51 @@
+#pragma once
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace miximus::web_server::detail {
+
+// A message being sent to one or more connections. Each wire format is
+// produced on first use, so a broadcast serializes at most once per encoding
+// no matter how many subscribers share it.
+class encoded_message_s
+{
+    // Non-owning; the message outlives every send it is used for.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    const nlohmann::json&               message_;
+    std::optional<std::string>          text_;
+    std::optional<std::vector<uint8_t>> msgpack_;
+
+  public:
+    explicit encoded_message_s(const nlohmann::json& message)
+        : message_(message)
+    {
+    }
+
+    encoded_message_s(const encoded_message_s&)            = delete;
+    encoded_message_s(encoded_message_s&&)                 = delete;
+    encoded_message_s& operator=(const encoded_message_s&) = delete;
+    encoded_message_s& operator=(encoded_message_s&&)      = delete;
+    ~encoded_message_s()                                   = default;
+
+    const std::string& text()
+    {
+        if (!text_.has_value()) {
+            text_ = message_.dump();
+        }
+        return *text_;
+    }
+
+    const std::vector<uint8_t>& msgpack()
+    {
+        if (!msgpack_.has_value()) {
+            msgpack_ = nlohmann::json::to_msgpack(message_);
+        }
+        return *msgpack_;
+    }
+};
+
+} // namespace miximus::web_server::detail
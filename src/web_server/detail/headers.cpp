@@ -2,11 +2,13 @@
 
 #include "utils/string_view.hpp"
 
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <format>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -51,8 +53,32 @@ std::optional<int> parse_quality(std::string_view value) noexcept
 struct encoding_quality_s
 {
     std::optional<int> gzip;
+    std::optional<int> br;
+    std::optional<int> zstd;
     std::optional<int> identity;
     std::optional<int> wildcard;
+
+    int get(miximus::web_server::detail::content_encoding_e encoding) const noexcept
+    {
+        using miximus::web_server::detail::content_encoding_e;
+
+        std::optional<int> value;
+        switch (encoding) {
+            case content_encoding_e::gzip:
+                value = gzip;
+                break;
+            case content_encoding_e::br:
+                value = br;
+                break;
+            case content_encoding_e::zstd:
+                value = zstd;
+                break;
+            case content_encoding_e::identity:
+            case content_encoding_e::not_acceptable:
+                return 0;
+        }
+        return value.value_or(wildcard.value_or(0));
+    }
 };
 
 encoding_quality_s parse_accept_encoding(std::string_view header) noexcept
@@ -91,6 +117,10 @@ encoding_quality_s parse_accept_encoding(std::string_view header) noexcept
         std::optional<int>* destination = nullptr;
         if (miximus::utils::ascii_ieq_view(token, "gzip") || miximus::utils::ascii_ieq_view(token, "x-gzip")) {
             destination = &quality.gzip;
+        } else if (miximus::utils::ascii_ieq_view(token, "br")) {
+            destination = &quality.br;
+        } else if (miximus::utils::ascii_ieq_view(token, "zstd")) {
+            destination = &quality.zstd;
         } else if (miximus::utils::ascii_ieq_view(token, "identity")) {
             destination = &quality.identity;
         } else if (token == "*") {
@@ -118,18 +148,28 @@ std::string_view strip_weak_prefix(std::string_view etag) noexcept
 
 namespace miximus::web_server::detail {
 
-content_encoding_e select_content_encoding(std::string_view header) noexcept
+content_encoding_e select_content_encoding(std::string_view                     header,
+                                           std::span<const content_encoding_e> available) noexcept
 {
     if (header.empty()) {
         return content_encoding_e::identity;
     }
 
     const auto quality          = parse_accept_encoding(header);
-    const int  gzip_quality     = quality.gzip.value_or(quality.wildcard.value_or(0));
     const int  identity_quality = quality.identity.value_or(quality.wildcard == 0 ? 0 : QUALITY_MAX);
 
-    if (gzip_quality > 0 && gzip_quality >= identity_quality) {
-        return content_encoding_e::gzip;
+    auto best_encoding = content_encoding_e::identity;
+    int  best_quality  = 0;
+    for (const auto encoding : available) {
+        const int encoding_quality = quality.get(encoding);
+        if (encoding_quality > best_quality) {
+            best_encoding = encoding;
+            best_quality  = encoding_quality;
+        }
+    }
+
+    if (best_quality > 0 && best_quality >= identity_quality) {
+        return best_encoding;
     }
     if (identity_quality > 0) {
         return content_encoding_e::identity;
@@ -186,18 +226,28 @@ int tests() noexcept
 {
     using namespace miximus::web_server::detail;
 
-    assert(select_content_encoding("") == content_encoding_e::identity);
-    assert(select_content_encoding("gzip") == content_encoding_e::gzip);
-    assert(select_content_encoding("gzip;q=0") == content_encoding_e::identity);
-    assert(select_content_encoding("gzip;q=0.5") == content_encoding_e::identity);
-    assert(select_content_encoding("gzip;q=1, identity;q=0.5") == content_encoding_e::gzip);
-    assert(select_content_encoding("*;q=1") == content_encoding_e::gzip);
-    assert(select_content_encoding("*;q=0") == content_encoding_e::not_acceptable);
-    assert(select_content_encoding("gzip;q=0, identity;q=0") == content_encoding_e::not_acceptable);
-    assert(select_content_encoding("gzip;q=1.2") == content_encoding_e::identity);
-    assert(select_content_encoding("gzip;q=abc") == content_encoding_e::identity);
-    assert(select_content_encoding("gzip;q=1.0000") == content_encoding_e::identity);
-    assert(select_content_encoding("gzip;q=0, *;q=1") == content_encoding_e::identity);
+    constexpr std::array gzip_only{content_encoding_e::gzip};
+    constexpr std::array all{content_encoding_e::br, content_encoding_e::zstd, content_encoding_e::gzip};
+
+    assert(select_content_encoding("", gzip_only) == content_encoding_e::identity);
+    assert(select_content_encoding("gzip", gzip_only) == content_encoding_e::gzip);
+    assert(select_content_encoding("gzip;q=0", gzip_only) == content_encoding_e::identity);
+    assert(select_content_encoding("gzip;q=0.5", gzip_only) == content_encoding_e::identity);
+    assert(select_content_encoding("gzip;q=1, identity;q=0.5", gzip_only) == content_encoding_e::gzip);
+    assert(select_content_encoding("*;q=1", gzip_only) == content_encoding_e::gzip);
+    assert(select_content_encoding("*;q=0", gzip_only) == content_encoding_e::not_acceptable);
+    assert(select_content_encoding("gzip;q=0, identity;q=0", gzip_only) == content_encoding_e::not_acceptable);
+    assert(select_content_encoding("gzip;q=1.2", gzip_only) == content_encoding_e::identity);
+    assert(select_content_encoding("gzip;q=abc", gzip_only) == content_encoding_e::identity);
+    assert(select_content_encoding("gzip;q=1.0000", gzip_only) == content_encoding_e::identity);
+    assert(select_content_encoding("gzip;q=0, *;q=1", gzip_only) == content_encoding_e::identity);
+    assert(select_content_encoding("br", gzip_only) == content_encoding_e::identity);
+
+    assert(select_content_encoding("gzip, deflate, br, zstd", all) == content_encoding_e::br);
+    assert(select_content_encoding("gzip, zstd", all) == content_encoding_e::zstd);
+    assert(select_content_encoding("br;q=0.5, gzip", all) == content_encoding_e::gzip);
+    assert(select_content_encoding("*", all) == content_encoding_e::br);
+    assert(select_content_encoding("br;q=0, *", all) == content_encoding_e::zstd);
 
     assert(if_none_match_matches("\"one\"", "\"one\""));
     assert(if_none_match_matches("W/\"one\"", "\"one\""));
@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -8,10 +9,15 @@ enum class content_encoding_e
 {
     identity,
     gzip,
+    br,
+    zstd,
     not_acceptable,
 };
 
-content_encoding_e select_content_encoding(std::string_view header) noexcept;
+// `available` lists the compressed variants of the resource in the order the
+// server prefers them; it is used to break ties between equal client qualities
+content_encoding_e select_content_encoding(std::string_view                     header,
+                                           std::span<const content_encoding_e> available) noexcept;
 bool               if_none_match_matches(std::string_view header, std::string_view etag) noexcept;
 std::string        make_http_date();
 
@@ -3,6 +3,7 @@
 #include "web_server/detail/server_impl.hpp"
 #include "web_server/payload_parse.hpp"
 
+#include <boost/asio/post.hpp>
 #include <boost/url/segments_view.hpp>
 #include <nlohmann/json.hpp>
 
@@ -192,20 +193,21 @@ void web_server_impl::handle_api_node_request(const server_t::connection_ptr& co
 
 void web_server_impl::handle_api_v1_get_node(const server_t::connection_ptr& connection, std::string_view id) const
 {
-    handle_keyed_json_get(connection, config_getters_.node, id, "Node config");
+    handle_keyed_json_get(connection, get_config_getters().node, id, "Node config");
 }
 
 void web_server_impl::handle_api_v1_get_node_status(const server_t::connection_ptr& connection,
                                                     std::string_view                id) const
 {
-    handle_keyed_json_get(connection, config_getters_.node_status, id, "Node status");
+    handle_keyed_json_get(connection, get_config_getters().node_status, id, "Node status");
 }
 
 void web_server_impl::handle_api_v1_get_config(const server_t::connection_ptr& connection) const
 {
     using namespace websocketpp::http;
 
-    if (!config_getters_.node_config) {
+    const auto getter = get_config_getters().node_config;
+    if (!getter) {
         const web_message::error_s error{
             .token   = "",
             .error   = error_e::internal_error,
@@ -217,7 +219,7 @@ void web_server_impl::handle_api_v1_get_config(const server_t::connection_ptr& c
     }
 
     try {
-        const nlohmann::json config = config_getters_.node_config();
+        const nlohmann::json config = getter();
         connection->set_body(config.dump());
         connection->set_status(status_code::ok);
     } catch (const std::exception& error) {
@@ -235,7 +237,8 @@ void web_server_impl::handle_api_v1_get_status(const server_t::connection_ptr& c
 {
     using namespace websocketpp::http;
 
-    if (!config_getters_.node_statuses) {
+    const auto getter = get_config_getters().node_statuses;
+    if (!getter) {
         const web_message::error_s error{
             .token   = "",
             .error   = error_e::internal_error,
@@ -247,7 +250,7 @@ void web_server_impl::handle_api_v1_get_status(const server_t::connection_ptr& c
     }
 
     try {
-        connection->set_body(config_getters_.node_statuses().dump());
+        connection->set_body(getter().dump());
         connection->set_status(status_code::ok);
     } catch (const std::exception& error) {
         const web_message::error_s payload{
@@ -321,7 +324,17 @@ void web_server_impl::handle_api_v1_post_control(const server_t::connection_ptr&
         return;
     }
 
-    const auto error_code = handle_user_command(std::move(doc), -1);
+    // The response is deferred until the command has run on the command
+    // executor, then sent on the strand, which stop() drains before the
+    // transport threads exit so no request is left without a reply
+    connection->defer_http_response();
+    const auto error_code = handle_user_command(std::move(doc), -1, [this, connection] {
+        boost::asio::post(strand_, [connection] {
+            connection->remove_header("Content-Type");
+            connection->set_status(websocketpp::http::status_code::no_content);
+            connection->send_http_response();
+        });
+    });
     if (error_code != error_e::no_error) {
         const bool invalid_topic = error_code == error_e::invalid_topic;
         connection->set_status(invalid_topic ? status_code::bad_request : status_code::service_unavailable);
@@ -332,11 +345,8 @@ void web_server_impl::handle_api_v1_post_control(const server_t::connection_ptr&
                                .message = invalid_topic ? "Invalid topic" : "Topic service not available",
                            })
                 .dump());
-        return;
+        connection->send_http_response();
     }
-
-    connection->remove_header("Content-Type");
-    connection->set_status(status_code::no_content);
 }
 
 } // namespace miximus::web_server::detail
@@ -8,8 +8,12 @@
 #include <boost/url/segments_view.hpp>
 #include <boost/url/url_view.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <format>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -54,6 +58,32 @@ std::string make_decoded_path(boost::urls::segments_view segments)
     return path.empty() ? "/" : path;
 }
 
+struct encoded_file_s
+{
+    std::span<const uint8_t> data;
+    std::string_view         hash;
+    std::string_view         name; // Content-Encoding header value
+};
+
+encoded_file_s get_encoded_file(const miximus::static_files::file_record_s&     file,
+                                miximus::web_server::detail::content_encoding_e encoding)
+{
+    using miximus::web_server::detail::content_encoding_e;
+
+    switch (encoding) {
+        case content_encoding_e::gzip:
+            return {.data = file.gzipped, .hash = file.gzip_hash, .name = "gzip"};
+        case content_encoding_e::br:
+            return {.data = file.brotli, .hash = file.brotli_hash, .name = "br"};
+        case content_encoding_e::zstd:
+            return {.data = file.zstd, .hash = file.zstd_hash, .name = "zstd"};
+        case content_encoding_e::identity:
+        case content_encoding_e::not_acceptable:
+            break;
+    }
+    return {};
+}
+
 } // namespace
 
 namespace miximus::web_server::detail {
@@ -154,7 +184,19 @@ void web_server_impl::serve_static_file(const server_t::connection_ptr& connecti
         return;
     }
 
-    const auto encoding = select_content_encoding(connection->get_request_header("Accept-Encoding"));
+    // Compressed variants in the order preferred when a client accepts several equally
+    std::array<content_encoding_e, 3> available{};
+    size_t                            available_count = 0;
+    if (!file->brotli.empty()) {
+        available.at(available_count++) = content_encoding_e::br;
+    }
+    if (!file->zstd.empty()) {
+        available.at(available_count++) = content_encoding_e::zstd;
+    }
+    available.at(available_count++) = content_encoding_e::gzip;
+
+    const auto encoding = select_content_encoding(connection->get_request_header("Accept-Encoding"),
+                                                  std::span(available).first(available_count));
     connection->replace_header("Vary", "Accept-Encoding");
 
     if (encoding == content_encoding_e::not_acceptable) {
@@ -165,8 +207,9 @@ void web_server_impl::serve_static_file(const server_t::connection_ptr& connecti
         return;
     }
 
-    const bool use_gzip = encoding == content_encoding_e::gzip;
-    const auto etag     = std::format("\"{}\"", use_gzip ? file->gzip_hash : file->identity_hash);
+    const bool use_identity = encoding == content_encoding_e::identity;
+    const auto encoded      = get_encoded_file(*file, encoding);
+    const auto etag         = std::format("\"{}\"", use_identity ? file->identity_hash : encoded.hash);
 
     connection->replace_header("ETag", etag);
     connection->replace_header("Cache-Control", "no-cache");
@@ -177,17 +220,17 @@ void web_server_impl::serve_static_file(const server_t::connection_ptr& connecti
         return;
     }
 
-    const auto content_size = use_gzip ? file->gzipped.size() : file->size;
-    if (use_gzip) {
-        connection->replace_header("Content-Encoding", "gzip");
+    if (!use_identity) {
+        connection->replace_header("Content-Encoding", std::string(encoded.name));
     }
 
+    // Pre-compressed variants are served straight from the bundled data
     if (method == HTTP_HEAD) {
-        connection->replace_header("Content-Length", std::to_string(content_size));
-    } else if (use_gzip) {
-        connection->set_body(std::string(reinterpret_cast<const char*>(file->gzipped.data()), content_size));
+        connection->replace_header("Content-Length", std::to_string(use_identity ? file->size : encoded.data.size()));
+    } else if (use_identity) {
+        connection->set_body(std::string(file->contents()));
     } else {
-        connection->set_body(file->unzip());
+        connection->set_body(std::string(reinterpret_cast<const char*>(encoded.data.data()), encoded.data.size()));
     }
 
     connection->replace_header("Content-Type", std::string(file->mime));
@@ -1,19 +1,44 @@
 #include "web_server/detail/server_impl.hpp"
 
+#include "types/web_message_json.hpp"
 #include "web_server/payload_parse.hpp"
 
 #include <boost/asio/post.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <format>
 #include <functional>
 #include <future>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <utility>
 
 namespace miximus::web_server::detail {
+namespace {
+
+// Above this many bytes queued on a socket, status deltas are held back and
+// coalesced instead of adding to the backlog of a client that cannot keep up
+constexpr size_t                    MAX_STATUS_BACKLOG_BYTES = 256 * 1024;
+constexpr std::chrono::milliseconds STATUS_BACKLOG_RETRY_INTERVAL{50};
+
+// Later deltas win field by field, the same way the client applies them.
+void merge_statuses(nlohmann::json& pending, const nlohmann::json& statuses)
+{
+    for (const auto& [id, delta] : statuses.items()) {
+        auto& node_pending = pending[id];
+        for (const auto& [name, value] : delta.items()) {
+            node_pending[name] = value;
+        }
+    }
+}
+
+} // namespace
 
 web_server_impl::web_server_impl()
 {
@@ -31,29 +56,36 @@ web_server_impl::web_server_impl()
     endpoint_.set_message_handler(std::bind_front(&web_server_impl::on_message, this));
 }
 
+web_server_impl::~web_server_impl()
+{
+    // Only reached with running threads when stop() was never called
+    io_context_.stop();
+    io_threads_.clear();
+}
+
 void web_server_impl::subscribe(topic_e topic, const callback_t& callback)
 {
-    if (!started_) {
-        throw std::logic_error("web_server: subscribe() called before start()");
-    }
-    boost::asio::post(endpoint_.get_io_context(),
-                      [this, topic, callback]() { get_subscription_by_topic(topic) = callback; });
+    const std::scoped_lock lock(handlers_mutex_);
+    subscription_by_topic_[enum_index(topic)] = callback; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
 }
 
 void web_server_impl::set_config_getters(const config_getters_t& getters)
 {
-    if (!started_) {
-        throw std::logic_error("web_server: set_config_getters() called before start()");
-    }
-    boost::asio::post(endpoint_.get_io_context(), [this, getters]() { config_getters_ = getters; });
+    const std::scoped_lock lock(handlers_mutex_);
+    config_getters_ = getters;
 }
 
-void web_server_impl::start(uint16_t port, boost::asio::io_context* service)
+void web_server_impl::start(uint16_t port, boost::asio::io_context* command_executor, size_t io_threads)
 {
     using namespace websocketpp::log;
 
+    if (started_) {
+        throw std::logic_error("web_server: start() called twice");
+    }
+    command_executor_ = command_executor;
+
     std::error_code ec;
-    endpoint_.init_asio(service, ec);
+    endpoint_.init_asio(&io_context_, ec);
     if (ec) {
         throw std::runtime_error(std::format("web_server: init_asio failed: {}", ec.message()));
     }
@@ -72,7 +104,16 @@ void web_server_impl::start(uint16_t port, boost::asio::io_context* service)
         throw std::runtime_error(std::format("web_server: start_accept failed: {}", ec.message()));
     }
 
-    endpoint_.get_alog().write(alevel::app, std::format("Web server listening on port {}", port));
+    status_timer_.emplace(strand_);
+
+    io_threads = std::max<size_t>(io_threads, 1);
+    io_threads_.reserve(io_threads);
+    for (size_t i = 0; i < io_threads; ++i) {
+        io_threads_.emplace_back([this] { io_context_.run(); });
+    }
+
+    endpoint_.get_alog().write(alevel::app,
+                               std::format("Web server listening on port {} with {} I/O threads", port, io_threads));
     started_ = true;
 }
 
@@ -91,8 +132,9 @@ void web_server_impl::stop()
     std::promise<void> done;
     auto               future = done.get_future();
 
-    boost::asio::post(endpoint_.get_io_context(), [this, p = std::move(done)]() mutable {
+    boost::asio::post(strand_, [this, p = std::move(done)]() mutable {
         endpoint_.stop_listening();
+        status_timer_->cancel();
 
         // Suppress expected teardown noise: canceled async ops on connections
         // being closed. Safe after stop_listening() — no new external failures
@@ -115,21 +157,32 @@ void web_server_impl::stop()
     });
 
     future.wait();
-}
 
-void web_server_impl::send_message(const nlohmann::json& msg, int64_t connection_id)
-{
-    boost::asio::post(endpoint_.get_io_context(), [this, serialized = msg.dump(), connection_id]() {
-        send_message_sync(serialized, connection_id);
-    });
+    // Commands received before the connections closed may still be queued on
+    // the command executor, and they use the subscribers removed after stop()
+    std::promise<void> drained;
+    boost::asio::post(*command_executor_, [&drained] { drained.set_value(); });
+    drained.get_future().wait();
+
+    // Those commands post their deferred HTTP responses to the strand, send
+    // them before the I/O context stops
+    std::promise<void> responded;
+    boost::asio::post(strand_, [&responded] { responded.set_value(); });
+    responded.get_future().wait();
+
+    io_context_.stop();
+    io_threads_.clear();
+    started_ = false;
 }
 
-void web_server_impl::send_message_sync(const nlohmann::json& msg, int64_t connection_id)
+// The message is moved to the strand rather than serialized on the calling
+// thread, since the wire format depends on the receiving connection.
+void web_server_impl::send_message(nlohmann::json msg, int64_t connection_id)
 {
-    send_message_sync(msg.dump(), connection_id);
+    boost::asio::post(strand_, [this, msg = std::move(msg), connection_id]() { deliver_message(msg, connection_id); });
 }
 
-void web_server_impl::send_message_sync(const std::string& msg, int64_t connection_id)
+void web_server_impl::deliver_message(const nlohmann::json& msg, int64_t connection_id)
 {
     auto hdl = connections_by_id_.find(connection_id);
     if (hdl == connections_by_id_.end()) {
@@ -141,32 +194,170 @@ void web_server_impl::send_message_sync(const std::string& msg, int64_t connecti
         return;
     }
 
-    send(hdl->second, msg);
+    encoded_message_s message(msg);
+    send(hdl->second, con->second.encoding, message);
 }
 
-void web_server_impl::broadcast_message(const nlohmann::json& msg)
+void web_server_impl::broadcast_message(nlohmann::json msg)
 {
     auto topic = get_topic_from_payload(msg);
     if (topic.has_value()) {
-        boost::asio::post(endpoint_.get_io_context(), [this, topic = *topic, serialized = msg.dump()]() {
-            broadcast_message_sync(topic, serialized);
-        });
+        boost::asio::post(strand_,
+                          [this, topic = *topic, msg = std::move(msg)]() { deliver_broadcast(topic, msg); });
     }
 }
 
-void web_server_impl::broadcast_message_sync(const nlohmann::json& msg)
+void web_server_impl::deliver_broadcast(topic_e topic, const nlohmann::json& msg)
 {
-    auto topic = get_topic_from_payload(msg);
-    if (topic.has_value()) {
-        broadcast_message_sync(*topic, msg.dump());
+    if (topic == topic_e::remove_node) {
+        if (const auto id = msg.find("id"); id != msg.end() && id->is_string()) {
+            if (auto type = node_types_.find(id->get_ref<const std::string&>()); type != node_types_.end()) {
+                node_types_.erase(type);
+            }
+        }
+    }
+
+    encoded_message_s message(msg);
+    for (const auto& hdl : get_connections_by_topic(topic)) {
+        if (auto connection = connections_.find(hdl); connection != connections_.end()) {
+            send(hdl, connection->second.encoding, message);
+        }
     }
 }
 
-void web_server_impl::broadcast_message_sync(topic_e topic, const std::string& msg)
+void web_server_impl::broadcast_node_statuses(std::shared_ptr<const nlohmann::json> statuses, uint64_t version)
 {
-    for (const auto& hdl : get_connections_by_topic(topic)) {
-        send(hdl, msg);
+    boost::asio::post(strand_, [this, statuses = std::move(statuses), version]() {
+        broadcast_node_statuses_sync(*statuses, version);
+    });
+}
+
+void web_server_impl::broadcast_node_statuses_sync(const nlohmann::json& statuses, uint64_t version)
+{
+    std::optional<nlohmann::json>    frame;
+    std::optional<encoded_message_s> message;
+    bool                             has_pending = false;
+
+    const auto node_type = [this](std::string_view id) { return get_node_type(id); };
+
+    for (const auto& hdl : get_connections_by_topic(topic_e::node_status)) {
+        auto connection = connections_.find(hdl);
+        if (connection == connections_.end()) {
+            continue;
+        }
+
+        auto& state = connection->second;
+
+        std::optional<nlohmann::json> filtered;
+        if (!state.status_filter.empty()) {
+            filtered = state.status_filter.apply(statuses, node_type);
+            if (filtered->is_null()) {
+                continue;
+            }
+        }
+
+        // Once deltas are pending, later ones queue behind them so they are
+        // never delivered out of order
+        if (state.status_interval.count() > 0 || !state.pending_statuses.is_null() || is_backlogged(hdl)) {
+            merge_statuses(state.pending_statuses, filtered.has_value() ? *filtered : statuses);
+            state.pending_status_version = version;
+            has_pending                  = true;
+            continue;
+        }
+
+        if (filtered.has_value()) {
+            const nlohmann::json own_frame =
+                web_message::node_status_command_s{.version = version, .statuses = std::move(*filtered)};
+            encoded_message_s own_message(own_frame);
+            send(hdl, state.encoding, own_message);
+            continue;
+        }
+
+        // Built lazily so a tick without unfiltered, immediate subscribers costs nothing
+        if (!message.has_value()) {
+            frame = web_message::node_status_command_s{.version = version, .statuses = statuses};
+            message.emplace(*frame);
+        }
+        send(hdl, state.encoding, *message);
     }
+
+    if (has_pending) {
+        flush_throttled_statuses();
+    }
+}
+
+void web_server_impl::flush_throttled_statuses()
+{
+    using clock_t = std::chrono::steady_clock;
+
+    const auto                         now = clock_t::now();
+    std::optional<clock_t::time_point> next_due;
+
+    const auto retry_at = [&next_due](clock_t::time_point at) {
+        next_due = next_due.has_value() ? std::min(*next_due, at) : at;
+    };
+
+    for (const auto& hdl : get_connections_by_topic(topic_e::node_status)) {
+        auto connection = connections_.find(hdl);
+        if (connection == connections_.end() || connection->second.pending_statuses.is_null()) {
+            continue;
+        }
+
+        auto& state = connection->second;
+        if (now < state.next_status) {
+            retry_at(state.next_status);
+            continue;
+        }
+        if (is_backlogged(hdl)) {
+            retry_at(now + STATUS_BACKLOG_RETRY_INTERVAL);
+            continue;
+        }
+
+        const nlohmann::json frame = web_message::node_status_command_s{
+            .version  = state.pending_status_version,
+            .statuses = std::move(state.pending_statuses),
+        };
+        encoded_message_s    message(frame);
+        send(hdl, state.encoding, message);
+        state.pending_statuses = nullptr;
+        state.next_status      = now + state.status_interval;
+    }
+
+    // Coalesced deltas must still go out when no further ticks report changes
+    if (next_due.has_value()) {
+        status_timer_->expires_at(*next_due);
+        status_timer_->async_wait([this](const boost::system::error_code& error) {
+            if (!error) {
+                flush_throttled_statuses();
+            }
+        });
+    }
+}
+
+bool web_server_impl::is_backlogged(const con_hdl_t& hdl)
+{
+    websocketpp::lib::error_code error;
+    const auto                   connection = endpoint_.get_con_from_hdl(hdl, error);
+    return !error && connection->get_buffered_amount() > MAX_STATUS_BACKLOG_BYTES;
+}
+
+std::optional<std::string_view> web_server_impl::get_node_type(std::string_view id)
+{
+    if (const auto type = node_types_.find(id); type != node_types_.end()) {
+        return type->second;
+    }
+
+    const auto getter = get_config_getters().node;
+    if (!getter) {
+        return std::nullopt;
+    }
+    const auto node = getter(id);
+    if (!node.has_value()) {
+        return std::nullopt;
+    }
+
+    // Types never change, so the lookup is cached until the node is removed
+    return node_types_.emplace(std::string(id), node->value("type", std::string())).first->second;
 }
 
 } // namespace miximus::web_server::detail
@@ -2,26 +2,43 @@
 #include "types/error.hpp"
 #include "utils/lookup.hpp"
 #include "web_server/detail/custom-config.hpp"
+#include "web_server/detail/encoded_message.hpp"
 #include "web_server/server.hpp"
 #include "websocket_connection.hpp"
 
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
 #include <websocketpp/common/asio.hpp>
 
 #include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 namespace boost::urls {
 class segments_view;
 }
 
 namespace miximus::web_server::detail {
+
+/**
+ * Websocketpp runs on io_context_ with one strand per connection, so handlers
+ * for different connections run in parallel on the transport threads. The
+ * connection bookkeeping and every outgoing message are serialized on strand_;
+ * subscription callbacks are posted to the command executor.
+ */
 class web_server_impl : public server_s
 {
     using server_t       = websocketpp::server<custom_config>;
@@ -32,6 +49,7 @@ class web_server_impl : public server_s
     using con_by_topic_t = std::array<con_set_t, enum_count<topic_e>()>;
     using sub_by_topic_t = std::array<callback_t, enum_count<topic_e>()>;
     using msg_ptr_t      = server_t::message_ptr;
+    using strand_t       = boost::asio::strand<boost::asio::io_context::executor_type>;
 
     void terminate_and_log(const con_hdl_t& hdl, const std::string& message);
 
@@ -50,51 +68,87 @@ class web_server_impl : public server_s
     void        handle_api_v1_get_node(const server_t::connection_ptr& con, std::string_view id) const;
     void        handle_api_v1_get_node_status(const server_t::connection_ptr& con, std::string_view id) const;
     void        handle_api_v1_post_control(const server_t::connection_ptr& con);
-    error_e     handle_user_command(nlohmann::json&& doc, int64_t connection_id);
+    void        handle_message(const con_hdl_t& hdl, nlohmann::json&& doc);
+    error_e     handle_user_command(nlohmann::json&& doc, int64_t connection_id, std::function<void()> on_done = {});
     void        on_message(const con_hdl_t& hdl, const msg_ptr_t& msg);
     void        on_open(const con_hdl_t& hdl);
     void        on_fail(const con_hdl_t& hdl);
     void        on_close(const con_hdl_t& hdl);
 
-    void send(const con_hdl_t& hdl, const std::string&);
+    message_encoding_e get_requested_encoding(const con_hdl_t& hdl);
+
+    void send(const con_hdl_t& hdl, message_encoding_e encoding, encoded_message_s& message);
     void send(const con_hdl_t& hdl, const nlohmann::json&);
 
-    callback_t& get_subscription_by_topic(topic_e t)
+    // Run on strand_
+    void deliver_message(const nlohmann::json& msg, int64_t connection_id);
+    void deliver_broadcast(topic_e topic, const nlohmann::json& msg);
+    void broadcast_node_statuses_sync(const nlohmann::json& statuses, uint64_t version);
+    void flush_throttled_statuses();
+    bool is_backlogged(const con_hdl_t& hdl);
+
+    std::optional<std::string_view> get_node_type(std::string_view id);
+
+    callback_t get_subscription_by_topic(topic_e t) const
     {
+        const std::scoped_lock lock(handlers_mutex_);
         return subscription_by_topic_[enum_index(t)];
     } // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    config_getters_t get_config_getters() const
+    {
+        const std::scoped_lock lock(handlers_mutex_);
+        return config_getters_;
+    }
     con_set_t& get_connections_by_topic(topic_e t)
     {
         return connections_by_topic_[enum_index(t)];
     } // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
 
-    server_t         endpoint_;
-    con_map_t        connections_;
-    con_by_id_t      connections_by_id_;
-    con_by_topic_t   connections_by_topic_;
-    sub_by_topic_t   subscription_by_topic_;
-    config_getters_t config_getters_;
+    boost::asio::io_context  io_context_;
+    strand_t                 strand_{boost::asio::make_strand(io_context_)};
+    boost::asio::io_context* command_executor_{};
+    server_t                 endpoint_;
+
+    // Owned by strand_
+    con_map_t      connections_;
+    con_by_id_t    connections_by_id_;
+    con_by_topic_t connections_by_topic_;
+
+    // Set from the main thread, read from the transport threads
+    mutable std::mutex handlers_mutex_;
+    sub_by_topic_t     subscription_by_topic_;
+    config_getters_t   config_getters_;
+
+    // Node type by id, for subscriptions filtering on types
+    std::map<std::string, std::string, std::less<>> node_types_;
+
+    std::optional<boost::asio::steady_timer> status_timer_;
 
     int64_t next_connection_id_ = 0;
     bool    started_            = false;
 
     std::optional<std::promise<void>> stop_promise_;
 
+    // Declared last so the transport threads are joined before anything they use is destroyed
+    std::vector<std::jthread> io_threads_;
+
   public:
     web_server_impl();
-    ~web_server_impl() = default;
+    ~web_server_impl() override;
+
+    web_server_impl(const web_server_impl&)            = delete;
+    web_server_impl(web_server_impl&&)                 = delete;
+    web_server_impl& operator=(const web_server_impl&) = delete;
+    web_server_impl& operator=(web_server_impl&&)      = delete;
 
     void subscribe(topic_e topic, const callback_t& callback) final;
     void set_config_getters(const config_getters_t& getters) final;
-    void start(uint16_t port, boost::asio::io_context* service) final;
+    void start(uint16_t port, boost::asio::io_context* command_executor, size_t io_threads) final;
     void stop() final;
 
-    void send_message(const nlohmann::json& msg, int64_t connection_id) final;
-    void send_message_sync(const nlohmann::json& msg, int64_t connection_id) final;
-    void send_message_sync(const std::string& msg, int64_t connection_id);
+    void send_message(nlohmann::json msg, int64_t connection_id) final;
+    void broadcast_message(nlohmann::json msg) final;
 
-    void broadcast_message(const nlohmann::json& msg) final;
-    void broadcast_message_sync(const nlohmann::json& msg) final;
-    void broadcast_message_sync(topic_e topic, const std::string& msg);
+    void broadcast_node_statuses(std::shared_ptr<const nlohmann::json> statuses, uint64_t version) final;
 };
 } // namespace miximus::web_server::detail
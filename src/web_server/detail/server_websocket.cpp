@@ -6,9 +6,13 @@
 #include "web_server/payload_parse.hpp"
 
 #include <boost/asio/post.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/url_view.hpp>
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <exception>
+#include <functional>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -28,40 +32,66 @@ void web_server_impl::terminate_and_log(const con_hdl_t& hdl, const std::string&
     }
 }
 
-error_e web_server_impl::handle_user_command(nlohmann::json&& doc, int64_t connection_id)
+// Commands run serialized on the command executor, so the transport threads
+// never wait on the node graph
+error_e web_server_impl::handle_user_command(nlohmann::json&& doc, int64_t connection_id, std::function<void()> on_done)
 {
     const auto topic = get_topic_from_payload(doc);
     if (!topic.has_value()) {
         return error_e::invalid_topic;
     }
 
-    const auto& subscription = get_subscription_by_topic(*topic);
+    auto subscription = get_subscription_by_topic(*topic);
     if (!subscription) {
         return error_e::internal_error;
     }
 
-    subscription(std::move(doc), connection_id);
+    boost::asio::post(*command_executor_,
+                      [subscription = std::move(subscription),
+                       doc          = std::move(doc),
+                       connection_id,
+                       on_done = std::move(on_done)]() mutable {
+                          subscription(std::move(doc), connection_id);
+                          if (on_done) {
+                              on_done();
+                          }
+                      });
     return error_e::no_error;
 }
 
+// Payloads are parsed on the connection's transport thread, in parallel with
+// other connections; the rest is handled on the strand.
 void web_server_impl::on_message(const con_hdl_t& hdl, const msg_ptr_t& msg)
 {
     using namespace websocketpp::frame;
 
-    auto connection = connections_.find(hdl);
-    if (connection == connections_.end()) {
-        terminate_and_log(hdl, "connection not found");
-        return;
+    // Clients may send either format regardless of the encoding they receive
+    nlohmann::json doc;
+    switch (msg->get_opcode()) {
+        case opcode::text:
+            doc = nlohmann::json::parse(msg->get_payload(), nullptr, false);
+            break;
+        case opcode::binary:
+            doc = nlohmann::json::from_msgpack(msg->get_payload(), true, false);
+            break;
+        default:
+            terminate_and_log(hdl, "only text and binary payloads are accepted");
+            return;
     }
 
-    if (msg->get_opcode() != opcode::text) {
-        terminate_and_log(hdl, "only text payloads are accepted");
+    if (doc.is_discarded() || !doc.is_object()) {
+        terminate_and_log(hdl, "invalid message payload");
         return;
     }
 
-    auto doc = nlohmann::json::parse(msg->get_payload(), nullptr, false);
-    if (doc.is_discarded() || !doc.is_object()) {
-        terminate_and_log(hdl, "invalid JSON payload");
+    boost::asio::post(strand_, [this, hdl, doc = std::move(doc)]() mutable { handle_message(hdl, std::move(doc)); });
+}
+
+void web_server_impl::handle_message(const con_hdl_t& hdl, nlohmann::json&& doc)
+{
+    auto connection = connections_.find(hdl);
+    if (connection == connections_.end()) {
+        terminate_and_log(hdl, "connection not found");
         return;
     }
 
@@ -88,6 +118,10 @@ void web_server_impl::on_message(const con_hdl_t& hdl, const msg_ptr_t& msg)
 
             connection->second.set_subscription(request.topic, true);
             get_connections_by_topic(request.topic).emplace(hdl);
+            if (request.topic == topic_e::node_status) {
+                connection->second.status_interval = std::chrono::milliseconds(request.min_interval_ms.value_or(0));
+                connection->second.status_filter   = status_filter_s(request.node_ids, request.node_types, request.fields);
+            }
             send(hdl, web_message::result_s{.token = token});
             break;
         }
@@ -109,6 +143,11 @@ void web_server_impl::on_message(const con_hdl_t& hdl, const msg_ptr_t& msg)
 
             connection->second.set_subscription(request.topic, false);
             get_connections_by_topic(request.topic).erase(hdl);
+            if (request.topic == topic_e::node_status) {
+                connection->second.status_interval  = {};
+                connection->second.status_filter    = {};
+                connection->second.pending_statuses = nullptr;
+            }
             send(hdl, web_message::result_s{.token = token});
             break;
         }
@@ -133,14 +172,22 @@ void web_server_impl::on_open(const con_hdl_t& hdl)
     using namespace websocketpp::log;
 
     endpoint_.get_alog().write(alevel::http, "Connection opened");
-    const auto id = next_connection_id_++;
-    connections_.emplace(hdl, websocket_connection{.id = id, .topics = {}});
-    connections_by_id_.emplace(id, hdl);
-    send(hdl,
-         web_message::socket_info_s{
-             .id          = id,
-             .bundle_hash = std::string(static_files::get_web_files().bundle_hash),
-         });
+    const auto encoding = get_requested_encoding(hdl);
+
+    boost::asio::post(strand_, [this, hdl, encoding]() {
+        const auto id = next_connection_id_++;
+        connections_.emplace(hdl, websocket_connection{.id = id, .topics = {}, .encoding = encoding});
+        connections_by_id_.emplace(id, hdl);
+
+        // Always sent as JSON text, it tells the client which encoding follows
+        const nlohmann::json info = web_message::socket_info_s{
+            .id          = id,
+            .bundle_hash = std::string(static_files::get_web_files().bundle_hash),
+            .encoding    = encoding,
+        };
+        encoded_message_s    message(info);
+        send(hdl, message_encoding_e::json, message);
+    });
 }
 
 void web_server_impl::on_fail(const con_hdl_t& hdl)
@@ -174,42 +221,80 @@ void web_server_impl::on_close(const con_hdl_t& hdl)
     using namespace websocketpp::log;
 
     endpoint_.get_alog().write(alevel::http, "Connection closed");
-    auto connection = connections_.find(hdl);
-    if (connection == connections_.end()) {
-        return;
-    }
 
-    for (const auto topic : magic_enum::enum_values<topic_e>()) {
-        if (connection->second.has_subscription(topic)) {
-            get_connections_by_topic(topic).erase(hdl);
+    boost::asio::post(strand_, [this, hdl]() {
+        auto connection = connections_.find(hdl);
+        if (connection == connections_.end()) {
+            return;
+        }
+
+        for (const auto topic : magic_enum::enum_values<topic_e>()) {
+            if (connection->second.has_subscription(topic)) {
+                get_connections_by_topic(topic).erase(hdl);
+            }
         }
-    }
 
-    connections_by_id_.erase(connection->second.id);
-    connections_.erase(connection);
+        connections_by_id_.erase(connection->second.id);
+        connections_.erase(connection);
+
+        if (connections_.empty() && stop_promise_.has_value()) {
+            // The close handler runs on the connection's own strand, possibly
+            // still in progress on another transport thread. Resolve the stop
+            // promise in a later Asio turn so destruction cannot race
+            // websocketpp's termination bookkeeping.
+            auto promise = std::move(*stop_promise_);
+            stop_promise_.reset();
+            boost::asio::post(io_context_, [promise = std::move(promise)]() mutable { promise.set_value(); });
+        }
+    });
+}
+
+message_encoding_e web_server_impl::get_requested_encoding(const con_hdl_t& hdl)
+{
+    websocketpp::lib::error_code error;
+    auto                         connection = endpoint_.get_con_from_hdl(hdl, error);
+    if (error) {
+        return message_encoding_e::json;
+    }
 
-    if (connections_.empty() && stop_promise_.has_value()) {
-        // The endpoint still uses itself after invoking this handler. Resolve
-        // the stop promise in the next Asio turn so destruction cannot race
-        // websocketpp's termination bookkeeping.
-        auto promise = std::move(*stop_promise_);
-        stop_promise_.reset();
-        boost::asio::post(endpoint_.get_io_context(),
-                          [promise = std::move(promise)]() mutable { promise.set_value(); });
+    // Negotiated in the upgrade request, e.g. ws://host:7351/?encoding=msgpack
+    const auto target = boost::urls::parse_relative_ref(connection->get_resource());
+    if (!target.has_value()) {
+        return message_encoding_e::json;
     }
+    const auto params = target->params();
+    const auto param  = params.find("encoding");
+    if (param == params.end() || !(*param).has_value) {
+        return message_encoding_e::json;
+    }
+    return message_encoding_from_string((*param).value).value_or(message_encoding_e::json);
 }
 
-void web_server_impl::send(const con_hdl_t& hdl, const std::string& message)
+void web_server_impl::send(const con_hdl_t& hdl, message_encoding_e encoding, encoded_message_s& message)
 {
     using namespace websocketpp::log;
 
     std::error_code error;
-    endpoint_.send(hdl, message, websocketpp::frame::opcode::text, error);
+    switch (encoding) {
+        case message_encoding_e::json:
+            endpoint_.send(hdl, message.text(), websocketpp::frame::opcode::text, error);
+            break;
+        case message_encoding_e::msgpack: {
+            const auto& payload = message.msgpack();
+            endpoint_.send(hdl, payload.data(), payload.size(), websocketpp::frame::opcode::binary, error);
+            break;
+        }
+    }
     if (error) {
         endpoint_.get_alog().write(alevel::fail, error.message());
     }
 }
 
-void web_server_impl::send(const con_hdl_t& hdl, const nlohmann::json& message) { send(hdl, message.dump()); }
+void web_server_impl::send(const con_hdl_t& hdl, const nlohmann::json& message)
+{
+    const auto        connection = connections_.find(hdl);
+    encoded_message_s encoded(message);
+    send(hdl, connection != connections_.end() ? connection->second.encoding : message_encoding_e::json, encoded);
+}
 
 } // namespace miximus::web_server::detail
@@ -0,0 +1,86 @@
+#pragma once
+#include <nlohmann/json.hpp>
+
+#include <functional>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miximus::web_server::detail {
+
+// Which node status deltas a subscriber receives. A node passes when it is
+// listed in node_ids or its type is listed in node_types; with both empty
+// every node passes. A non-empty fields list drops all other status fields.
+struct status_filter_s
+{
+    using name_set_t = std::set<std::string, std::less<>>;
+
+    name_set_t node_ids;
+    name_set_t node_types;
+    name_set_t fields;
+
+    status_filter_s() = default;
+
+    status_filter_s(const std::optional<std::vector<std::string>>& ids,
+                    const std::optional<std::vector<std::string>>& types,
+                    const std::optional<std::vector<std::string>>& field_names)
+    {
+        if (ids.has_value()) {
+            node_ids.insert(ids->begin(), ids->end());
+        }
+        if (types.has_value()) {
+            node_types.insert(types->begin(), types->end());
+        }
+        if (field_names.has_value()) {
+            fields.insert(field_names->begin(), field_names->end());
+        }
+    }
+
+    bool empty() const noexcept { return node_ids.empty() && node_types.empty() && fields.empty(); }
+
+    bool has_node_filter() const noexcept { return !node_ids.empty() || !node_types.empty(); }
+
+    /**
+     * The part of one tick's deltas, an object keyed by node id, this filter
+     * lets through, or null when nothing is left. `node_type` maps a node id to
+     * its type and is only called when filtering on types.
+     */
+    template <typename NodeTypeLookup>
+    nlohmann::json apply(const nlohmann::json& statuses, NodeTypeLookup&& node_type) const
+    {
+        nlohmann::json result;
+
+        for (const auto& [id, delta] : statuses.items()) {
+            if (has_node_filter() && !node_ids.contains(id)) {
+                if (node_types.empty()) {
+                    continue;
+                }
+                const std::optional<std::string_view> type = node_type(id);
+                if (!type.has_value() || !node_types.contains(*type)) {
+                    continue;
+                }
+            }
+
+            if (fields.empty()) {
+                result[id] = delta;
+                continue;
+            }
+
+            nlohmann::json filtered;
+            for (const auto& [name, value] : delta.items()) {
+                if (fields.contains(name)) {
+                    filtered[name] = value;
+                }
+            }
+            if (!filtered.is_null()) {
+                result[id] = std::move(filtered);
+            }
+        }
+
+        return result;
+    }
+};
+
+} // namespace miximus::web_server::detail
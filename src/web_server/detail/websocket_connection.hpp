@@ -1,13 +1,30 @@
 #pragma once
+#include "types/message_encoding.hpp"
 #include "types/topic.hpp"
+#include "web_server/detail/status_filter.hpp"
+
+#include <nlohmann/json.hpp>
 
 #include <array>
+#include <chrono>
+#include <cstdint>
 
 namespace miximus::web_server::detail {
 struct websocket_connection
 {
     int64_t                                 id;
     std::array<bool, enum_count<topic_e>()> topics;
+    message_encoding_e                      encoding{};
+
+    // Node status rate limiting. A zero interval sends every tick's frame as
+    // is; otherwise deltas are merged into pending_statuses until next_status.
+    // Deltas are also merged while the socket has a send backlog, so a slow
+    // client receives the latest values once it catches up.
+    status_filter_s                       status_filter;
+    std::chrono::milliseconds             status_interval{};
+    std::chrono::steady_clock::time_point next_status{};
+    nlohmann::json                        pending_statuses;
+    uint64_t                              pending_status_version{};
 
     bool has_subscription(topic_e t) const noexcept
     {
@@ -4,6 +4,8 @@
 
 #include <nlohmann/json_fwd.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -29,18 +31,37 @@ class server_s
     server_s()          = default;
     virtual ~server_s() = default;
 
-    virtual void subscribe(topic_e topic, const callback_t& callback)   = 0;
-    virtual void set_config_getters(const config_getters_t& getters)    = 0;
-    virtual void start(uint16_t port, boost::asio::io_context* service) = 0;
-    virtual void stop()                                                 = 0;
+    virtual void subscribe(topic_e topic, const callback_t& callback) = 0;
+    virtual void set_config_getters(const config_getters_t& getters)  = 0;
 
     /**
-     * Sync versions of calls should only be called from the callback thread
+     * HTTP and WebSocket I/O, including message serialization, runs on a pool
+     * of `io_threads` transport threads owned by the server. Subscription
+     * callbacks are posted to `command_executor` and so run serialized there.
      */
-    virtual void send_message(const nlohmann::json& msg, int64_t connection_id)      = 0;
-    virtual void send_message_sync(const nlohmann::json& msg, int64_t connection_id) = 0;
-    virtual void broadcast_message(const nlohmann::json& msg)                        = 0;
-    virtual void broadcast_message_sync(const nlohmann::json& msg)                   = 0;
+    virtual void start(uint16_t port, boost::asio::io_context* command_executor, size_t io_threads) = 0;
+
+    /**
+     * Close all connections, wait for the commands already posted to the
+     * command executor, and join the transport threads. Must not be called
+     * from either.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * Messages are queued to the transport threads and serialized there, in
+     * the order they were queued. Callable from any thread.
+     */
+    virtual void send_message(nlohmann::json msg, int64_t connection_id) = 0;
+    virtual void broadcast_message(nlohmann::json msg)                   = 0;
+
+    /**
+     * Publish the node status deltas of one tick, an object keyed by node id,
+     * stamped with its change log version. Callable from any thread; the frame
+     * is serialized on the server thread, once for every subscriber that is
+     * not filtered, rate limited or behind on sending.
+     */
+    virtual void broadcast_node_statuses(std::shared_ptr<const nlohmann::json> statuses, uint64_t version) = 0;
 
     template <typename Message, typename Callback>
     void subscribe(topic_e topic, Callback&& callback);
@@ -24,6 +24,14 @@
 #include <vector>
 #include <zlib.h>
 
+#ifdef MIXIMUS_BUNDLER_BROTLI
+#include <brotli/encode.h>
+#endif
+#ifdef MIXIMUS_BUNDLER_ZSTD
+#include <memory>
+#include <zstd.h>
+#endif
+
 constexpr size_t BYTES_PER_LINE = 18;
 
 namespace {
@@ -102,6 +110,73 @@ std::string compress_gzip(std::string_view data)
     return output;
 }
 
+#ifdef MIXIMUS_BUNDLER_BROTLI
+std::string compress_brotli(std::string_view data)
+{
+    size_t output_size = BrotliEncoderMaxCompressedSize(data.size());
+    if (output_size == 0) {
+        throw std::length_error("File is too large for Brotli");
+    }
+
+    std::string output(output_size, '\0');
+    if (BrotliEncoderCompress(BROTLI_MAX_QUALITY,
+                              BROTLI_DEFAULT_WINDOW,
+                              BROTLI_MODE_GENERIC,
+                              data.size(),
+                              reinterpret_cast<const uint8_t*>(data.data()),
+                              &output_size,
+                              reinterpret_cast<uint8_t*>(output.data())) == BROTLI_FALSE) {
+        throw std::runtime_error("Failed to compress file with Brotli");
+    }
+
+    output.resize(output_size);
+    return output;
+}
+#endif
+
+#ifdef MIXIMUS_BUNDLER_ZSTD
+std::string compress_zstd(std::string_view data)
+{
+    // Browsers are only required to decode zstd windows up to 8 MB (RFC 9659)
+    constexpr int HTTP_WINDOW_LOG = 23;
+
+    const std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(ZSTD_createCCtx(), &ZSTD_freeCCtx);
+    if (context == nullptr) {
+        throw std::runtime_error("Failed to initialize zstd");
+    }
+
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, ZSTD_maxCLevel());
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_windowLog, HTTP_WINDOW_LOG);
+
+    std::string output(ZSTD_compressBound(data.size()), '\0');
+    const auto  output_size = ZSTD_compress2(context.get(), output.data(), output.size(), data.data(), data.size());
+    if (ZSTD_isError(output_size) != 0) {
+        throw std::runtime_error(std::format("Failed to compress file with zstd: {}", ZSTD_getErrorName(output_size)));
+    }
+
+    output.resize(output_size);
+    return output;
+}
+#endif
+
+void write_array(std::ostream& target, std::string_view name, std::string_view data)
+{
+    target << "constexpr std::array<uint8_t, " << data.size() << "> " << name << " = {" << '\n';
+
+    for (size_t i = 0; i < data.size();) {
+        target << tab(1);
+
+        // Add the bytes in rows of BYTES_PER_LINE (18)
+        for (size_t j = 0; (j < BYTES_PER_LINE) && (i < data.size()); ++j, ++i) {
+            target << hex_u8(static_cast<uint8_t>(data[i])) << ", ";
+        }
+
+        target << '\n';
+    }
+
+    target << "};" << '\n' << '\n';
+}
+
 std::string sha1_hex(boost::uuids::detail::sha1& sha1)
 {
     boost::uuids::detail::sha1::digest_type digest;
@@ -176,41 +251,67 @@ int bundle(const std::filesystem::path& src,
         using str_itr = std::istreambuf_iterator<char>;
         std::string file_data((str_itr(file)), str_itr());
 
-        // Compress the buffer
-        const auto compressed = compress_gzip(file_data);
-        const auto arr_size   = compressed.size();
+        // Compress the buffer. Brotli and zstd variants that do not beat gzip
+        // are left out, so the server falls back to gzip for them.
+        const auto  gzipped = compress_gzip(file_data);
+        std::string brotli;
+        std::string zstd;
+#ifdef MIXIMUS_BUNDLER_BROTLI
+        brotli = compress_brotli(file_data);
+        if (brotli.size() >= gzipped.size()) {
+            brotli.clear();
+        }
+#endif
+#ifdef MIXIMUS_BUNDLER_ZSTD
+        zstd = compress_zstd(file_data);
+        if (zstd.size() >= gzipped.size()) {
+            zstd.clear();
+        }
+#endif
 
         const auto identity_hash = sha1_hex(file_data);
-        const auto gzip_hash     = sha1_hex(compressed);
 
         bundle_sha1.process_bytes(identity_hash.data(), identity_hash.size());
 
-        const auto comment = std::format("// File: {} ({} / {} compressed)", unix_name, file_data.size(), arr_size);
+        auto comment = std::format("// File: {} ({} / {} gzip", unix_name, file_data.size(), gzipped.size());
+        if (!brotli.empty()) {
+            comment += std::format(" / {} br", brotli.size());
+        }
+        if (!zstd.empty()) {
+            comment += std::format(" / {} zstd", zstd.size());
+        }
+        comment += ")";
 
         target << comment << '\n';
 
-        target << "constexpr std::array<uint8_t, " << arr_size << "> " << arr_name << " = {" << '\n';
-
-        for (size_t i = 0; i < arr_size;) {
-            target << tab(1);
-
-            // Add the bytes in rows of BYTES_PER_LINE (18)
-            for (size_t j = 0; (j < BYTES_PER_LINE) && (i < arr_size); ++j, ++i) {
-                target << hex_u8(static_cast<uint8_t>(compressed[i])) << ", ";
-            }
-
-            target << '\n';
+        write_array(target, arr_name, gzipped);
+        if (!brotli.empty()) {
+            write_array(target, arr_name + "Br", brotli);
+        }
+        if (!zstd.empty()) {
+            write_array(target, arr_name + "Zstd", zstd);
         }
 
-        target << "};" << '\n' << '\n';
-
+        // Designated initializers must follow the declaration order of file_record_s
         map << tab(2) << "file_record_s{ " << comment << '\n';
         map << tab(3) << ".filename = \"" << unix_name << "\"," << '\n';
         map << tab(3) << ".gzipped = " << arr_name << "," << '\n';
+        if (!brotli.empty()) {
+            map << tab(3) << ".brotli = " << arr_name << "Br," << '\n';
+        }
+        if (!zstd.empty()) {
+            map << tab(3) << ".zstd = " << arr_name << "Zstd," << '\n';
+        }
         map << tab(3) << ".size = " << file_data.size() << "," << '\n';
         map << tab(3) << ".mime = \"" << get_mime(filename) << "\"," << '\n';
         map << tab(3) << ".identity_hash = \"" << identity_hash << "\"," << '\n';
-        map << tab(3) << ".gzip_hash = \"" << gzip_hash << "\"," << '\n';
+        map << tab(3) << ".gzip_hash = \"" << sha1_hex(gzipped) << "\"," << '\n';
+        if (!brotli.empty()) {
+            map << tab(3) << ".brotli_hash = \"" << sha1_hex(brotli) << "\"," << '\n';
+        }
+        if (!zstd.empty()) {
+            map << tab(3) << ".zstd_hash = \"" << sha1_hex(zstd) << "\"," << '\n';
+        }
         map << tab(2) << "}," << '\n';
     }
 
@@ -4,6 +4,7 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <thread>
 
 #ifdef _WIN32
 #ifdef LIBRARY_EXPORTS
@@ -22,11 +23,25 @@ struct file_record_s
 {
     std::string_view         filename;
     std::span<const uint8_t> gzipped;
+    std::span<const uint8_t> brotli{}; // Empty unless the bundler had Brotli and it beat gzip
+    std::span<const uint8_t> zstd{};   // Empty unless the bundler had zstd and it beat gzip
     size_t                   size;
     std::string_view         mime;
     std::string_view         identity_hash;
     std::string_view         gzip_hash;
+    std::string_view         brotli_hash{};
+    std::string_view         zstd_hash{};
+
+    // Inflate into a new string on every call
     LIBRARY_API std::string unzip() const;
+
+    /**
+     * Decoded contents, inflated on first use and cached for the lifetime of
+     * the process. Every caller shares the same immutable buffer, so the view
+     * never dangles. Thread-safe; concurrent first calls for the same file
+     * inflate it once.
+     */
+    LIBRARY_API std::string_view contents() const;
 };
 
 struct file_map_s
@@ -42,6 +57,13 @@ struct file_map_s
 
     LIBRARY_API const file_record_s* get_file(std::string_view filename) const noexcept;
     LIBRARY_API const file_record_s& get_file_or_throw(std::string_view filename) const;
+
+    /**
+     * Opt-in: decode every file into the contents() cache on a background
+     * thread, so later callers find them ready. Destroying the returned thread
+     * stops the warm-up after the file being decoded and joins it.
+     */
+    LIBRARY_API std::jthread warm_up() const;
 };
 
 LIBRARY_API extern const file_map_s& get_web_files();
@@ -9,14 +9,54 @@
 #define ZLIB_CONST
 #endif
 #include <algorithm>
+#include <exception>
 #include <format>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <ranges>
 #include <stdexcept>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <zlib.h>
 
 namespace miximus::static_files {
+namespace {
+
+struct decoded_file_s
+{
+    std::once_flag once;
+    std::string    data;
+};
+
+// Keyed by record address; records are static data that live as long as the library
+class decoded_cache_s
+{
+    std::mutex                                                                mutex_;
+    std::unordered_map<const file_record_s*, std::unique_ptr<decoded_file_s>> files_;
+
+  public:
+    decoded_file_s& get(const file_record_s* record)
+    {
+        const std::scoped_lock lock(mutex_);
+        auto&                  file = files_[record];
+        if (file == nullptr) {
+            file = std::make_unique<decoded_file_s>();
+        }
+        return *file;
+    }
+};
+
+decoded_cache_s& get_decoded_cache()
+{
+    static decoded_cache_s cache;
+    return cache;
+}
+
+} // namespace
 
 std::string file_record_s::unzip() const
 {
@@ -57,6 +97,15 @@ std::string file_record_s::unzip() const
     return data;
 }
 
+std::string_view file_record_s::contents() const
+{
+    // Inflate outside the cache lock so different files decode concurrently.
+    // If unzip() throws, the next call tries again.
+    auto& decoded = get_decoded_cache().get(this);
+    std::call_once(decoded.once, [&] { decoded.data = unzip(); });
+    return decoded.data;
+}
+
 const file_record_s* file_map_s::get_file(std::string_view filename) const noexcept
 {
     const auto it = std::ranges::lower_bound(files, filename, {}, &file_record_s::filename);
@@ -77,4 +126,21 @@ const file_record_s& file_map_s::get_file_or_throw(std::string_view filename) co
     throw std::out_of_range(std::format("File \"{}\" not found", filename));
 }
 
+std::jthread file_map_s::warm_up() const
+{
+    // The cache outlives every map, so the thread can keep a copy of the span
+    return std::jthread([records = files](const std::stop_token& stop_token) {
+        for (const auto& record : records) {
+            if (stop_token.stop_requested()) {
+                return;
+            }
+            try {
+                (void)record.contents();
+            } catch (const std::exception&) {
+                // Reported again to the first caller that needs the file
+            }
+        }
+    });
+}
+
 } // namespace miximus::static_files
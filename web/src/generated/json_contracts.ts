@@ -37,6 +37,11 @@ export const enum font_registry_command_e {
   refresh = "refresh",
 }
 
+export const enum message_encoding_e {
+  json = "json",
+  msgpack = "msgpack",
+}
+
 export interface settings_option_s {
   readonly id: string;
   readonly label: string;
@@ -93,6 +98,10 @@ export interface subscribe_request_s {
   readonly action: action_e.subscribe;
   readonly token?: string | null;
   readonly topic: topic_e;
+  readonly min_interval_ms?: number | null;
+  readonly node_ids?: readonly string[] | null;
+  readonly node_types?: readonly string[] | null;
+  readonly fields?: readonly string[] | null;
 }
 
 export interface unsubscribe_request_s {
@@ -149,6 +158,9 @@ export interface config_request_s {
   readonly action: action_e.command;
   readonly topic: topic_e.config;
   readonly token?: string | null;
+  readonly log_id?: string | null;
+  readonly since_version?: number | null;
+  readonly since_status_version?: number | null;
 }
 
 export interface node_status_request_s {
@@ -167,6 +179,7 @@ export interface socket_info_s {
   readonly action: action_e.socket_info;
   readonly id: number;
   readonly bundle_hash: string;
+  readonly encoding: message_encoding_e;
 }
 
 export interface result_s {
@@ -177,7 +190,10 @@ export interface result_s {
 export interface config_result_s {
   readonly action: action_e.result;
   readonly token: string;
-  readonly config: config_s;
+  readonly log_id: string;
+  readonly version: number;
+  readonly config?: config_s | null;
+  readonly changes?: config_changes_s | null;
 }
 
 export interface node_status_result_s {
@@ -199,6 +215,7 @@ export interface add_node_command_s {
   readonly topic: topic_e.add_node;
   readonly origin_id?: number | null;
   readonly origin_token?: string | null;
+  readonly version: number;
   readonly node: node_s;
 }
 
@@ -207,6 +224,7 @@ export interface remove_node_command_s {
   readonly topic: topic_e.remove_node;
   readonly origin_id?: number | null;
   readonly origin_token?: string | null;
+  readonly version: number;
   readonly id: string;
 }
 
@@ -215,6 +233,7 @@ export interface update_node_command_s {
   readonly topic: topic_e.update_node;
   readonly origin_id?: number | null;
   readonly origin_token?: string | null;
+  readonly version: number;
   readonly id: string;
   readonly options: options_s;
   readonly has_corrected_values: boolean;
@@ -225,6 +244,7 @@ export interface add_connection_command_s {
   readonly topic: topic_e.add_connection;
   readonly origin_id?: number | null;
   readonly origin_token?: string | null;
+  readonly version: number;
   readonly connection: connection_s;
 }
 
@@ -233,14 +253,27 @@ export interface remove_connection_command_s {
   readonly topic: topic_e.remove_connection;
   readonly origin_id?: number | null;
   readonly origin_token?: string | null;
+  readonly version: number;
   readonly connection: connection_s;
 }
 
 export interface node_status_command_s {
   readonly action: action_e.command;
   readonly topic: topic_e.node_status;
-  readonly id: string;
-  readonly status: node_status_s;
+  readonly version: number;
+  readonly statuses: Readonly<Record<string, node_status_s>>;
+}
+
+export type config_change_t =
+  | add_node_command_s
+  | remove_node_command_s
+  | update_node_command_s
+  | add_connection_command_s
+  | remove_connection_command_s;
+
+export interface config_changes_s {
+  readonly commands: readonly config_change_t[];
+  readonly status: Readonly<Record<string, node_status_s>>;
 }
 
 export interface rect_s {
@@ -291,6 +324,7 @@ export interface application_lifecycle_status_s {
   readonly demanding_node_count: number;
   readonly submitted_node_count: number;
   readonly executed_node_count: number;
+  readonly reused_node_count: number;
 }
 
 export interface application_scheduler_status_s {
@@ -312,6 +346,28 @@ export interface application_scheduler_status_s {
   readonly sustained_overload: boolean;
 }
 
+export interface application_autosave_status_s {
+  readonly autosave_count: number;
+  readonly autosave_failures: number;
+  readonly autosave_duration_us: number;
+  readonly autosave_duration_max_us: number;
+  readonly autosave_bytes: number;
+  readonly autosave_bytes_total: number;
+  readonly autosave_error?: string | null;
+}
+
+export interface application_gpu_memory_status_s {
+  readonly gpu_memory_total_bytes: number;
+  readonly gpu_memory_shared_bytes: number;
+  readonly gpu_memory_budget_bytes: number;
+  readonly gpu_memory_over_budget: boolean;
+}
+
+export interface gpu_memory_status_s {
+  readonly gpu_memory_bytes: number;
+  readonly gpu_memory_allocations: number;
+}
+
 export interface render_delay_test_status_s {
   readonly test_render_delay_ms: number;
   readonly test_render_delay_every: number;
@@ -330,6 +386,9 @@ export interface source_timing_status_s {
   readonly source_queue_discontinuities: number;
   readonly source_queue_transfer_failures: number;
   readonly source_queue_transfer_cancellations: number;
+  readonly source_frame_records: number;
+  readonly source_frame_records_reused: number;
+  readonly source_frame_record_allocations: number;
   readonly source_recovered_rate?: number | null;
   readonly source_observed_rate?: number | null;
   readonly source_phase_offset_us?: number | null;
@@ -339,6 +398,13 @@ export interface source_timing_status_s {
   readonly source_repeat_next_frame_lead_max_us?: number | null;
 }
 
+export interface source_sync_status_s {
+  readonly sync_group_members: number;
+  readonly sync_group_skew_us?: number | null;
+  readonly sync_group_skew_max_us?: number | null;
+  readonly sync_group_hold_back_us?: number | null;
+}
+
 export interface decklink_input_device_status_s {
   readonly signal_locked?: boolean | null;
   readonly ancillary_signal_locked?: boolean | null;
@@ -493,8 +559,12 @@ export type node_status_s = Partial<
   application_frame_status_s &
   application_lifecycle_status_s &
   application_scheduler_status_s &
+  application_autosave_status_s &
+  application_gpu_memory_status_s &
+  gpu_memory_status_s &
   render_delay_test_status_s &
   source_timing_status_s &
+  source_sync_status_s &
   decklink_input_device_status_s &
   decklink_output_device_status_s &
   decklink_output_keyer_status_s &
@@ -1,10 +1,18 @@
-export { action_e, error_e, font_registry_command_e, topic_e } from "@/generated/json_contracts";
+export {
+  action_e,
+  error_e,
+  font_registry_command_e,
+  message_encoding_e,
+  topic_e,
+} from "@/generated/json_contracts";
 export type {
   add_connection_command_s,
   add_connection_request_s,
   add_node_command_s,
   add_node_request_s,
   command_s,
+  config_change_t,
+  config_changes_s,
   config_request_s,
   config_result_s,
   config_s,
@@ -0,0 +1,139 @@
+// Minimal MessagePack decoder for server messages. It covers the subset that
+// nlohmann::json::to_msgpack emits: nil, booleans, integers, floats, strings,
+// binary, arrays and maps. 64-bit integers are converted to number, matching
+// what JSON.parse would produce for the same value.
+
+const text_decoder = new TextDecoder();
+
+class reader_s {
+  private offset = 0;
+  private readonly view: DataView;
+  private readonly bytes: Uint8Array;
+
+  constructor(buffer: ArrayBuffer) {
+    this.view = new DataView(buffer);
+    this.bytes = new Uint8Array(buffer);
+  }
+
+  public get done(): boolean {
+    return this.offset >= this.bytes.length;
+  }
+
+  private advance(length: number): number {
+    const offset = this.offset;
+    if (offset + length > this.bytes.length) {
+      throw new RangeError("Truncated MessagePack payload");
+    }
+    this.offset += length;
+    return offset;
+  }
+
+  private u8(): number {
+    return this.view.getUint8(this.advance(1));
+  }
+
+  private u16(): number {
+    return this.view.getUint16(this.advance(2));
+  }
+
+  private u32(): number {
+    return this.view.getUint32(this.advance(4));
+  }
+
+  private str(length: number): string {
+    const offset = this.advance(length);
+    return text_decoder.decode(this.bytes.subarray(offset, offset + length));
+  }
+
+  private bin(length: number): Uint8Array {
+    const offset = this.advance(length);
+    return this.bytes.slice(offset, offset + length);
+  }
+
+  private array(length: number): unknown[] {
+    const result = new Array<unknown>(length);
+    for (let i = 0; i < length; i++) {
+      result[i] = this.value();
+    }
+    return result;
+  }
+
+  private map(length: number): Record<string, unknown> {
+    const result: Record<string, unknown> = {};
+    for (let i = 0; i < length; i++) {
+      const key = this.value();
+      result[String(key)] = this.value();
+    }
+    return result;
+  }
+
+  public value(): unknown {
+    const type = this.u8();
+
+    if (type <= 0x7f) return type;
+    if (type >= 0xe0) return type - 0x100;
+    if ((type & 0xf0) === 0x80) return this.map(type & 0x0f);
+    if ((type & 0xf0) === 0x90) return this.array(type & 0x0f);
+    if ((type & 0xe0) === 0xa0) return this.str(type & 0x1f);
+
+    switch (type) {
+      case 0xc0:
+        return null;
+      case 0xc2:
+        return false;
+      case 0xc3:
+        return true;
+      case 0xc4:
+        return this.bin(this.u8());
+      case 0xc5:
+        return this.bin(this.u16());
+      case 0xc6:
+        return this.bin(this.u32());
+      case 0xca:
+        return this.view.getFloat32(this.advance(4));
+      case 0xcb:
+        return this.view.getFloat64(this.advance(8));
+      case 0xcc:
+        return this.u8();
+      case 0xcd:
+        return this.u16();
+      case 0xce:
+        return this.u32();
+      case 0xcf:
+        return Number(this.view.getBigUint64(this.advance(8)));
+      case 0xd0:
+        return this.view.getInt8(this.advance(1));
+      case 0xd1:
+        return this.view.getInt16(this.advance(2));
+      case 0xd2:
+        return this.view.getInt32(this.advance(4));
+      case 0xd3:
+        return Number(this.view.getBigInt64(this.advance(8)));
+      case 0xd9:
+        return this.str(this.u8());
+      case 0xda:
+        return this.str(this.u16());
+      case 0xdb:
+        return this.str(this.u32());
+      case 0xdc:
+        return this.array(this.u16());
+      case 0xdd:
+        return this.array(this.u32());
+      case 0xde:
+        return this.map(this.u16());
+      case 0xdf:
+        return this.map(this.u32());
+      default:
+        throw new TypeError(`Unsupported MessagePack type 0x${type.toString(16)}`);
+    }
+  }
+}
+
+export function decode_msgpack(buffer: ArrayBuffer): unknown {
+  const reader = new reader_s(buffer);
+  const value = reader.value();
+  if (!reader.done) {
+    throw new RangeError("Trailing bytes after MessagePack payload");
+  }
+  return value;
+}
@@ -60,3 +60,46 @@ export const MixTex2Node = defineNode({
     fb_out: () => new NodeInterface<null>("FB", null).use(setType, t_framebuffer),
   },
 });
+
+// Layer a is drawn first, at the bottom
+const layerNames = ["a", "b", "c", "d", "e", "f", "g", "h"] as const;
+
+function createLayersNode(type: node_type_e, title: string, layerCount: 4 | 8) {
+  const inputs: Record<string, () => NodeInterface<unknown>> = {
+    fb_in: () => new NodeInterface<null>("FB In", null).use(setType, t_framebuffer),
+  };
+
+  for (const layer of layerNames.slice(0, layerCount)) {
+    const label = layer.toUpperCase();
+    inputs[`${layer}_tex`] = () =>
+      new NodeInterface<null>(`${label} Texture`, null).use(setType, t_texture);
+    inputs[`${layer}_rect`] = () =>
+      new NodeInterface<null>(`${label} Rect`, null).use(setType, t_rect);
+    inputs[`${layer}_crop`] = () =>
+      new NodeInterface<null>(`${label} Crop`, null).use(setType, t_rect);
+    inputs[`${layer}_opacity`] = () =>
+      new NumericInterface(`${label} Opacity`, 1, { precision: 2, step: 0.05, min: 0, max: 1 }).use(
+        setType,
+        t_f64,
+      );
+    inputs[`${layer}_blend_mode`] = () =>
+      new DropdownInterface(`${label} Blend`, "normal", [
+        { id: "normal", label: "Normal" },
+        { id: "add", label: "Add" },
+      ]);
+  }
+
+  inputs.fill_mode = () => createFillModeInterface("scale");
+
+  return defineNode({
+    type,
+    title,
+    inputs,
+    outputs: {
+      fb_out: () => new NodeInterface<null>("FB Out", null).use(setType, t_framebuffer),
+    },
+  });
+}
+
+export const Layers4Node = createLayersNode(node_type_e.layers_4, "Layers x4", 4);
+export const Layers8Node = createLayersNode(node_type_e.layers_8, "Layers x8", 8);
@@ -6,8 +6,10 @@ import { node_type_e } from "./node_type";
 import { createFillModeInterface } from "./fill_mode";
 import {
   DropdownInterface,
+  FocusTrackingStringInterface,
   StatusDropdownInterface,
   NodeStatusInterface,
+  gpuMemoryStatusSection,
   type NodeStatusSection,
 } from "./interfaces";
 
@@ -74,6 +76,15 @@ const decklinkInputStatus: readonly NodeStatusSection[] = [
       { key: "content_repeat_streak_max", label: "Longest repeat streak", format: "integer" },
     ],
   },
+  {
+    title: "Sync group",
+    fields: [
+      { key: "sync_group_members", label: "Members", format: "integer" },
+      { key: "sync_group_skew_us", label: "Skew (µs)", format: "integer" },
+      { key: "sync_group_skew_max_us", label: "Skew max (µs)", format: "integer" },
+      { key: "sync_group_hold_back_us", label: "Hold-back (µs)", format: "integer" },
+    ],
+  },
   {
     title: "Timed queue",
     fields: [
@@ -86,6 +97,9 @@ const decklinkInputStatus: readonly NodeStatusSection[] = [
       { key: "source_queue_timing_repeats", label: "Early-frame repeats", format: "integer" },
       { key: "source_queue_missing", label: "Timing missing", format: "integer" },
       { key: "source_queue_discontinuities", label: "Discontinuities", format: "integer" },
+      { key: "source_frame_records", label: "Frame records", format: "integer" },
+      { key: "source_frame_records_reused", label: "Recycled records", format: "integer" },
+      { key: "source_frame_record_allocations", label: "Record allocations", format: "integer" },
     ],
   },
   {
@@ -103,6 +117,7 @@ const decklinkInputStatus: readonly NodeStatusSection[] = [
       },
     ],
   },
+  gpuMemoryStatusSection,
 ];
 
 const decklinkOutputStatus: readonly NodeStatusSection[] = [
@@ -208,6 +223,7 @@ const decklinkOutputStatus: readonly NodeStatusSection[] = [
       { key: "content_repeat_streak_max", label: "Longest repeat streak", format: "integer" },
     ],
   },
+  gpuMemoryStatusSection,
 ];
 
 export const DeckLinkInputNode = defineNode({
@@ -217,6 +233,7 @@ export const DeckLinkInputNode = defineNode({
     status: () => new NodeStatusInterface(decklinkInputStatus),
     enabled: () => new CheckboxInterface("Enabled", false).setPort(false),
     device_name: () => new StatusDropdownInterface("Device", "device_names"),
+    sync_group: () => new FocusTrackingStringInterface("Sync Group", ""),
   },
   outputs: {
     tex: () => new NodeInterface<null>("Texture", null).use(setType, t_texture),
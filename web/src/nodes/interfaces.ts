@@ -78,7 +78,14 @@ type StatusOptionKey = {
     : never;
 }[keyof node_status_s];
 
-export type NodeStatusFormat = "active" | "busy" | "failure" | "integer" | "locked" | "temperature";
+export type NodeStatusFormat =
+  | "active"
+  | "busy"
+  | "bytes"
+  | "failure"
+  | "integer"
+  | "locked"
+  | "temperature";
 
 export interface NodeStatusField {
   readonly key: keyof node_status_s;
@@ -92,6 +99,15 @@ export interface NodeStatusSection {
   readonly fields: readonly NodeStatusField[];
 }
 
+/** GPU memory accounted to the node, shared by every node type with a status indicator. */
+export const gpuMemoryStatusSection: NodeStatusSection = {
+  title: "GPU memory",
+  fields: [
+    { key: "gpu_memory_bytes", label: "Allocated", format: "bytes" },
+    { key: "gpu_memory_allocations", label: "Allocations", format: "integer" },
+  ],
+};
+
 /** Read-only status indicator with an explicitly declared detail layout. */
 export class NodeStatusInterface extends NodeInterface<null> {
   readonly nodeData: NodeData;
@@ -4,9 +4,11 @@ import { setType } from "@baklavajs/interface-types";
 import { t_texture } from "./interface_types";
 import { node_type_e } from "./node_type";
 import {
+  DropdownInterface,
   FocusTrackingStringInterface,
   StatusDropdownInterface,
   NodeStatusInterface,
+  gpuMemoryStatusSection,
   type NodeStatusSection,
 } from "./interfaces";
 
@@ -44,6 +46,15 @@ const ndiInputStatus: readonly NodeStatusSection[] = [
       { key: "receiver_queue_depth", label: "Receiver queue", format: "integer" },
     ],
   },
+  {
+    title: "Sync group",
+    fields: [
+      { key: "sync_group_members", label: "Members", format: "integer" },
+      { key: "sync_group_skew_us", label: "Skew (µs)", format: "integer" },
+      { key: "sync_group_skew_max_us", label: "Skew max (µs)", format: "integer" },
+      { key: "sync_group_hold_back_us", label: "Hold-back (µs)", format: "integer" },
+    ],
+  },
   {
     title: "Timed queue",
     fields: [
@@ -56,6 +67,9 @@ const ndiInputStatus: readonly NodeStatusSection[] = [
       { key: "source_queue_timing_repeats", label: "Early-frame repeats", format: "integer" },
       { key: "source_queue_missing", label: "Timing missing", format: "integer" },
       { key: "source_queue_discontinuities", label: "Discontinuities", format: "integer" },
+      { key: "source_frame_records", label: "Frame records", format: "integer" },
+      { key: "source_frame_records_reused", label: "Recycled records", format: "integer" },
+      { key: "source_frame_record_allocations", label: "Record allocations", format: "integer" },
     ],
   },
   {
@@ -70,6 +84,7 @@ const ndiInputStatus: readonly NodeStatusSection[] = [
       },
     ],
   },
+  gpuMemoryStatusSection,
 ];
 
 const ndiOutputStatus: readonly NodeStatusSection[] = [
@@ -119,6 +134,7 @@ const ndiOutputStatus: readonly NodeStatusSection[] = [
       { key: "download_allocation_failed", label: "Allocation", format: "failure" },
     ],
   },
+  gpuMemoryStatusSection,
 ];
 
 export const NdiInputNode = defineNode({
@@ -128,6 +144,7 @@ export const NdiInputNode = defineNode({
     status: () => new NodeStatusInterface(ndiInputStatus),
     enabled: () => new CheckboxInterface("Enabled", true).setPort(false),
     source_name: () => new StatusDropdownInterface("Source", "source_names"),
+    sync_group: () => new FocusTrackingStringInterface("Sync Group", ""),
   },
   outputs: {
     tex: () => new NodeInterface<null>("Texture", null).use(setType, t_texture),
@@ -142,6 +159,13 @@ export const NdiOutputNode = defineNode({
     status: () => new NodeStatusInterface(ndiOutputStatus),
     enabled: () => new CheckboxInterface("Enabled", true).setPort(false),
     source_name: () => new FocusTrackingStringInterface("Sender Name", ""),
+    pixel_format: () =>
+      new DropdownInterface("Pixel Format", "uyvy", [
+        { id: "uyvy", label: "UYVY 8-bit 4:2:2" },
+        { id: "nv12", label: "NV12 8-bit 4:2:0" },
+        { id: "p216", label: "P216 16-bit 4:2:2" },
+        { id: "rgba", label: "RGBA with alpha" },
+      ]),
   },
   outputs: {},
 });
@@ -27,6 +27,8 @@ export const enum node_type_e {
   draw_box = "draw_box",
   infinite_multiviewer = "infinite_multiviewer",
   mix_tex_2 = "mix_tex_2",
+  layers_4 = "layers_4",
+  layers_8 = "layers_8",
   switch_f64_4 = "switch_f64_4",
   switch_f64_8 = "switch_f64_8",
   switch_vec2_4 = "switch_vec2_4",
@@ -7,6 +7,7 @@ import { createFillModeInterface } from "./fill_mode";
 import {
   StatusDropdownInterface,
   NodeStatusInterface,
+  gpuMemoryStatusSection,
   Vec2Interface,
   type NodeStatusSection,
 } from "./interfaces";
@@ -45,6 +46,7 @@ const screenStatus: readonly NodeStatusSection[] = [
       { key: "render_acquire_misses", label: "Acquisition misses", format: "integer" },
     ],
   },
+  gpuMemoryStatusSection,
 ];
 
 const pixelPositionOptions = { precision: 0, step: 1 } as const;
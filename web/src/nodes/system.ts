@@ -66,6 +66,13 @@ export const ApplicationSettingsNode = defineNode({
         min: 1,
         max: 8,
       }).setPort(false),
+    gpu_memory_budget_mb: () =>
+      new NumericInterface("Budget (MiB, 0 = unlimited)", 0, {
+        precision: 0,
+        step: 256,
+        min: 0,
+        max: 262_144,
+      }).setPort(false),
   },
   outputs: {},
 });
@@ -15,7 +15,13 @@ import {
   RectClampNode,
 } from "./math";
 import { Vec2Node, RectNode, FrameBufferNode, FramebufferToTextureNode } from "./utils";
-import { DrawBoxNode, InfiniteMultiviewerNode, MixTex2Node } from "./composite";
+import {
+  DrawBoxNode,
+  InfiniteMultiviewerNode,
+  MixTex2Node,
+  Layers4Node,
+  Layers8Node,
+} from "./composite";
 import {
   SwitchF64_4Node,
   SwitchF64_8Node,
@@ -51,6 +57,8 @@ export function register_node_types(editor: Editor): void {
   editor.registerNodeType(DrawBoxNode, { category: "Composite" });
   editor.registerNodeType(InfiniteMultiviewerNode, { category: "Composite" });
   editor.registerNodeType(MixTex2Node, { category: "Composite" });
+  editor.registerNodeType(Layers4Node, { category: "Composite" });
+  editor.registerNodeType(Layers8Node, { category: "Composite" });
   editor.registerNodeType(SwitchF64_4Node, { category: "Switch" });
   editor.registerNodeType(SwitchF64_8Node, { category: "Switch" });
   editor.registerNodeType(SwitchVec2_4Node, { category: "Switch" });
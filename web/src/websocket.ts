@@ -1,6 +1,7 @@
 import EventEmitter from "eventemitter3";
 import type { InjectionKey } from "vue";
-import { action_e, topic_e } from "./messages";
+import { action_e, message_encoding_e, topic_e } from "./messages";
+import { decode_msgpack } from "./msgpack";
 import type { command_s, error_s, message_s, socket_info_s, subscribe_request_s } from "./messages";
 
 interface ws_events {
@@ -8,6 +9,11 @@ interface ws_events {
   on_disconnected: [number, string];
 }
 
+/** Per-subscription options the server applies to node status pushes. */
+export type subscribe_options_t = Partial<
+  Pick<subscribe_request_s, "min_interval_ms" | "node_ids" | "node_types" | "fields">
+>;
+
 export type message_callback_t<T extends message_s> = (
   msg: T | error_s,
   is_origin: boolean,
@@ -19,9 +25,11 @@ export class ws_wrapper extends EventEmitter<ws_events> {
   private ping_timer?: ReturnType<typeof setTimeout>;
   private callbacks = new Map<string, message_callback_t<message_s>>();
   private subscriptions = new Map<topic_e, Set<message_callback_t<message_s>>>();
+  private subscribe_options = new Map<topic_e, subscribe_options_t>();
   private next_token = 0;
   private closing = false;
   private last_bundle_hash?: string;
+  private lost_request_count = 0;
 
   constructor() {
     super();
@@ -33,7 +41,12 @@ export class ws_wrapper extends EventEmitter<ws_events> {
       return;
     }
 
-    this.ws = new WebSocket(`ws://${location.hostname}:7351/`);
+    // Server messages arrive as binary MessagePack, which parses much faster than
+    // JSON text for large config and status payloads. Requests are still sent as JSON.
+    this.ws = new WebSocket(
+      `ws://${location.hostname}:7351/?encoding=${message_encoding_e.msgpack}`,
+    );
+    this.ws.binaryType = "arraybuffer";
     this.ws.onopen = this.handle_open.bind(this);
     this.ws.onclose = this.handle_close.bind(this);
     this.ws.onmessage = this.handle_message.bind(this);
@@ -46,6 +59,7 @@ export class ws_wrapper extends EventEmitter<ws_events> {
 
   private handle_close(ev: CloseEvent): void {
     clearInterval(this.ping_timer);
+    this.lost_request_count += this.callbacks.size;
     this.callbacks.clear();
 
     if (this.info) {
@@ -63,13 +77,11 @@ export class ws_wrapper extends EventEmitter<ws_events> {
     }
   }
 
-  private handle_message(msg: MessageEvent<string>): void {
-    if (typeof msg.data !== "string") {
-      console.error("Received something other than string on WebSocket");
-    }
-
+  private handle_message(msg: MessageEvent<string | ArrayBuffer>): void {
     try {
-      const payload: message_s = JSON.parse(msg.data);
+      const payload = (
+        typeof msg.data === "string" ? JSON.parse(msg.data) : decode_msgpack(msg.data)
+      ) as message_s;
 
       if (!payload || !payload.action) {
         return;
@@ -115,6 +127,7 @@ export class ws_wrapper extends EventEmitter<ws_events> {
       const payload: subscribe_request_s = {
         action: action_e.subscribe,
         topic: topic,
+        ...this.subscribe_options.get(topic),
       };
 
       this.send(payload, (result) => {
@@ -175,6 +188,15 @@ export class ws_wrapper extends EventEmitter<ws_events> {
     this.ws?.close();
   }
 
+  /**
+   * Number of requests dropped while offline or left unanswered when the socket
+   * closed. When it grows across a reconnect, local state may have diverged from
+   * the server.
+   */
+  public get lost_requests(): number {
+    return this.lost_request_count;
+  }
+
   public send<T extends message_s>(msg: T): boolean;
   public send<T extends message_s, R extends message_s = message_s>(
     msg: T,
@@ -185,6 +207,9 @@ export class ws_wrapper extends EventEmitter<ws_events> {
     cb?: message_callback_t<R>,
   ): boolean | string | undefined {
     if (!this.info) {
+      if (msg.action !== action_e.ping) {
+        this.lost_request_count++;
+      }
       return cb ? undefined : false;
     }
 
@@ -204,7 +229,17 @@ export class ws_wrapper extends EventEmitter<ws_events> {
     return token ?? true;
   }
 
-  public subscribe<T extends message_s>(topic: topic_e, cb: message_callback_t<T>) {
+  /**
+   * `options.min_interval_ms` asks the server to coalesce pushes on this topic
+   * and send at most one frame per interval; `node_ids`, `node_types` and
+   * `fields` restrict which statuses are pushed. Options are taken from the
+   * first subscriber.
+   */
+  public subscribe<T extends message_s>(
+    topic: topic_e,
+    cb: message_callback_t<T>,
+    options?: subscribe_options_t,
+  ) {
     let sub = this.subscriptions.get(topic);
     if (!sub) {
       sub = new Set();
@@ -218,7 +253,11 @@ export class ws_wrapper extends EventEmitter<ws_events> {
     sub.add(cb as message_callback_t<message_s>);
 
     if (sub.size === 1) {
-      this.send({ action: action_e.subscribe, topic }, (msg) => {
+      if (options !== undefined) {
+        this.subscribe_options.set(topic, options);
+      }
+      const payload: subscribe_request_s = { action: action_e.subscribe, topic, ...options };
+      this.send(payload, (msg) => {
         console.info(`Subscribe to ${topic} with: ${msg.action}`);
       });
     }
@@ -235,6 +274,7 @@ export class ws_wrapper extends EventEmitter<ws_events> {
     }
 
     if (sub.size === 0) {
+      this.subscribe_options.delete(topic);
       this.send({ action: action_e.unsubscribe, topic }, (msg) => {
         console.info(`Unsubscribe to ${topic} with: ${msg.action}`);
       });